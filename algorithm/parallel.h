@@ -0,0 +1,214 @@
+#ifndef __INCLUDE_PARALLEL_H_
+#define __INCLUDE_PARALLEL_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <type_traits>
+#include "../container/iterator/iterator.h"
+#include "../container/sequential/vector.h"
+#include "../utility/thread/threadpool.h"
+
+namespace BASE {
+    namespace ALGO {
+
+
+/**
+ * Parallel loops over random access ranges (CVector, CStableVector, plain
+ * pointers, ...). The range is cut into chunks of _GrainSize elements that
+ * the threads of a CThreadPool take one by one. The chunks only depend on
+ * the length of the range and the grain size, and partial results are
+ * combined in chunk order, so ParallelReduce and ParallelInclusiveScan give
+ * the same result on every run for any associative operation, even one
+ * that is not commutative or, like floating point addition, not exactly
+ * associative. Ranges of at most one chunk run on the caller only.
+ * A grain size around 16K elements keeps the scheduling overhead small
+ * for cheap loop bodies, expensive bodies want smaller grains.
+ **/
+static const size_t s_DefaultGrainSize = 16384;
+
+template <typename TIterator, typename TFunction>
+void ParallelForEach(TIterator _First, TIterator _Last, TFunction _Function,
+    size_t _GrainSize = s_DefaultGrainSize, BASE::UTIL::CThreadPool& _rPool = BASE::UTIL::CThreadPool::GetDefault());
+
+template <typename TInIterator, typename TOutIterator, typename TFunction>
+void ParallelTransform(TInIterator _First, TInIterator _Last, TOutIterator _Out, TFunction _Function,
+    size_t _GrainSize = s_DefaultGrainSize, BASE::UTIL::CThreadPool& _rPool = BASE::UTIL::CThreadPool::GetDefault());
+
+template <typename TIterator, typename TValue, typename TOperation>
+TValue ParallelReduce(TIterator _First, TIterator _Last, TValue _Init, TOperation _Operation,
+    size_t _GrainSize = s_DefaultGrainSize, BASE::UTIL::CThreadPool& _rPool = BASE::UTIL::CThreadPool::GetDefault());
+
+template <typename TInIterator, typename TOutIterator, typename TOperation>
+void ParallelInclusiveScan(TInIterator _First, TInIterator _Last, TOutIterator _Out, TOperation _Operation,   // _Out may be _First
+    size_t _GrainSize = s_DefaultGrainSize, BASE::UTIL::CThreadPool& _rPool = BASE::UTIL::CThreadPool::GetDefault());
+
+/*************************************************************************
+ * CHUNK SUBSECTION
+ *************************************************************************/
+
+struct SChunks
+{
+    SChunks(size_t _Count, size_t _GrainSize);
+
+    size_t GetBegin(size_t _Chunk) const;
+    size_t GetEnd(size_t _Chunk) const;
+
+    size_t m_Count;
+    size_t m_GrainSize;
+    size_t m_ChunkCount;
+};
+
+inline
+SChunks::SChunks(size_t _Count, size_t _GrainSize)
+    : m_Count(_Count)
+    , m_GrainSize(_GrainSize > 0 ? _GrainSize : 1)
+    , m_ChunkCount((_Count + m_GrainSize - 1) / m_GrainSize)
+{
+}
+
+inline size_t
+SChunks::GetBegin(size_t _Chunk) const
+{
+    return _Chunk * m_GrainSize;
+}
+
+inline size_t
+SChunks::GetEnd(size_t _Chunk) const
+{
+    return (_Chunk + 1 < m_ChunkCount) ? (_Chunk + 1) * m_GrainSize : m_Count;
+}
+
+/*************************************************************************
+ * ALGORITHM SUBSECTION
+ *************************************************************************/
+
+template <typename TIterator, typename TFunction>
+void ParallelForEach(TIterator _First, TIterator _Last, TFunction _Function, size_t _GrainSize, BASE::UTIL::CThreadPool& _rPool)
+{
+    SChunks Chunks(BASE::CNT::Distance(_First, _Last), _GrainSize);
+
+    _rPool.Run(Chunks.m_ChunkCount, [&](size_t _Chunk)
+    {
+        TIterator End = _First + Chunks.GetEnd(_Chunk);
+
+        for (TIterator It = _First + Chunks.GetBegin(_Chunk); It != End; ++It)
+        {
+            _Function(*It);
+        }
+    });
+}
+
+template <typename TInIterator, typename TOutIterator, typename TFunction>
+void ParallelTransform(TInIterator _First, TInIterator _Last, TOutIterator _Out, TFunction _Function, size_t _GrainSize, BASE::UTIL::CThreadPool& _rPool)
+{
+    SChunks Chunks(BASE::CNT::Distance(_First, _Last), _GrainSize);
+
+    _rPool.Run(Chunks.m_ChunkCount, [&](size_t _Chunk)
+    {
+        TInIterator  End = _First + Chunks.GetEnd(_Chunk);
+        TOutIterator Out = _Out + Chunks.GetBegin(_Chunk);
+
+        for (TInIterator It = _First + Chunks.GetBegin(_Chunk); It != End; ++It, ++Out)
+        {
+            *Out = _Function(*It);
+        }
+    });
+}
+
+template <typename TIterator, typename TValue, typename TOperation>
+TValue ParallelReduce(TIterator _First, TIterator _Last, TValue _Init, TOperation _Operation, size_t _GrainSize, BASE::UTIL::CThreadPool& _rPool)
+{
+    SChunks Chunks(BASE::CNT::Distance(_First, _Last), _GrainSize);
+
+    BASE::CNT::CVector<TValue> Partials;
+    Partials.Resize(Chunks.m_ChunkCount, _Init);
+
+    _rPool.Run(Chunks.m_ChunkCount, [&](size_t _Chunk)
+    {
+        TIterator It  = _First + Chunks.GetBegin(_Chunk);
+        TIterator End = _First + Chunks.GetEnd(_Chunk);
+
+        TValue Partial = *It;
+        for (++It; It != End; ++It)
+        {
+            Partial = _Operation(Partial, *It);
+        }
+
+        Partials[_Chunk] = Partial;
+    });
+
+    // left to right over the chunks, independent of which thread finished first
+    for (size_t Chunk = 0; Chunk < Chunks.m_ChunkCount; ++Chunk)
+    {
+        _Init = _Operation(_Init, Partials[Chunk]);
+    }
+
+    return _Init;
+}
+
+template <typename TInIterator, typename TOutIterator, typename TOperation>
+void ParallelInclusiveScan(TInIterator _First, TInIterator _Last, TOutIterator _Out, TOperation _Operation, size_t _GrainSize, BASE::UTIL::CThreadPool& _rPool)
+{
+    typedef typename std::remove_cv<typename std::remove_reference<decltype(*_First)>::type>::type value_type;
+
+    SChunks Chunks(BASE::CNT::Distance(_First, _Last), _GrainSize);
+
+    if (Chunks.m_ChunkCount == 0)
+    {
+        return;
+    }
+
+    // first pass: total of every chunk but the last
+    BASE::CNT::CVector<value_type> Offsets;
+    Offsets.Resize(Chunks.m_ChunkCount, *_First);
+
+    _rPool.Run(Chunks.m_ChunkCount - 1, [&](size_t _Chunk)
+    {
+        TInIterator It  = _First + Chunks.GetBegin(_Chunk);
+        TInIterator End = _First + Chunks.GetEnd(_Chunk);
+
+        value_type Total = *It;
+        for (++It; It != End; ++It)
+        {
+            Total = _Operation(Total, *It);
+        }
+
+        Offsets[_Chunk + 1] = Total;
+    });
+
+    // prefix over the chunk totals, Offsets[c] is the total in front of chunk c
+    for (size_t Chunk = 2; Chunk < Chunks.m_ChunkCount; ++Chunk)
+    {
+        Offsets[Chunk] = _Operation(Offsets[Chunk - 1], Offsets[Chunk]);
+    }
+
+    // second pass: every chunk scans on top of its offset
+    _rPool.Run(Chunks.m_ChunkCount, [&](size_t _Chunk)
+    {
+        TInIterator  It  = _First + Chunks.GetBegin(_Chunk);
+        TInIterator  End = _First + Chunks.GetEnd(_Chunk);
+        TOutIterator Out = _Out + Chunks.GetBegin(_Chunk);
+
+        value_type Total = (_Chunk == 0) ? *It : _Operation(Offsets[_Chunk], *It);
+        for (*Out = Total, ++It, ++Out; It != End; ++It, ++Out)
+        {
+            Total = _Operation(Total, *It);
+            *Out  = Total;
+        }
+    });
+}
+
+
+    } // namespace ALGO
+} // namespace BASE
+
+#endif // __INCLUDE_PARALLEL_H_
@@ -0,0 +1,1622 @@
+#ifndef __INCLUDE_SIMD_H_
+#define __INCLUDE_SIMD_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "../container/sequential/vector.h"
+#include "../utility/binary/bits.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || ((defined(__i386__) || defined(_M_IX86)) && defined(__SSE2__))
+#   define BASE_SIMD_X86
+#   include <immintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define BASE_SIMD_TARGET_AVX2   __attribute__((target("avx2")))
+#   define BASE_SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#   define BASE_SIMD_TARGET_AVX2
+#   define BASE_SIMD_TARGET_AVX512
+#endif
+
+namespace BASE {
+    namespace ALGO {
+
+
+/**
+ * Vectorized loops over contiguous int32_t, float and double data:
+ *     size_t Index = SimdFind(Vector.GetData(), Vector.GetCount(), 42);
+ *     float  Total = SimdSum(Vector);
+ * Every operation has a scalar, an SSE2, an AVX2 and an AVX-512 (F and BW)
+ * kernel, the best one the CPU and the operating system support is chosen
+ * once per process. The AVX-512 kernels load the tail under a mask where
+ * the result allows it. Other element types use the scalar kernels.
+ * Floating point sums and dot products add in a
+ * different order than a plain loop, results may differ in the last bits
+ * (but are the same on every run on the same CPU). Integer sums and dot
+ * products of any type are widened to 64 bit, keeping the signedness.
+ * The result of MinMax over data containing NaN is unspecified.
+ * SimdPopCount counts the set bits of an array of 64 bit words.
+ **/
+enum ESimdLevel
+{
+    SimdScalar,
+    SimdSse2,
+    SimdAvx2,
+    SimdAvx512,
+};
+
+template <typename T>
+struct SMinMax
+{
+    T m_Min;
+    T m_Max;
+};
+
+template <typename T>
+struct SSimdSum                                                         // type sums and dot products are accumulated in
+{
+    typedef typename std::conditional<!std::is_integral<T>::value, T,
+        typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type type;
+};
+
+/*************************************************************************
+ * SCALAR KERNEL SUBSECTION
+ *************************************************************************/
+
+struct SScalarKernels
+{
+    template <typename T>
+    static size_t Find(const T* _pData, size_t _Count, T _Value)
+    {
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            if (_pData[Index] == _Value)
+            {
+                return Index;
+            }
+        }
+        return _Count;
+    }
+
+    template <typename T>
+    static size_t Count(const T* _pData, size_t _Count, T _Value)
+    {
+        size_t Matches = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Matches += (_pData[Index] == _Value) ? 1 : 0;
+        }
+        return Matches;
+    }
+
+    template <typename T>
+    static SMinMax<T> MinMax(const T* _pData, size_t _Count)
+    {
+        assert(_Count > 0);
+
+        SMinMax<T> Result = { _pData[0], _pData[0] };
+        for (size_t Index = 1; Index < _Count; ++Index)
+        {
+            Result.m_Min = (_pData[Index] < Result.m_Min) ? _pData[Index] : Result.m_Min;
+            Result.m_Max = (Result.m_Max < _pData[Index]) ? _pData[Index] : Result.m_Max;
+        }
+        return Result;
+    }
+
+    template <typename T>
+    static typename SSimdSum<T>::type Sum(const T* _pData, size_t _Count)
+    {
+        typename SSimdSum<T>::type Result = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Result += _pData[Index];
+        }
+        return Result;
+    }
+
+    template <typename T>
+    static typename SSimdSum<T>::type Dot(const T* _pLhs, const T* _pRhs, size_t _Count)
+    {
+        typename SSimdSum<T>::type Result = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Result += static_cast<typename SSimdSum<T>::type>(_pLhs[Index]) * _pRhs[Index];
+        }
+        return Result;
+    }
+
+    template <typename T>
+    static bool Equal(const T* _pLhs, const T* _pRhs, size_t _Count)
+    {
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            if (!(_pLhs[Index] == _pRhs[Index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static size_t PopCount(const uint64_t* _pWords, size_t _Count)
+    {
+        size_t Total = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Total += BASE::UTIL::GetPopCount(_pWords[Index]);
+        }
+        return Total;
+    }
+};
+
+#ifdef BASE_SIMD_X86
+
+/*************************************************************************
+ * SSE2 KERNEL SUBSECTION
+ *************************************************************************/
+
+struct SSse2Kernels
+{
+    static size_t Find(const int32_t* _pData, size_t _Count, int32_t _Value)
+    {
+        const __m128i Value = _mm_set1_epi32(_Value);
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128i Equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_pData + Index)), Value);
+            int     Mask  = _mm_movemask_ps(_mm_castsi128_ps(Equal));
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+        return Index + SScalarKernels::Find(_pData + Index, _Count - Index, _Value);
+    }
+
+    static size_t Find(const float* _pData, size_t _Count, float _Value)
+    {
+        const __m128 Value = _mm_set1_ps(_Value);
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            int Mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(_pData + Index), Value));
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+        return Index + SScalarKernels::Find(_pData + Index, _Count - Index, _Value);
+    }
+
+    static size_t Find(const double* _pData, size_t _Count, double _Value)
+    {
+        const __m128d Value = _mm_set1_pd(_Value);
+
+        size_t Index = 0;
+        for (; Index + 2 <= _Count; Index += 2)
+        {
+            int Mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(_pData + Index), Value));
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+        return Index + SScalarKernels::Find(_pData + Index, _Count - Index, _Value);
+    }
+
+    static size_t Count(const int32_t* _pData, size_t _Count, int32_t _Value)
+    {
+        const __m128i Value = _mm_set1_epi32(_Value);
+
+        size_t Matches = 0;
+        size_t Index   = 0;
+
+        // the lane counters are flushed before they could overflow
+        while (Index + 4 <= _Count)
+        {
+            size_t  BlockEnd = (_Count - Index > s_CountBlock) ? Index + s_CountBlock : _Count;
+            __m128i Counter  = _mm_setzero_si128();
+
+            for (; Index + 4 <= BlockEnd; Index += 4)
+            {
+                __m128i Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pData + Index));
+                Counter = _mm_sub_epi32(Counter, _mm_cmpeq_epi32(Data, Value));
+            }
+
+            Matches += ReduceCount(Counter);
+        }
+
+        return Matches + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    static size_t Count(const float* _pData, size_t _Count, float _Value)
+    {
+        const __m128 Value = _mm_set1_ps(_Value);
+
+        size_t Matches = 0;
+        size_t Index   = 0;
+
+        while (Index + 4 <= _Count)
+        {
+            size_t  BlockEnd = (_Count - Index > s_CountBlock) ? Index + s_CountBlock : _Count;
+            __m128i Counter  = _mm_setzero_si128();
+
+            for (; Index + 4 <= BlockEnd; Index += 4)
+            {
+                __m128 Equal = _mm_cmpeq_ps(_mm_loadu_ps(_pData + Index), Value);
+                Counter = _mm_sub_epi32(Counter, _mm_castps_si128(Equal));
+            }
+
+            Matches += ReduceCount(Counter);
+        }
+
+        return Matches + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    static size_t Count(const double* _pData, size_t _Count, double _Value)
+    {
+        const __m128d Value   = _mm_set1_pd(_Value);
+        __m128i       Counter = _mm_setzero_si128();                    // 64 bit lanes cannot overflow
+
+        size_t Index = 0;
+        for (; Index + 2 <= _Count; Index += 2)
+        {
+            __m128d Equal = _mm_cmpeq_pd(_mm_loadu_pd(_pData + Index), Value);
+            Counter = _mm_sub_epi64(Counter, _mm_castpd_si128(Equal));
+        }
+
+        uint64_t Lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Counter);
+
+        return static_cast<size_t>(Lanes[0] + Lanes[1]) + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    static SMinMax<int32_t> MinMax(const int32_t* _pData, size_t _Count)
+    {
+        if (_Count < 4)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m128i Min = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pData));
+        __m128i Max = Min;
+
+        size_t Index = 4;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128i Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pData + Index));
+
+            // no pminsd before SSE4.1, select through a compare mask
+            __m128i Less    = _mm_cmplt_epi32(Data, Min);
+            __m128i Greater = _mm_cmpgt_epi32(Data, Max);
+            Min = _mm_or_si128(_mm_and_si128(Less, Data), _mm_andnot_si128(Less, Min));
+            Max = _mm_or_si128(_mm_and_si128(Greater, Data), _mm_andnot_si128(Greater, Max));
+        }
+
+        int32_t Lanes[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Min);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes + 4), Max);
+
+        SMinMax<int32_t> Result = { SScalarKernels::MinMax(Lanes, 4).m_Min, SScalarKernels::MinMax(Lanes + 4, 4).m_Max };
+        return Merge(Result, _pData + Index, _Count - Index);
+    }
+
+    static SMinMax<float> MinMax(const float* _pData, size_t _Count)
+    {
+        if (_Count < 4)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m128 Min = _mm_loadu_ps(_pData);
+        __m128 Max = Min;
+
+        size_t Index = 4;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128 Data = _mm_loadu_ps(_pData + Index);
+            Min = _mm_min_ps(Min, Data);
+            Max = _mm_max_ps(Max, Data);
+        }
+
+        float Lanes[8];
+        _mm_storeu_ps(Lanes, Min);
+        _mm_storeu_ps(Lanes + 4, Max);
+
+        SMinMax<float> Result = { SScalarKernels::MinMax(Lanes, 4).m_Min, SScalarKernels::MinMax(Lanes + 4, 4).m_Max };
+        return Merge(Result, _pData + Index, _Count - Index);
+    }
+
+    static SMinMax<double> MinMax(const double* _pData, size_t _Count)
+    {
+        if (_Count < 2)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m128d Min = _mm_loadu_pd(_pData);
+        __m128d Max = Min;
+
+        size_t Index = 2;
+        for (; Index + 2 <= _Count; Index += 2)
+        {
+            __m128d Data = _mm_loadu_pd(_pData + Index);
+            Min = _mm_min_pd(Min, Data);
+            Max = _mm_max_pd(Max, Data);
+        }
+
+        double Lanes[4];
+        _mm_storeu_pd(Lanes, Min);
+        _mm_storeu_pd(Lanes + 2, Max);
+
+        SMinMax<double> Result = { SScalarKernels::MinMax(Lanes, 2).m_Min, SScalarKernels::MinMax(Lanes + 2, 2).m_Max };
+        return Merge(Result, _pData + Index, _Count - Index);
+    }
+
+    static int64_t Sum(const int32_t* _pData, size_t _Count)
+    {
+        __m128i Total = _mm_setzero_si128();
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128i Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pData + Index));
+            __m128i Sign = _mm_cmpgt_epi32(_mm_setzero_si128(), Data);    // widen to 64 bit by hand
+            Total = _mm_add_epi64(Total, _mm_unpacklo_epi32(Data, Sign));
+            Total = _mm_add_epi64(Total, _mm_unpackhi_epi32(Data, Sign));
+        }
+
+        int64_t Lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Total);
+
+        return Lanes[0] + Lanes[1] + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    static float Sum(const float* _pData, size_t _Count)
+    {
+        __m128 Total0 = _mm_setzero_ps();
+        __m128 Total1 = _mm_setzero_ps();
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            Total0 = _mm_add_ps(Total0, _mm_loadu_ps(_pData + Index));
+            Total1 = _mm_add_ps(Total1, _mm_loadu_ps(_pData + Index + 4));
+        }
+
+        return ReduceAdd(_mm_add_ps(Total0, Total1)) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    static double Sum(const double* _pData, size_t _Count)
+    {
+        __m128d Total0 = _mm_setzero_pd();
+        __m128d Total1 = _mm_setzero_pd();
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            Total0 = _mm_add_pd(Total0, _mm_loadu_pd(_pData + Index));
+            Total1 = _mm_add_pd(Total1, _mm_loadu_pd(_pData + Index + 2));
+        }
+
+        return ReduceAdd(_mm_add_pd(Total0, Total1)) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    static int64_t Dot(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count)
+    {
+        // SSE2 has no signed 32 x 32 -> 64 bit multiply
+        return SScalarKernels::Dot(_pLhs, _pRhs, _Count);
+    }
+
+    static float Dot(const float* _pLhs, const float* _pRhs, size_t _Count)
+    {
+        __m128 Total0 = _mm_setzero_ps();
+        __m128 Total1 = _mm_setzero_ps();
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            Total0 = _mm_add_ps(Total0, _mm_mul_ps(_mm_loadu_ps(_pLhs + Index), _mm_loadu_ps(_pRhs + Index)));
+            Total1 = _mm_add_ps(Total1, _mm_mul_ps(_mm_loadu_ps(_pLhs + Index + 4), _mm_loadu_ps(_pRhs + Index + 4)));
+        }
+
+        return ReduceAdd(_mm_add_ps(Total0, Total1)) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    static double Dot(const double* _pLhs, const double* _pRhs, size_t _Count)
+    {
+        __m128d Total0 = _mm_setzero_pd();
+        __m128d Total1 = _mm_setzero_pd();
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            Total0 = _mm_add_pd(Total0, _mm_mul_pd(_mm_loadu_pd(_pLhs + Index), _mm_loadu_pd(_pRhs + Index)));
+            Total1 = _mm_add_pd(Total1, _mm_mul_pd(_mm_loadu_pd(_pLhs + Index + 2), _mm_loadu_pd(_pRhs + Index + 2)));
+        }
+
+        return ReduceAdd(_mm_add_pd(Total0, Total1)) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    static bool Equal(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count)
+    {
+        // integers are equal exactly when their bytes are, the C library compares those fastest
+        return _Count == 0 || memcmp(_pLhs, _pRhs, _Count * sizeof(int32_t)) == 0;
+    }
+
+    static bool Equal(const float* _pLhs, const float* _pRhs, size_t _Count)
+    {
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            if (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(_pLhs + Index), _mm_loadu_ps(_pRhs + Index))) != 0xF)
+            {
+                return false;
+            }
+        }
+        return SScalarKernels::Equal(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    static bool Equal(const double* _pLhs, const double* _pRhs, size_t _Count)
+    {
+        size_t Index = 0;
+        for (; Index + 2 <= _Count; Index += 2)
+        {
+            if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(_pLhs + Index), _mm_loadu_pd(_pRhs + Index))) != 0x3)
+            {
+                return false;
+            }
+        }
+        return SScalarKernels::Equal(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    static size_t PopCount(const uint64_t* _pWords, size_t _Count)
+    {
+        const __m128i Mask1 = _mm_set1_epi8(0x55);
+        const __m128i Mask2 = _mm_set1_epi8(0x33);
+        const __m128i Mask4 = _mm_set1_epi8(0x0F);
+
+        __m128i Total = _mm_setzero_si128();
+
+        size_t Index = 0;
+        for (; Index + 2 <= _Count; Index += 2)
+        {
+            // bit counts per byte in parallel, psadbw adds the bytes up
+            __m128i Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pWords + Index));
+            Data  = _mm_sub_epi8(Data, _mm_and_si128(_mm_srli_epi64(Data, 1), Mask1));
+            Data  = _mm_add_epi8(_mm_and_si128(Data, Mask2), _mm_and_si128(_mm_srli_epi64(Data, 2), Mask2));
+            Data  = _mm_and_si128(_mm_add_epi8(Data, _mm_srli_epi64(Data, 4)), Mask4);
+            Total = _mm_add_epi64(Total, _mm_sad_epu8(Data, _mm_setzero_si128()));
+        }
+
+        uint64_t Lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Total);
+
+        return static_cast<size_t>(Lanes[0] + Lanes[1]) + SScalarKernels::PopCount(_pWords + Index, _Count - Index);
+    }
+
+private:
+
+    static const size_t s_CountBlock = size_t(1) << 30;                 // elements per 32 bit lane counter run
+
+    static size_t ReduceCount(__m128i _Counter)
+    {
+        uint32_t Lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), _Counter);
+        return static_cast<size_t>(Lanes[0]) + Lanes[1] + Lanes[2] + Lanes[3];
+    }
+
+    template <typename T>
+    static SMinMax<T> Merge(SMinMax<T> _Result, const T* _pData, size_t _Count)
+    {
+        if (_Count > 0)
+        {
+            SMinMax<T> Tail = SScalarKernels::MinMax(_pData, _Count);
+            _Result.m_Min = (Tail.m_Min < _Result.m_Min) ? Tail.m_Min : _Result.m_Min;
+            _Result.m_Max = (_Result.m_Max < Tail.m_Max) ? Tail.m_Max : _Result.m_Max;
+        }
+        return _Result;
+    }
+
+    static float ReduceAdd(__m128 _Value)
+    {
+        __m128 Pairs = _mm_add_ps(_Value, _mm_movehl_ps(_Value, _Value));
+        return _mm_cvtss_f32(_mm_add_ss(Pairs, _mm_shuffle_ps(Pairs, Pairs, 1)));
+    }
+
+    static double ReduceAdd(__m128d _Value)
+    {
+        return _mm_cvtsd_f64(_mm_add_sd(_Value, _mm_unpackhi_pd(_Value, _Value)));
+    }
+
+    friend struct SAvx2Kernels;
+    friend struct SAvx512Kernels;
+};
+
+/*************************************************************************
+ * AVX2 KERNEL SUBSECTION
+ *************************************************************************/
+
+struct SAvx2Kernels
+{
+    BASE_SIMD_TARGET_AVX2
+    static size_t Find(const int32_t* _pData, size_t _Count, int32_t _Value)
+    {
+        const __m256i Value = _mm256_set1_epi32(_Value);
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256i Equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pData + Index)), Value);
+            int     Mask  = _mm256_movemask_ps(_mm256_castsi256_ps(Equal));
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+        return Index + SScalarKernels::Find(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t Find(const float* _pData, size_t _Count, float _Value)
+    {
+        const __m256 Value = _mm256_set1_ps(_Value);
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            int Mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(_pData + Index), Value, _CMP_EQ_OQ));
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+        return Index + SScalarKernels::Find(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t Find(const double* _pData, size_t _Count, double _Value)
+    {
+        const __m256d Value = _mm256_set1_pd(_Value);
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            int Mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(_pData + Index), Value, _CMP_EQ_OQ));
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+        return Index + SScalarKernels::Find(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t Count(const int32_t* _pData, size_t _Count, int32_t _Value)
+    {
+        const __m256i Value = _mm256_set1_epi32(_Value);
+
+        size_t Matches = 0;
+        size_t Index   = 0;
+
+        while (Index + 8 <= _Count)
+        {
+            size_t  BlockEnd = (_Count - Index > SSse2Kernels::s_CountBlock) ? Index + SSse2Kernels::s_CountBlock : _Count;
+            __m256i Counter  = _mm256_setzero_si256();
+
+            for (; Index + 8 <= BlockEnd; Index += 8)
+            {
+                __m256i Data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pData + Index));
+                Counter = _mm256_sub_epi32(Counter, _mm256_cmpeq_epi32(Data, Value));
+            }
+
+            Matches += ReduceCount(Counter);
+        }
+
+        return Matches + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t Count(const float* _pData, size_t _Count, float _Value)
+    {
+        const __m256 Value = _mm256_set1_ps(_Value);
+
+        size_t Matches = 0;
+        size_t Index   = 0;
+
+        while (Index + 8 <= _Count)
+        {
+            size_t  BlockEnd = (_Count - Index > SSse2Kernels::s_CountBlock) ? Index + SSse2Kernels::s_CountBlock : _Count;
+            __m256i Counter  = _mm256_setzero_si256();
+
+            for (; Index + 8 <= BlockEnd; Index += 8)
+            {
+                __m256 Equal = _mm256_cmp_ps(_mm256_loadu_ps(_pData + Index), Value, _CMP_EQ_OQ);
+                Counter = _mm256_sub_epi32(Counter, _mm256_castps_si256(Equal));
+            }
+
+            Matches += ReduceCount(Counter);
+        }
+
+        return Matches + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t Count(const double* _pData, size_t _Count, double _Value)
+    {
+        const __m256d Value   = _mm256_set1_pd(_Value);
+        __m256i       Counter = _mm256_setzero_si256();                 // 64 bit lanes cannot overflow
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m256d Equal = _mm256_cmp_pd(_mm256_loadu_pd(_pData + Index), Value, _CMP_EQ_OQ);
+            Counter = _mm256_sub_epi64(Counter, _mm256_castpd_si256(Equal));
+        }
+
+        return static_cast<size_t>(ReduceAdd(Counter)) + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static SMinMax<int32_t> MinMax(const int32_t* _pData, size_t _Count)
+    {
+        if (_Count < 8)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m256i Min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pData));
+        __m256i Max = Min;
+
+        size_t Index = 8;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256i Data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pData + Index));
+            Min = _mm256_min_epi32(Min, Data);
+            Max = _mm256_max_epi32(Max, Data);
+        }
+
+        int32_t Lanes[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Lanes), Min);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Lanes + 8), Max);
+
+        SMinMax<int32_t> Result = { SScalarKernels::MinMax(Lanes, 8).m_Min, SScalarKernels::MinMax(Lanes + 8, 8).m_Max };
+        return SSse2Kernels::Merge(Result, _pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static SMinMax<float> MinMax(const float* _pData, size_t _Count)
+    {
+        if (_Count < 8)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m256 Min = _mm256_loadu_ps(_pData);
+        __m256 Max = Min;
+
+        size_t Index = 8;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256 Data = _mm256_loadu_ps(_pData + Index);
+            Min = _mm256_min_ps(Min, Data);
+            Max = _mm256_max_ps(Max, Data);
+        }
+
+        float Lanes[16];
+        _mm256_storeu_ps(Lanes, Min);
+        _mm256_storeu_ps(Lanes + 8, Max);
+
+        SMinMax<float> Result = { SScalarKernels::MinMax(Lanes, 8).m_Min, SScalarKernels::MinMax(Lanes + 8, 8).m_Max };
+        return SSse2Kernels::Merge(Result, _pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static SMinMax<double> MinMax(const double* _pData, size_t _Count)
+    {
+        if (_Count < 4)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m256d Min = _mm256_loadu_pd(_pData);
+        __m256d Max = Min;
+
+        size_t Index = 4;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m256d Data = _mm256_loadu_pd(_pData + Index);
+            Min = _mm256_min_pd(Min, Data);
+            Max = _mm256_max_pd(Max, Data);
+        }
+
+        double Lanes[8];
+        _mm256_storeu_pd(Lanes, Min);
+        _mm256_storeu_pd(Lanes + 4, Max);
+
+        SMinMax<double> Result = { SScalarKernels::MinMax(Lanes, 4).m_Min, SScalarKernels::MinMax(Lanes + 4, 4).m_Max };
+        return SSse2Kernels::Merge(Result, _pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static int64_t Sum(const int32_t* _pData, size_t _Count)
+    {
+        __m256i Total = _mm256_setzero_si256();
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256i Data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pData + Index));
+            Total = _mm256_add_epi64(Total, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(Data)));
+            Total = _mm256_add_epi64(Total, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(Data, 1)));
+        }
+
+        return ReduceAdd(Total) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static float Sum(const float* _pData, size_t _Count)
+    {
+        __m256 Total0 = _mm256_setzero_ps();
+        __m256 Total1 = _mm256_setzero_ps();
+
+        size_t Index = 0;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            Total0 = _mm256_add_ps(Total0, _mm256_loadu_ps(_pData + Index));
+            Total1 = _mm256_add_ps(Total1, _mm256_loadu_ps(_pData + Index + 8));
+        }
+
+        return ReduceAdd(_mm256_add_ps(Total0, Total1)) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static double Sum(const double* _pData, size_t _Count)
+    {
+        __m256d Total0 = _mm256_setzero_pd();
+        __m256d Total1 = _mm256_setzero_pd();
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            Total0 = _mm256_add_pd(Total0, _mm256_loadu_pd(_pData + Index));
+            Total1 = _mm256_add_pd(Total1, _mm256_loadu_pd(_pData + Index + 4));
+        }
+
+        return ReduceAdd(_mm256_add_pd(Total0, Total1)) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static int64_t Dot(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count)
+    {
+        __m256i Total = _mm256_setzero_si256();
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256i Lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pLhs + Index));
+            __m256i Rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pRhs + Index));
+
+            // vpmuldq multiplies the even lanes, shifting brings the odd ones down
+            Total = _mm256_add_epi64(Total, _mm256_mul_epi32(Lhs, Rhs));
+            Total = _mm256_add_epi64(Total, _mm256_mul_epi32(_mm256_srli_epi64(Lhs, 32), _mm256_srli_epi64(Rhs, 32)));
+        }
+
+        return ReduceAdd(Total) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static float Dot(const float* _pLhs, const float* _pRhs, size_t _Count)
+    {
+        __m256 Total0 = _mm256_setzero_ps();
+        __m256 Total1 = _mm256_setzero_ps();
+
+        size_t Index = 0;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            Total0 = _mm256_add_ps(Total0, _mm256_mul_ps(_mm256_loadu_ps(_pLhs + Index), _mm256_loadu_ps(_pRhs + Index)));
+            Total1 = _mm256_add_ps(Total1, _mm256_mul_ps(_mm256_loadu_ps(_pLhs + Index + 8), _mm256_loadu_ps(_pRhs + Index + 8)));
+        }
+
+        return ReduceAdd(_mm256_add_ps(Total0, Total1)) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static double Dot(const double* _pLhs, const double* _pRhs, size_t _Count)
+    {
+        __m256d Total0 = _mm256_setzero_pd();
+        __m256d Total1 = _mm256_setzero_pd();
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            Total0 = _mm256_add_pd(Total0, _mm256_mul_pd(_mm256_loadu_pd(_pLhs + Index), _mm256_loadu_pd(_pRhs + Index)));
+            Total1 = _mm256_add_pd(Total1, _mm256_mul_pd(_mm256_loadu_pd(_pLhs + Index + 4), _mm256_loadu_pd(_pRhs + Index + 4)));
+        }
+
+        return ReduceAdd(_mm256_add_pd(Total0, Total1)) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    static bool Equal(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count)
+    {
+        return SSse2Kernels::Equal(_pLhs, _pRhs, _Count);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static bool Equal(const float* _pLhs, const float* _pRhs, size_t _Count)
+    {
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256 Equal = _mm256_cmp_ps(_mm256_loadu_ps(_pLhs + Index), _mm256_loadu_ps(_pRhs + Index), _CMP_EQ_OQ);
+            if (_mm256_movemask_ps(Equal) != 0xFF)
+            {
+                return false;
+            }
+        }
+        return SScalarKernels::Equal(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static bool Equal(const double* _pLhs, const double* _pRhs, size_t _Count)
+    {
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m256d Equal = _mm256_cmp_pd(_mm256_loadu_pd(_pLhs + Index), _mm256_loadu_pd(_pRhs + Index), _CMP_EQ_OQ);
+            if (_mm256_movemask_pd(Equal) != 0xF)
+            {
+                return false;
+            }
+        }
+        return SScalarKernels::Equal(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t PopCount(const uint64_t* _pWords, size_t _Count)
+    {
+        // bit counts of both nibbles of every byte from a 16 entry table
+        const __m256i Table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i Low   = _mm256_set1_epi8(0x0F);
+
+        __m256i Total = _mm256_setzero_si256();
+
+        size_t Index = 0;
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m256i Data   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_pWords + Index));
+            __m256i Counts = _mm256_add_epi8(_mm256_shuffle_epi8(Table, _mm256_and_si256(Data, Low)),
+                                             _mm256_shuffle_epi8(Table, _mm256_and_si256(_mm256_srli_epi16(Data, 4), Low)));
+            Total = _mm256_add_epi64(Total, _mm256_sad_epu8(Counts, _mm256_setzero_si256()));
+        }
+
+        return static_cast<size_t>(ReduceAdd(Total)) + SScalarKernels::PopCount(_pWords + Index, _Count - Index);
+    }
+
+private:
+
+    BASE_SIMD_TARGET_AVX2
+    static size_t ReduceCount(__m256i _Counter)
+    {
+        uint32_t Lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Lanes), _Counter);
+
+        size_t Total = 0;
+        for (size_t Lane = 0; Lane < 8; ++Lane)
+        {
+            Total += Lanes[Lane];
+        }
+        return Total;
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static int64_t ReduceAdd(__m256i _Value)
+    {
+        int64_t Lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Lanes), _Value);
+        return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static float ReduceAdd(__m256 _Value)
+    {
+        __m128 Half = _mm_add_ps(_mm256_castps256_ps128(_Value), _mm256_extractf128_ps(_Value, 1));
+        return SSse2Kernels::ReduceAdd(Half);
+    }
+
+    BASE_SIMD_TARGET_AVX2
+    static double ReduceAdd(__m256d _Value)
+    {
+        __m128d Half = _mm_add_pd(_mm256_castpd256_pd128(_Value), _mm256_extractf128_pd(_Value, 1));
+        return SSse2Kernels::ReduceAdd(Half);
+    }
+};
+
+/*************************************************************************
+ * AVX-512 KERNEL SUBSECTION
+ *************************************************************************/
+
+// the avx512 intrinsic headers of GCC 12 trip these warnings themselves
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+struct SAvx512Kernels
+{
+    BASE_SIMD_TARGET_AVX512
+    static size_t Find(const int32_t* _pData, size_t _Count, int32_t _Value)
+    {
+        const __m512i Value = _mm512_set1_epi32(_Value);
+
+        size_t Index = 0;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            __mmask16 Mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(_pData + Index), Value);
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+
+        // the tail is loaded under a mask, lanes past the end are never touched
+        __mmask16 Tail = GetTailMask16(_Count - Index);
+        __mmask16 Mask = _mm512_mask_cmpeq_epi32_mask(Tail, _mm512_maskz_loadu_epi32(Tail, _pData + Index), Value);
+        return Mask != 0 ? Index + BASE::UTIL::GetLowestBit(Mask) : _Count;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t Find(const float* _pData, size_t _Count, float _Value)
+    {
+        const __m512 Value = _mm512_set1_ps(_Value);
+
+        size_t Index = 0;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            __mmask16 Mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(_pData + Index), Value, _CMP_EQ_OQ);
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+
+        __mmask16 Tail = GetTailMask16(_Count - Index);
+        __mmask16 Mask = _mm512_mask_cmp_ps_mask(Tail, _mm512_maskz_loadu_ps(Tail, _pData + Index), Value, _CMP_EQ_OQ);
+        return Mask != 0 ? Index + BASE::UTIL::GetLowestBit(Mask) : _Count;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t Find(const double* _pData, size_t _Count, double _Value)
+    {
+        const __m512d Value = _mm512_set1_pd(_Value);
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __mmask8 Mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(_pData + Index), Value, _CMP_EQ_OQ);
+            if (Mask != 0)
+            {
+                return Index + BASE::UTIL::GetLowestBit(Mask);
+            }
+        }
+
+        __mmask8 Tail = GetTailMask8(_Count - Index);
+        __mmask8 Mask = _mm512_mask_cmp_pd_mask(Tail, _mm512_maskz_loadu_pd(Tail, _pData + Index), Value, _CMP_EQ_OQ);
+        return Mask != 0 ? Index + BASE::UTIL::GetLowestBit(Mask) : _Count;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t Count(const int32_t* _pData, size_t _Count, int32_t _Value)
+    {
+        const __m512i Value = _mm512_set1_epi32(_Value);
+        const __m512i One   = _mm512_set1_epi32(1);
+
+        size_t Matches = 0;
+        size_t Index   = 0;
+
+        while (Index + 16 <= _Count)
+        {
+            size_t  BlockEnd = (_Count - Index > SSse2Kernels::s_CountBlock) ? Index + SSse2Kernels::s_CountBlock : _Count;
+            __m512i Counter  = _mm512_setzero_si512();
+
+            for (; Index + 16 <= BlockEnd; Index += 16)
+            {
+                __mmask16 Equal = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(_pData + Index), Value);
+                Counter = _mm512_mask_add_epi32(Counter, Equal, Counter, One);
+            }
+
+            Matches += ReduceCount(Counter);
+        }
+
+        return Matches + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t Count(const float* _pData, size_t _Count, float _Value)
+    {
+        const __m512  Value = _mm512_set1_ps(_Value);
+        const __m512i One   = _mm512_set1_epi32(1);
+
+        size_t Matches = 0;
+        size_t Index   = 0;
+
+        while (Index + 16 <= _Count)
+        {
+            size_t  BlockEnd = (_Count - Index > SSse2Kernels::s_CountBlock) ? Index + SSse2Kernels::s_CountBlock : _Count;
+            __m512i Counter  = _mm512_setzero_si512();
+
+            for (; Index + 16 <= BlockEnd; Index += 16)
+            {
+                __mmask16 Equal = _mm512_cmp_ps_mask(_mm512_loadu_ps(_pData + Index), Value, _CMP_EQ_OQ);
+                Counter = _mm512_mask_add_epi32(Counter, Equal, Counter, One);
+            }
+
+            Matches += ReduceCount(Counter);
+        }
+
+        return Matches + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t Count(const double* _pData, size_t _Count, double _Value)
+    {
+        const __m512d Value   = _mm512_set1_pd(_Value);
+        const __m512i One     = _mm512_set1_epi64(1);
+        __m512i       Counter = _mm512_setzero_si512();                 // 64 bit lanes cannot overflow
+
+        size_t Index = 0;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __mmask8 Equal = _mm512_cmp_pd_mask(_mm512_loadu_pd(_pData + Index), Value, _CMP_EQ_OQ);
+            Counter = _mm512_mask_add_epi64(Counter, Equal, Counter, One);
+        }
+
+        return static_cast<size_t>(ReduceAdd(Counter)) + SScalarKernels::Count(_pData + Index, _Count - Index, _Value);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static SMinMax<int32_t> MinMax(const int32_t* _pData, size_t _Count)
+    {
+        if (_Count < 16)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m512i Min = _mm512_loadu_si512(_pData);
+        __m512i Max = Min;
+
+        size_t Index = 16;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            __m512i Data = _mm512_loadu_si512(_pData + Index);
+            Min = _mm512_min_epi32(Min, Data);
+            Max = _mm512_max_epi32(Max, Data);
+        }
+
+        // masked off lanes keep their value, so the tail cannot pull in zeros
+        __mmask16 Tail = GetTailMask16(_Count - Index);
+        __m512i   Data = _mm512_maskz_loadu_epi32(Tail, _pData + Index);
+        Min = _mm512_mask_min_epi32(Min, Tail, Min, Data);
+        Max = _mm512_mask_max_epi32(Max, Tail, Max, Data);
+
+        int32_t Lanes[32];
+        _mm512_storeu_si512(Lanes, Min);
+        _mm512_storeu_si512(Lanes + 16, Max);
+
+        SMinMax<int32_t> Result = { SScalarKernels::MinMax(Lanes, 16).m_Min, SScalarKernels::MinMax(Lanes + 16, 16).m_Max };
+        return Result;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static SMinMax<float> MinMax(const float* _pData, size_t _Count)
+    {
+        if (_Count < 16)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m512 Min = _mm512_loadu_ps(_pData);
+        __m512 Max = Min;
+
+        size_t Index = 16;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            __m512 Data = _mm512_loadu_ps(_pData + Index);
+            Min = _mm512_min_ps(Min, Data);
+            Max = _mm512_max_ps(Max, Data);
+        }
+
+        __mmask16 Tail = GetTailMask16(_Count - Index);
+        __m512    Data = _mm512_maskz_loadu_ps(Tail, _pData + Index);
+        Min = _mm512_mask_min_ps(Min, Tail, Min, Data);
+        Max = _mm512_mask_max_ps(Max, Tail, Max, Data);
+
+        float Lanes[32];
+        _mm512_storeu_ps(Lanes, Min);
+        _mm512_storeu_ps(Lanes + 16, Max);
+
+        SMinMax<float> Result = { SScalarKernels::MinMax(Lanes, 16).m_Min, SScalarKernels::MinMax(Lanes + 16, 16).m_Max };
+        return Result;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static SMinMax<double> MinMax(const double* _pData, size_t _Count)
+    {
+        if (_Count < 8)
+        {
+            return SScalarKernels::MinMax(_pData, _Count);
+        }
+
+        __m512d Min = _mm512_loadu_pd(_pData);
+        __m512d Max = Min;
+
+        size_t Index = 8;
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m512d Data = _mm512_loadu_pd(_pData + Index);
+            Min = _mm512_min_pd(Min, Data);
+            Max = _mm512_max_pd(Max, Data);
+        }
+
+        __mmask8 Tail = GetTailMask8(_Count - Index);
+        __m512d  Data = _mm512_maskz_loadu_pd(Tail, _pData + Index);
+        Min = _mm512_mask_min_pd(Min, Tail, Min, Data);
+        Max = _mm512_mask_max_pd(Max, Tail, Max, Data);
+
+        double Lanes[16];
+        _mm512_storeu_pd(Lanes, Min);
+        _mm512_storeu_pd(Lanes + 8, Max);
+
+        SMinMax<double> Result = { SScalarKernels::MinMax(Lanes, 8).m_Min, SScalarKernels::MinMax(Lanes + 8, 8).m_Max };
+        return Result;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static int64_t Sum(const int32_t* _pData, size_t _Count)
+    {
+        __m512i Total = _mm512_setzero_si512();
+
+        size_t Index = 0;
+        for (; Index < _Count; Index += 16)
+        {
+            // a zeroed tail adds nothing; the shifts sign extend the even and the odd lanes
+            __m512i Data = _mm512_maskz_loadu_epi32(GetTailMask16(_Count - Index), _pData + Index);
+            Total = _mm512_add_epi64(Total, _mm512_srai_epi64(_mm512_slli_epi64(Data, 32), 32));
+            Total = _mm512_add_epi64(Total, _mm512_srai_epi64(Data, 32));
+        }
+
+        return ReduceAdd(Total);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static float Sum(const float* _pData, size_t _Count)
+    {
+        __m512 Total0 = _mm512_setzero_ps();
+        __m512 Total1 = _mm512_setzero_ps();
+
+        size_t Index = 0;
+        for (; Index + 32 <= _Count; Index += 32)
+        {
+            Total0 = _mm512_add_ps(Total0, _mm512_loadu_ps(_pData + Index));
+            Total1 = _mm512_add_ps(Total1, _mm512_loadu_ps(_pData + Index + 16));
+        }
+
+        return ReduceAdd(_mm512_add_ps(Total0, Total1)) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static double Sum(const double* _pData, size_t _Count)
+    {
+        __m512d Total0 = _mm512_setzero_pd();
+        __m512d Total1 = _mm512_setzero_pd();
+
+        size_t Index = 0;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            Total0 = _mm512_add_pd(Total0, _mm512_loadu_pd(_pData + Index));
+            Total1 = _mm512_add_pd(Total1, _mm512_loadu_pd(_pData + Index + 8));
+        }
+
+        return ReduceAdd(_mm512_add_pd(Total0, Total1)) + SScalarKernels::Sum(_pData + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static int64_t Dot(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count)
+    {
+        __m512i Total = _mm512_setzero_si512();
+
+        size_t Index = 0;
+        for (; Index < _Count; Index += 16)
+        {
+            __mmask16 Tail = GetTailMask16(_Count - Index);
+            __m512i   Lhs  = _mm512_maskz_loadu_epi32(Tail, _pLhs + Index);
+            __m512i   Rhs  = _mm512_maskz_loadu_epi32(Tail, _pRhs + Index);
+
+            // vpmuldq multiplies the even lanes, shifting brings the odd ones down
+            Total = _mm512_add_epi64(Total, _mm512_mul_epi32(Lhs, Rhs));
+            Total = _mm512_add_epi64(Total, _mm512_mul_epi32(_mm512_srli_epi64(Lhs, 32), _mm512_srli_epi64(Rhs, 32)));
+        }
+
+        return ReduceAdd(Total);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static float Dot(const float* _pLhs, const float* _pRhs, size_t _Count)
+    {
+        __m512 Total0 = _mm512_setzero_ps();
+        __m512 Total1 = _mm512_setzero_ps();
+
+        size_t Index = 0;
+        for (; Index + 32 <= _Count; Index += 32)
+        {
+            Total0 = _mm512_add_ps(Total0, _mm512_mul_ps(_mm512_loadu_ps(_pLhs + Index), _mm512_loadu_ps(_pRhs + Index)));
+            Total1 = _mm512_add_ps(Total1, _mm512_mul_ps(_mm512_loadu_ps(_pLhs + Index + 16), _mm512_loadu_ps(_pRhs + Index + 16)));
+        }
+
+        return ReduceAdd(_mm512_add_ps(Total0, Total1)) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static double Dot(const double* _pLhs, const double* _pRhs, size_t _Count)
+    {
+        __m512d Total0 = _mm512_setzero_pd();
+        __m512d Total1 = _mm512_setzero_pd();
+
+        size_t Index = 0;
+        for (; Index + 16 <= _Count; Index += 16)
+        {
+            Total0 = _mm512_add_pd(Total0, _mm512_mul_pd(_mm512_loadu_pd(_pLhs + Index), _mm512_loadu_pd(_pRhs + Index)));
+            Total1 = _mm512_add_pd(Total1, _mm512_mul_pd(_mm512_loadu_pd(_pLhs + Index + 8), _mm512_loadu_pd(_pRhs + Index + 8)));
+        }
+
+        return ReduceAdd(_mm512_add_pd(Total0, Total1)) + SScalarKernels::Dot(_pLhs + Index, _pRhs + Index, _Count - Index);
+    }
+
+    static bool Equal(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count)
+    {
+        return SSse2Kernels::Equal(_pLhs, _pRhs, _Count);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static bool Equal(const float* _pLhs, const float* _pRhs, size_t _Count)
+    {
+        size_t Index = 0;
+        for (; Index < _Count; Index += 16)
+        {
+            // NaN compares unequal, like the scalar kernel
+            __mmask16 Tail = GetTailMask16(_Count - Index);
+            __m512    Lhs  = _mm512_maskz_loadu_ps(Tail, _pLhs + Index);
+            __m512    Rhs  = _mm512_maskz_loadu_ps(Tail, _pRhs + Index);
+            if (_mm512_mask_cmp_ps_mask(Tail, Lhs, Rhs, _CMP_EQ_OQ) != Tail)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static bool Equal(const double* _pLhs, const double* _pRhs, size_t _Count)
+    {
+        size_t Index = 0;
+        for (; Index < _Count; Index += 8)
+        {
+            __mmask8 Tail = GetTailMask8(_Count - Index);
+            __m512d  Lhs  = _mm512_maskz_loadu_pd(Tail, _pLhs + Index);
+            __m512d  Rhs  = _mm512_maskz_loadu_pd(Tail, _pRhs + Index);
+            if (_mm512_mask_cmp_pd_mask(Tail, Lhs, Rhs, _CMP_EQ_OQ) != Tail)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t PopCount(const uint64_t* _pWords, size_t _Count)
+    {
+        // the AVX2 nibble table, vpshufb looks up within every 128 bit lane
+        const __m512i Table = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+        const __m512i Low   = _mm512_set1_epi8(0x0F);
+
+        __m512i Total = _mm512_setzero_si512();
+
+        size_t Index = 0;
+        for (; Index < _Count; Index += 8)
+        {
+            __m512i Data   = _mm512_maskz_loadu_epi64(GetTailMask8(_Count - Index), _pWords + Index);
+            __m512i Counts = _mm512_add_epi8(_mm512_shuffle_epi8(Table, _mm512_and_si512(Data, Low)),
+                                             _mm512_shuffle_epi8(Table, _mm512_and_si512(_mm512_srli_epi16(Data, 4), Low)));
+            Total = _mm512_add_epi64(Total, _mm512_sad_epu8(Counts, _mm512_setzero_si512()));
+        }
+
+        return static_cast<size_t>(ReduceAdd(Total));
+    }
+
+private:
+
+    static __mmask16 GetTailMask16(size_t _Remaining)                   // lanes below _Remaining, all for 16 or more
+    {
+        return static_cast<__mmask16>(_Remaining >= 16 ? 0xFFFF : (1u << _Remaining) - 1);
+    }
+
+    static __mmask8 GetTailMask8(size_t _Remaining)
+    {
+        return static_cast<__mmask8>(_Remaining >= 8 ? 0xFF : (1u << _Remaining) - 1);
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static size_t ReduceCount(__m512i _Counter)
+    {
+        uint32_t Lanes[16];
+        _mm512_storeu_si512(Lanes, _Counter);
+
+        size_t Total = 0;
+        for (size_t Lane = 0; Lane < 16; ++Lane)
+        {
+            Total += Lanes[Lane];
+        }
+        return Total;
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static int64_t ReduceAdd(__m512i _Value)
+    {
+        int64_t Lanes[8];
+        _mm512_storeu_si512(Lanes, _Value);
+        return ((Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3])) + ((Lanes[4] + Lanes[5]) + (Lanes[6] + Lanes[7]));
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static float ReduceAdd(__m512 _Value)
+    {
+        float Lanes[16];
+        _mm512_storeu_ps(Lanes, _Value);
+        for (size_t Width = 8; Width > 0; Width /= 2)
+        {
+            for (size_t Lane = 0; Lane < Width; ++Lane)
+            {
+                Lanes[Lane] += Lanes[Lane + Width];
+            }
+        }
+        return Lanes[0];
+    }
+
+    BASE_SIMD_TARGET_AVX512
+    static double ReduceAdd(__m512d _Value)
+    {
+        double Lanes[8];
+        _mm512_storeu_pd(Lanes, _Value);
+        for (size_t Width = 4; Width > 0; Width /= 2)
+        {
+            for (size_t Lane = 0; Lane < Width; ++Lane)
+            {
+                Lanes[Lane] += Lanes[Lane + Width];
+            }
+        }
+        return Lanes[0];
+    }
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+#else
+
+typedef SScalarKernels SSse2Kernels;                                    // no SIMD on this architecture
+typedef SScalarKernels SAvx2Kernels;
+typedef SScalarKernels SAvx512Kernels;
+
+#endif // BASE_SIMD_X86
+
+/*************************************************************************
+ * DISPATCH SUBSECTION
+ *************************************************************************/
+
+#if defined(BASE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+inline uint64_t
+GetEnabledXState()                                                      // XCR0, 0 if the OS does not use xsave
+{
+    unsigned int Eax, Ebx, Ecx, Edx;
+    __asm__ ("cpuid" : "=a"(Eax), "=b"(Ebx), "=c"(Ecx), "=d"(Edx) : "a"(1), "c"(0));
+    if ((Ecx & (1u << 27)) == 0)
+    {
+        return 0;
+    }
+
+    unsigned int Low, High;
+    __asm__ ("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+    return (static_cast<uint64_t>(High) << 32) | Low;
+}
+#endif
+
+inline ESimdLevel
+DetectSimdLevel()
+{
+    // AVX-512 needs the OS to save the opmask, the upper zmm halves and
+    // zmm16-31 (XCR0 bits 5 to 7) on top of the sse and ymm state (1, 2)
+    const uint64_t s_ZmmState = 0xE6;
+
+#if defined(BASE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && (GetEnabledXState() & s_ZmmState) == s_ZmmState)
+    {
+        return SimdAvx512;
+    }
+    return __builtin_cpu_supports("avx2") ? SimdAvx2 : SimdSse2;
+#elif defined(BASE_SIMD_X86) && defined(_MSC_VER)
+    int Info[4];
+    __cpuid(Info, 0);
+    if (Info[0] < 7)
+    {
+        return SimdSse2;
+    }
+
+    __cpuidex(Info, 7, 0);
+    bool HasAvx2   = (Info[1] & (1 << 5)) != 0;
+    bool HasAvx512 = (Info[1] & (1 << 16)) != 0 && (Info[1] & (1 << 30)) != 0;   // F and BW
+    __cpuid(Info, 1);
+    uint64_t XState = (Info[2] & (1 << 27)) != 0 ? _xgetbv(0) : 0;
+
+    if (HasAvx512 && (XState & s_ZmmState) == s_ZmmState)
+    {
+        return SimdAvx512;
+    }
+    return (HasAvx2 && (XState & 6) == 6) ? SimdAvx2 : SimdSse2;  // the OS saves the ymm registers
+#else
+    return SimdScalar;
+#endif
+}
+
+inline ESimdLevel
+GetSimdLevel()
+{
+    static const ESimdLevel s_Level = DetectSimdLevel();
+    return s_Level;
+}
+
+#define BASE_SIMD_DISPATCH(Call)                                        \
+    switch (GetSimdLevel())                                             \
+    {                                                                   \
+    case SimdAvx512: return SAvx512Kernels::Call;                       \
+    case SimdAvx2:   return SAvx2Kernels::Call;                         \
+    case SimdSse2:   return SSse2Kernels::Call;                         \
+    default:         return SScalarKernels::Call;                       \
+    }
+
+/*************************************************************************
+ * ALGORITHM SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+size_t SimdFind(const T* _pData, size_t _Count, T _Value)               // index of the first match, _Count if none
+{
+    return SScalarKernels::Find(_pData, _Count, _Value);
+}
+
+inline size_t SimdFind(const int32_t* _pData, size_t _Count, int32_t _Value) { BASE_SIMD_DISPATCH(Find(_pData, _Count, _Value)) }
+inline size_t SimdFind(const float* _pData, size_t _Count, float _Value)     { BASE_SIMD_DISPATCH(Find(_pData, _Count, _Value)) }
+inline size_t SimdFind(const double* _pData, size_t _Count, double _Value)   { BASE_SIMD_DISPATCH(Find(_pData, _Count, _Value)) }
+
+template <typename T>
+size_t SimdCount(const T* _pData, size_t _Count, T _Value)
+{
+    return SScalarKernels::Count(_pData, _Count, _Value);
+}
+
+inline size_t SimdCount(const int32_t* _pData, size_t _Count, int32_t _Value) { BASE_SIMD_DISPATCH(Count(_pData, _Count, _Value)) }
+inline size_t SimdCount(const float* _pData, size_t _Count, float _Value)     { BASE_SIMD_DISPATCH(Count(_pData, _Count, _Value)) }
+inline size_t SimdCount(const double* _pData, size_t _Count, double _Value)   { BASE_SIMD_DISPATCH(Count(_pData, _Count, _Value)) }
+
+template <typename T>
+SMinMax<T> SimdMinMax(const T* _pData, size_t _Count)                   // _Count has to be above 0
+{
+    return SScalarKernels::MinMax(_pData, _Count);
+}
+
+inline SMinMax<int32_t> SimdMinMax(const int32_t* _pData, size_t _Count) { BASE_SIMD_DISPATCH(MinMax(_pData, _Count)) }
+inline SMinMax<float>   SimdMinMax(const float* _pData, size_t _Count)   { BASE_SIMD_DISPATCH(MinMax(_pData, _Count)) }
+inline SMinMax<double>  SimdMinMax(const double* _pData, size_t _Count)  { BASE_SIMD_DISPATCH(MinMax(_pData, _Count)) }
+
+template <typename T>
+typename SSimdSum<T>::type SimdSum(const T* _pData, size_t _Count)
+{
+    return SScalarKernels::Sum(_pData, _Count);
+}
+
+inline int64_t SimdSum(const int32_t* _pData, size_t _Count) { BASE_SIMD_DISPATCH(Sum(_pData, _Count)) }
+inline float   SimdSum(const float* _pData, size_t _Count)   { BASE_SIMD_DISPATCH(Sum(_pData, _Count)) }
+inline double  SimdSum(const double* _pData, size_t _Count)  { BASE_SIMD_DISPATCH(Sum(_pData, _Count)) }
+
+template <typename T>
+typename SSimdSum<T>::type SimdDot(const T* _pLhs, const T* _pRhs, size_t _Count)
+{
+    return SScalarKernels::Dot(_pLhs, _pRhs, _Count);
+}
+
+inline int64_t SimdDot(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count) { BASE_SIMD_DISPATCH(Dot(_pLhs, _pRhs, _Count)) }
+inline float   SimdDot(const float* _pLhs, const float* _pRhs, size_t _Count)     { BASE_SIMD_DISPATCH(Dot(_pLhs, _pRhs, _Count)) }
+inline double  SimdDot(const double* _pLhs, const double* _pRhs, size_t _Count)   { BASE_SIMD_DISPATCH(Dot(_pLhs, _pRhs, _Count)) }
+
+template <typename T>
+bool SimdEqual(const T* _pLhs, const T* _pRhs, size_t _Count)
+{
+    return SScalarKernels::Equal(_pLhs, _pRhs, _Count);
+}
+
+inline bool SimdEqual(const int32_t* _pLhs, const int32_t* _pRhs, size_t _Count) { BASE_SIMD_DISPATCH(Equal(_pLhs, _pRhs, _Count)) }
+inline bool SimdEqual(const float* _pLhs, const float* _pRhs, size_t _Count)     { BASE_SIMD_DISPATCH(Equal(_pLhs, _pRhs, _Count)) }
+inline bool SimdEqual(const double* _pLhs, const double* _pRhs, size_t _Count)   { BASE_SIMD_DISPATCH(Equal(_pLhs, _pRhs, _Count)) }
+
+inline size_t SimdPopCount(const uint64_t* _pWords, size_t _Count) { BASE_SIMD_DISPATCH(PopCount(_pWords, _Count)) }
+
+#undef BASE_SIMD_DISPATCH
+
+/*************************************************************************
+ * VECTOR SUBSECTION
+ *************************************************************************/
+
+template <typename T, template <typename> class TAllocator, typename TGrowthPolicy>
+size_t SimdFind(const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rVector, T _Value)
+{
+    return SimdFind(_rVector.GetData(), _rVector.GetCount(), _Value);
+}
+
+template <typename T, template <typename> class TAllocator, typename TGrowthPolicy>
+size_t SimdCount(const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rVector, T _Value)
+{
+    return SimdCount(_rVector.GetData(), _rVector.GetCount(), _Value);
+}
+
+template <typename T, template <typename> class TAllocator, typename TGrowthPolicy>
+SMinMax<T> SimdMinMax(const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rVector)
+{
+    return SimdMinMax(_rVector.GetData(), _rVector.GetCount());
+}
+
+template <typename T, template <typename> class TAllocator, typename TGrowthPolicy>
+typename SSimdSum<T>::type SimdSum(const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rVector)
+{
+    return SimdSum(_rVector.GetData(), _rVector.GetCount());
+}
+
+template <typename T, template <typename> class TAllocator, typename TGrowthPolicy>
+typename SSimdSum<T>::type SimdDot(const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rLhs, const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rRhs)
+{
+    assert(_rLhs.GetCount() == _rRhs.GetCount());
+    return SimdDot(_rLhs.GetData(), _rRhs.GetData(), _rLhs.GetCount());
+}
+
+template <typename T, template <typename> class TAllocator, typename TGrowthPolicy>
+bool SimdEqual(const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rLhs, const BASE::CNT::CVector<T, TAllocator, TGrowthPolicy>& _rRhs)
+{
+    return _rLhs.GetCount() == _rRhs.GetCount() && SimdEqual(_rLhs.GetData(), _rRhs.GetData(), _rLhs.GetCount());
+}
+
+
+    } // namespace ALGO
+} // namespace BASE
+
+#endif // __INCLUDE_SIMD_H_
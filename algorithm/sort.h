@@ -0,0 +1,568 @@
+#ifndef __INCLUDE_SORT_H_
+#define __INCLUDE_SORT_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "parallel.h"
+#include "../container/iterator/iterator.h"
+#include "../container/sequential/vector.h"
+#include "../utility/binary/bits.h"
+
+namespace BASE {
+    namespace ALGO {
+
+
+/**
+ * Sorting of random access ranges (CVector, CStableVector, plain pointers, ...).
+ * Sort is an introsort: quicksort with a median of three pivot, heapsort once
+ * the recursion gets too deep and insertion sort for short partitions. It is
+ * not stable and needs no memory.
+ * RadixSort is a stable LSD radix sort over integer or floating point keys,
+ * either the elements themselves or a key taken from every element:
+ *     RadixSort(Vector.Begin(), Vector.End(), [](const SRecord& _rRecord) { return _rRecord.m_Id; });
+ * It needs a buffer as large as the range and skips the byte passes in which
+ * all keys agree. Floating point keys are ordered by their bits, -0 comes
+ * before +0 and NaNs sort to the ends.
+ * ParallelSort sorts chunks of _GrainSize elements on a CThreadPool and merges
+ * them in rounds, every merge split into pieces so all threads stay busy
+ * until the end. It needs a buffer as large as the range and is not stable.
+ **/
+struct SLess
+{
+    template <typename T>
+    bool operator()(const T& _rLhs, const T& _rRhs) const { return _rLhs < _rRhs; }
+};
+
+struct SIdentity
+{
+    template <typename T>
+    const T& operator()(const T& _rValue) const { return _rValue; }
+};
+
+template <typename TIterator, typename TLess = SLess>
+void Sort(TIterator _First, TIterator _Last, TLess _Less = TLess());
+
+template <typename TIterator, typename TKey = SIdentity>
+void RadixSort(TIterator _First, TIterator _Last, TKey _Key = TKey());
+
+template <typename TIterator, typename TLess = SLess>
+void ParallelSort(TIterator _First, TIterator _Last, TLess _Less = TLess(),
+    size_t _GrainSize = s_DefaultGrainSize, BASE::UTIL::CThreadPool& _rPool = BASE::UTIL::CThreadPool::GetDefault());
+
+/*************************************************************************
+ * HELPER SUBSECTION
+ *************************************************************************/
+
+static const ptrdiff_t s_InsertionSortCutoff = 16;                      // partitions up to this size are insertion sorted
+static const ptrdiff_t s_RadixSortCutoff     = 64;                      // shorter ranges are not worth the histograms
+
+template <typename TIterator>
+struct SIteratorValue
+{
+    typedef typename std::remove_cv<typename std::remove_reference<decltype(*std::declval<TIterator&>())>::type>::type type;
+};
+
+template <typename TIterator>
+struct SIsRandomAccessIterator
+{
+    enum { Result = std::is_base_of<BASE::CNT::SRandomAccessIteratorTag, typename BASE::CNT::SIteratorTraits<TIterator>::iterator_tag_type>::value };
+};
+
+template <typename TIterator, typename TLess>
+void InsertionSort(TIterator _First, TIterator _Last, TLess& _rLess)
+{
+    typedef typename SIteratorValue<TIterator>::type value_type;
+
+    if (_First == _Last)
+    {
+        return;
+    }
+
+    TIterator It = _First;
+    for (++It; It != _Last; ++It)
+    {
+        value_type Value = std::move(*It);
+        TIterator  Hole  = It;
+
+        for (TIterator Previous = Hole; Hole != _First; Hole = Previous)
+        {
+            --Previous;
+            if (!_rLess(Value, *Previous))
+            {
+                break;
+            }
+            *Hole = std::move(*Previous);
+        }
+
+        *Hole = std::move(Value);
+    }
+}
+
+template <typename TIterator, typename TLess>
+void SiftDown(TIterator _First, ptrdiff_t _Root, ptrdiff_t _Count, TLess& _rLess)
+{
+    typedef typename SIteratorValue<TIterator>::type value_type;
+
+    value_type Value = std::move(*(_First + _Root));
+
+    for (ptrdiff_t Child = 2 * _Root + 1; Child < _Count; Child = 2 * _Root + 1)
+    {
+        if (Child + 1 < _Count && _rLess(*(_First + Child), *(_First + (Child + 1))))
+        {
+            ++Child;
+        }
+
+        if (!_rLess(Value, *(_First + Child)))
+        {
+            break;
+        }
+
+        *(_First + _Root) = std::move(*(_First + Child));
+        _Root = Child;
+    }
+
+    *(_First + _Root) = std::move(Value);
+}
+
+template <typename TIterator, typename TLess>
+void HeapSort(TIterator _First, TIterator _Last, TLess& _rLess)
+{
+    using std::swap;
+
+    ptrdiff_t Count = _Last - _First;
+
+    for (ptrdiff_t Root = Count / 2; Root-- > 0; )
+    {
+        SiftDown(_First, Root, Count, _rLess);
+    }
+
+    for (ptrdiff_t End = Count - 1; End > 0; --End)
+    {
+        swap(*_First, *(_First + End));
+        SiftDown(_First, 0, End, _rLess);
+    }
+}
+
+template <typename TIterator, typename TLess>
+void MoveMedianToFirst(TIterator _Result, TIterator _A, TIterator _B, TIterator _C, TLess& _rLess)
+{
+    using std::swap;
+
+    if (_rLess(*_A, *_B))
+    {
+        if      (_rLess(*_B, *_C)) swap(*_Result, *_B);
+        else if (_rLess(*_A, *_C)) swap(*_Result, *_C);
+        else                       swap(*_Result, *_A);
+    }
+    else
+    {
+        if      (_rLess(*_A, *_C)) swap(*_Result, *_A);
+        else if (_rLess(*_B, *_C)) swap(*_Result, *_C);
+        else                       swap(*_Result, *_B);
+    }
+}
+
+template <typename TIterator, typename TLess>
+TIterator Partition(TIterator _First, TIterator _Last, TLess& _rLess)
+{
+    using std::swap;
+
+    ptrdiff_t Count = _Last - _First;
+    MoveMedianToFirst(_First, _First + 1, _First + Count / 2, _Last - 1, _rLess);
+
+    // the pivot sits in *_First, the median of three keeps both scans inside the range
+    TIterator Left  = _First + 1;
+    TIterator Right = _Last;
+
+    for (;;)
+    {
+        while (_rLess(*Left, *_First))
+        {
+            ++Left;
+        }
+
+        --Right;
+        while (_rLess(*_First, *Right))
+        {
+            --Right;
+        }
+
+        if (Right - Left <= 0)
+        {
+            return Left;
+        }
+
+        swap(*Left, *Right);
+        ++Left;
+    }
+}
+
+template <typename TIterator, typename TLess>
+void IntroSort(TIterator _First, TIterator _Last, size_t _DepthLimit, TLess& _rLess)
+{
+    while (_Last - _First > s_InsertionSortCutoff)
+    {
+        if (_DepthLimit == 0)
+        {
+            HeapSort(_First, _Last, _rLess);
+            return;
+        }
+        --_DepthLimit;
+
+        // recurse into the smaller part, so the stack stays logarithmic
+        TIterator Cut = Partition(_First, _Last, _rLess);
+        if (Cut - _First < _Last - Cut)
+        {
+            IntroSort(_First, Cut, _DepthLimit, _rLess);
+            _First = Cut;
+        }
+        else
+        {
+            IntroSort(Cut, _Last, _DepthLimit, _rLess);
+            _Last = Cut;
+        }
+    }
+
+    InsertionSort(_First, _Last, _rLess);
+}
+
+template <typename TIterator, typename TValue, typename TLess>
+ptrdiff_t LowerBound(TIterator _First, ptrdiff_t _Count, const TValue& _rValue, TLess& _rLess)
+{
+    ptrdiff_t Begin = 0;
+
+    while (_Count > 0)
+    {
+        ptrdiff_t Half = _Count / 2;
+        if (_rLess(*(_First + (Begin + Half)), _rValue))
+        {
+            Begin  += Half + 1;
+            _Count -= Half + 1;
+        }
+        else
+        {
+            _Count = Half;
+        }
+    }
+
+    return Begin;
+}
+
+template <typename TInIterator, typename TOutIterator, typename TLess>
+void Merge(TInIterator _Left, TInIterator _LeftEnd, TInIterator _Right, TInIterator _RightEnd, TOutIterator _Out, TLess& _rLess)
+{
+    for (; _Left != _LeftEnd && _Right != _RightEnd; ++_Out)
+    {
+        if (_rLess(*_Right, *_Left))
+        {
+            *_Out = std::move(*_Right);
+            ++_Right;
+        }
+        else
+        {
+            *_Out = std::move(*_Left);
+            ++_Left;
+        }
+    }
+
+    for (; _Left != _LeftEnd; ++_Left, ++_Out)
+    {
+        *_Out = std::move(*_Left);
+    }
+
+    for (; _Right != _RightEnd; ++_Right, ++_Out)
+    {
+        *_Out = std::move(*_Right);
+    }
+}
+
+template <typename TInIterator, typename TOutIterator, typename TLess>
+void MergeRound(TInIterator _Source, TOutIterator _Target, ptrdiff_t _Count, ptrdiff_t _Width, ptrdiff_t _GrainSize, TLess& _rLess, BASE::UTIL::CThreadPool& _rPool)
+{
+    // every pair of runs is cut into pieces at fixed points of the left run,
+    // the matching point of the right run is found by binary search
+    ptrdiff_t PairCount  = (_Count + 2 * _Width - 1) / (2 * _Width);
+    ptrdiff_t PieceCount = (_Width + _GrainSize - 1) / _GrainSize;
+
+    _rPool.Run(static_cast<size_t>(PairCount * PieceCount), [&](size_t _Task)
+    {
+        ptrdiff_t Pair  = static_cast<ptrdiff_t>(_Task) / PieceCount;
+        ptrdiff_t Piece = static_cast<ptrdiff_t>(_Task) % PieceCount;
+
+        ptrdiff_t Begin  = Pair * 2 * _Width;
+        ptrdiff_t Middle = (Begin + _Width < _Count) ? Begin + _Width : _Count;
+        ptrdiff_t End    = (Middle + _Width < _Count) ? Middle + _Width : _Count;
+
+        ptrdiff_t LeftBegin = Begin + Piece * _GrainSize;
+        ptrdiff_t LeftEnd   = (LeftBegin + _GrainSize < Middle) ? LeftBegin + _GrainSize : Middle;
+
+        if (LeftBegin >= Middle)
+        {
+            if (Piece == 0)
+            {
+                Merge(_Source + Begin, _Source + Begin, _Source + Middle, _Source + End, _Target + Begin, _rLess);
+            }
+            return;
+        }
+
+        ptrdiff_t RightBegin = (Piece == 0) ? Middle : Middle + LowerBound(_Source + Middle, End - Middle, *(_Source + LeftBegin), _rLess);
+        ptrdiff_t RightEnd   = (LeftEnd == Middle) ? End : Middle + LowerBound(_Source + Middle, End - Middle, *(_Source + LeftEnd), _rLess);
+
+        Merge(_Source + LeftBegin, _Source + LeftEnd, _Source + RightBegin, _Source + RightEnd,
+            _Target + (LeftBegin + (RightBegin - Middle)), _rLess);
+    });
+}
+
+/**
+ * Maps a key to an unsigned integer with the same order.
+ **/
+template <typename T, bool Integral = std::is_integral<T>::value, bool Signed = std::is_signed<T>::value>
+struct SRadixKey;
+
+template <typename T>
+struct SRadixKey<T, true, false>
+{
+    typedef T type;
+
+    static type Get(T _Key) { return _Key; }
+};
+
+template <typename T>
+struct SRadixKey<T, true, true>
+{
+    typedef typename std::make_unsigned<T>::type type;
+
+    static type Get(T _Key) { return static_cast<type>(_Key) ^ (type(1) << (sizeof(type) * 8 - 1)); }
+};
+
+template <typename T, typename TBits>
+struct SRadixFloatKey
+{
+    typedef TBits type;
+
+    static type Get(T _Key)
+    {
+        static const type s_SignBit = type(1) << (sizeof(type) * 8 - 1);
+
+        type Bits;
+        memcpy(&Bits, &_Key, sizeof(Bits));
+
+        // negative values count down, so all their bits flip
+        return (Bits & s_SignBit) ? ~Bits : (Bits | s_SignBit);
+    }
+};
+
+template <>
+struct SRadixKey<float, false, true> : public SRadixFloatKey<float, uint32_t>
+{
+};
+
+template <>
+struct SRadixKey<double, false, true> : public SRadixFloatKey<double, uint64_t>
+{
+};
+
+template <typename TValue, typename TKey>
+struct SRadixLess
+{
+    typedef typename std::decay<decltype(std::declval<TKey&>()(std::declval<const TValue&>()))>::type key_type;
+    typedef SRadixKey<key_type>                                                                      radix_key_type;
+
+    explicit SRadixLess(TKey& _rKey) : m_rKey(_rKey) {}
+
+    bool operator()(const TValue& _rLhs, const TValue& _rRhs) const
+    {
+        return radix_key_type::Get(m_rKey(_rLhs)) < radix_key_type::Get(m_rKey(_rRhs));
+    }
+
+    TKey& m_rKey;
+};
+
+template <typename TInIterator, typename TOutIterator, typename TKey>
+void RadixScatter(TInIterator _First, TInIterator _Last, TOutIterator _Out, size_t* _pOffsets, size_t _Shift, TKey& _rKey)
+{
+    typedef typename SIteratorValue<TInIterator>::type value_type;
+    typedef typename SRadixLess<value_type, TKey>::radix_key_type radix_key_type;
+
+    for (; _First != _Last; ++_First)
+    {
+        size_t Bucket = static_cast<size_t>(radix_key_type::Get(_rKey(*_First)) >> _Shift) & 0xFF;
+        *(_Out + _pOffsets[Bucket]++) = std::move(*_First);
+    }
+}
+
+/*************************************************************************
+ * ALGORITHM SUBSECTION
+ *************************************************************************/
+
+template <typename TIterator, typename TLess>
+void Sort(TIterator _First, TIterator _Last, TLess _Less)
+{
+    static_assert(SIsRandomAccessIterator<TIterator>::Result, "sorting needs random access iterators");
+
+    ptrdiff_t Count = _Last - _First;
+
+    if (Count > 1)
+    {
+        IntroSort(_First, _Last, 2 * BASE::UTIL::GetHighestBit(static_cast<size_t>(Count)), _Less);
+    }
+}
+
+template <typename TIterator, typename TKey>
+void RadixSort(TIterator _First, TIterator _Last, TKey _Key)
+{
+    static_assert(SIsRandomAccessIterator<TIterator>::Result, "sorting needs random access iterators");
+
+    typedef typename SIteratorValue<TIterator>::type    value_type;
+    typedef SRadixLess<value_type, TKey>        less_type;
+    typedef typename less_type::radix_key_type        radix_key_type;
+    typedef typename radix_key_type::type             bits_type;
+
+    static const size_t s_ByteCount = sizeof(bits_type);
+
+    ptrdiff_t Count = _Last - _First;
+
+    if (Count < s_RadixSortCutoff)
+    {
+        less_type Less(_Key);
+        InsertionSort(_First, _Last, Less);
+        return;
+    }
+
+    // one pass for the histograms of all bytes, the elements move into the buffer meanwhile
+    size_t Offsets[s_ByteCount][256];
+    memset(Offsets, 0, sizeof(Offsets));
+
+    BASE::CNT::CVector<value_type> Buffer(Count);
+    for (TIterator It = _First; It != _Last; ++It)
+    {
+        bits_type Bits = radix_key_type::Get(_Key(*It));
+        for (size_t Byte = 0; Byte < s_ByteCount; ++Byte)
+        {
+            ++Offsets[Byte][(Bits >> (Byte * 8)) & 0xFF];
+        }
+
+        Buffer.PushBack(std::move(*It));
+    }
+
+    bool InBuffer = true;
+
+    for (size_t Byte = 0; Byte < s_ByteCount; ++Byte)
+    {
+        size_t* pOffsets = Offsets[Byte];
+
+        // all keys share this byte, the pass would not change anything
+        bool Skip  = false;
+        size_t Sum = 0;
+        for (size_t Bucket = 0; Bucket < 256; ++Bucket)
+        {
+            size_t BucketCount = pOffsets[Bucket];
+            Skip = Skip || (BucketCount == static_cast<size_t>(Count));
+            pOffsets[Bucket] = Sum;
+            Sum += BucketCount;
+        }
+
+        if (Skip)
+        {
+            continue;
+        }
+
+        if (InBuffer)
+        {
+            RadixScatter(Buffer.GetData(), Buffer.GetData() + Count, _First, pOffsets, Byte * 8, _Key);
+        }
+        else
+        {
+            RadixScatter(_First, _Last, Buffer.GetData(), pOffsets, Byte * 8, _Key);
+        }
+        InBuffer = !InBuffer;
+    }
+
+    if (InBuffer)
+    {
+        value_type* pSource = Buffer.GetData();
+        for (TIterator It = _First; It != _Last; ++It, ++pSource)
+        {
+            *It = std::move(*pSource);
+        }
+    }
+}
+
+template <typename TIterator, typename TLess>
+void ParallelSort(TIterator _First, TIterator _Last, TLess _Less, size_t _GrainSize, BASE::UTIL::CThreadPool& _rPool)
+{
+    static_assert(SIsRandomAccessIterator<TIterator>::Result, "sorting needs random access iterators");
+
+    typedef typename SIteratorValue<TIterator>::type value_type;
+
+    SChunks Chunks(_Last - _First, _GrainSize);
+
+    if (Chunks.m_ChunkCount <= 1)
+    {
+        Sort(_First, _Last, _Less);
+        return;
+    }
+
+    ptrdiff_t Count     = static_cast<ptrdiff_t>(Chunks.m_Count);
+    ptrdiff_t GrainSize = static_cast<ptrdiff_t>(Chunks.m_GrainSize);
+
+    _rPool.Run(Chunks.m_ChunkCount, [&](size_t _Chunk)
+    {
+        Sort(_First + Chunks.GetBegin(_Chunk), _First + Chunks.GetEnd(_Chunk), _Less);
+    });
+
+    BASE::CNT::CVector<value_type> Buffer(Count);
+    for (TIterator It = _First; It != _Last; ++It)
+    {
+        Buffer.PushBack(std::move(*It));
+    }
+
+    // the runs double every round, the data moves between buffer and range
+    bool InBuffer = true;
+
+    for (ptrdiff_t Width = GrainSize; Width < Count; Width *= 2)
+    {
+        if (InBuffer)
+        {
+            MergeRound(Buffer.GetData(), _First, Count, Width, GrainSize, _Less, _rPool);
+        }
+        else
+        {
+            MergeRound(_First, Buffer.GetData(), Count, Width, GrainSize, _Less, _rPool);
+        }
+        InBuffer = !InBuffer;
+    }
+
+    if (InBuffer)
+    {
+        _rPool.Run(Chunks.m_ChunkCount, [&](size_t _Chunk)
+        {
+            value_type* pSource = Buffer.GetData() + Chunks.GetBegin(_Chunk);
+            TIterator   End     = _First + Chunks.GetEnd(_Chunk);
+
+            for (TIterator It = _First + Chunks.GetBegin(_Chunk); It != End; ++It, ++pSource)
+            {
+                *It = std::move(*pSource);
+            }
+        });
+    }
+}
+
+
+    } // namespace ALGO
+} // namespace BASE
+
+#endif // __INCLUDE_SORT_H_
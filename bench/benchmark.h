@@ -0,0 +1,62 @@
+#ifndef __INCLUDE_BENCHMARK_H_
+#define __INCLUDE_BENCHMARK_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+namespace BENCH {
+
+
+/**
+ * Small helpers shared by the benchmark drivers.
+ **/
+inline double
+GetSeconds()                                                            // monotonic, arbitrary origin
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+inline void
+KeepAlive(const T& _rValue)                                             // stops the compiler from dropping a result
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "r"(&_rValue) : "memory");
+#else
+    static volatile char s_Sink;
+    s_Sink = *reinterpret_cast<const volatile char*>(&_rValue);
+#endif
+}
+
+inline void
+Check(bool _Condition, const char* _pMessage)                           // stays active with NDEBUG
+{
+    if (!_Condition)
+    {
+        fprintf(stderr, "FAILED: %s\n", _pMessage);
+        exit(1);
+    }
+}
+
+inline size_t
+GetArgument(int _ArgCount, char** _ppArgs, int _Index, size_t _Default)
+{
+    return _Index < _ArgCount ? static_cast<size_t>(strtoull(_ppArgs[_Index], 0, 10)) : _Default;
+}
+
+
+} // namespace BENCH
+
+
+#endif // __INCLUDE_BENCHMARK_H_
@@ -0,0 +1,293 @@
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+/**
+ * Stress test and throughput of CConcurrentNodePool with producers that
+ * allocate and one consumer that frees, the pattern the pool is made for.
+ *     g++ -std=c++11 -O2 -pthread -I.. concurrentpool.cpp -o concurrentpool
+ *     ./concurrentpool [max producers = 4] [blocks per producer = 1000000]
+ * The stress part tracks every block handed out: none may be live twice,
+ * and after all threads called Flush() every one of them has to come back
+ * out of the pool before it carves fresh memory. The throughput part
+ * reports allocations plus frees per second for 1 to max producers,
+ * next to ::operator new/delete doing the same work.
+ **/
+
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "benchmark.h"
+#include "../memory/concurrentpoolallocator.h"
+
+using BASE::MEM::CConcurrentNodePool;
+
+static const size_t s_BlockSize = 48;
+static const size_t s_HandOff   = 1024;                                 // blocks a producer passes on at once
+
+/*************************************************************************
+ * HAND-OFF SUBSECTION
+ *************************************************************************/
+
+class CHandOff                                                          // many producers, one consumer
+{
+public:
+
+    explicit CHandOff(size_t _ProducerCount)
+        : m_ProducersLeft(_ProducerCount)
+    {
+    }
+
+    void Push(std::vector<void*>& _rBlocks)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_Blocks.insert(m_Blocks.end(), _rBlocks.begin(), _rBlocks.end());
+        _rBlocks.clear();
+    }
+
+    void Finish()
+    {
+        m_ProducersLeft.fetch_sub(1);
+    }
+
+    bool Pop(std::vector<void*>& _rBlocks)                              // false once all producers finished and nothing is left
+    {
+        bool IsFinished = m_ProducersLeft.load() == 0;
+
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        _rBlocks.swap(m_Blocks);
+        return !IsFinished || !_rBlocks.empty();
+    }
+
+private:
+
+    std::mutex          m_Mutex;
+    std::vector<void*>  m_Blocks;
+    std::atomic<size_t> m_ProducersLeft;
+};
+
+/*************************************************************************
+ * STRESS SUBSECTION
+ *************************************************************************/
+
+struct SLedger                                                          // every block a producer received
+{
+    std::mutex                m_Mutex;
+    std::unordered_set<void*> m_Live;
+    std::unordered_set<void*> m_Seen;
+};
+
+static void
+Stamp(void* _pBlock)
+{
+    uintptr_t Value = reinterpret_cast<uintptr_t>(_pBlock) ^ 0x5A5A5A5A;
+    memcpy(static_cast<char*>(_pBlock) + s_BlockSize - sizeof(Value), &Value, sizeof(Value));
+}
+
+static bool
+IsStamped(void* _pBlock)
+{
+    uintptr_t Value = 0;
+    memcpy(&Value, static_cast<char*>(_pBlock) + s_BlockSize - sizeof(Value), sizeof(Value));
+    return Value == (reinterpret_cast<uintptr_t>(_pBlock) ^ 0x5A5A5A5A);
+}
+
+static void
+RunStress(size_t _ProducerCount, size_t _BlockCount)
+{
+    CConcurrentNodePool Pool;
+    CHandOff            HandOff(_ProducerCount);
+    SLedger             Ledger;
+
+    std::vector<std::thread> Threads;
+
+    for (size_t Producer = 0; Producer < _ProducerCount; ++Producer)
+    {
+        Threads.push_back(std::thread([&]()
+        {
+            std::vector<void*> Blocks;
+
+            for (size_t Block = 0; Block < _BlockCount; ++Block)
+            {
+                void* pBlock = Pool.Allocate(s_BlockSize);
+                {
+                    std::lock_guard<std::mutex> Lock(Ledger.m_Mutex);
+                    BENCH::Check(Ledger.m_Live.insert(pBlock).second, "block handed out twice");
+                    Ledger.m_Seen.insert(pBlock);
+                }
+                Stamp(pBlock);
+
+                Blocks.push_back(pBlock);
+                if (Blocks.size() == s_HandOff || (Block & 7) == 0)
+                { // small hand-offs now and then, so batches get mixed between threads
+                    HandOff.Push(Blocks);
+                }
+            }
+
+            HandOff.Push(Blocks);
+            Pool.Flush();
+            HandOff.Finish();
+        }));
+    }
+
+    Threads.push_back(std::thread([&]()
+    {
+        std::vector<void*> Blocks;
+
+        while (HandOff.Pop(Blocks))
+        {
+            for (size_t Index = 0; Index < Blocks.size(); ++Index)
+            {
+                BENCH::Check(IsStamped(Blocks[Index]), "block overwritten while in use");
+                {
+                    std::lock_guard<std::mutex> Lock(Ledger.m_Mutex);
+                    BENCH::Check(Ledger.m_Live.erase(Blocks[Index]) == 1, "block freed that was not live");
+                }
+                Pool.Deallocate(Blocks[Index], s_BlockSize);
+            }
+            Blocks.clear();
+            std::this_thread::yield();
+        }
+
+        Pool.Flush();
+    }));
+
+    for (size_t Thread = 0; Thread < Threads.size(); ++Thread)
+    {
+        Threads[Thread].join();
+    }
+
+    BENCH::Check(Ledger.m_Live.empty(), "blocks still live after the run");
+
+    // all blocks are back on the stacks, the pool only carves new ones after
+    // every one of them was handed out again; at most the rest of a partial
+    // batch per thread was never seen by the producers
+    size_t Limit = Ledger.m_Seen.size() + (_ProducerCount + 2) * 2 * (CConcurrentNodePool::s_BatchBytes / CConcurrentNodePool::s_Granularity);
+    size_t Found = 0;
+
+    std::unordered_set<void*> Drained;
+    while (Found < Ledger.m_Seen.size() && Drained.size() < Limit)
+    {
+        void* pBlock = Pool.Allocate(s_BlockSize);
+        BENCH::Check(Drained.insert(pBlock).second, "block handed out twice while draining");
+        Found += Ledger.m_Seen.count(pBlock);
+    }
+
+    BENCH::Check(Found == Ledger.m_Seen.size(), "blocks lost after Flush()");
+
+    for (std::unordered_set<void*>::const_iterator It = Drained.begin(); It != Drained.end(); ++It)
+    {
+        Pool.Deallocate(*It, s_BlockSize);
+    }
+    Pool.Flush();
+
+    printf("stress %zu producer(s): %zu distinct blocks, all returned\n", _ProducerCount, Ledger.m_Seen.size());
+}
+
+/*************************************************************************
+ * THROUGHPUT SUBSECTION
+ *************************************************************************/
+
+struct SPoolHeap
+{
+    CConcurrentNodePool m_Pool;
+
+    void* Allocate()              { return m_Pool.Allocate(s_BlockSize); }
+    void  Deallocate(void* _pMem) { m_Pool.Deallocate(_pMem, s_BlockSize); }
+    void  Flush()                 { m_Pool.Flush(); }
+};
+
+struct SGlobalHeap
+{
+    void* Allocate()              { return ::operator new(s_BlockSize); }
+    void  Deallocate(void* _pMem) { ::operator delete(_pMem); }
+    void  Flush()                 { }
+};
+
+template <typename THeap>
+static double
+RunThroughput(size_t _ProducerCount, size_t _BlockCount)                // returns operations per second
+{
+    THeap    Heap;
+    CHandOff HandOff(_ProducerCount);
+
+    std::vector<std::thread> Threads;
+    double Start = BENCH::GetSeconds();
+
+    for (size_t Producer = 0; Producer < _ProducerCount; ++Producer)
+    {
+        Threads.push_back(std::thread([&]()
+        {
+            std::vector<void*> Blocks;
+            Blocks.reserve(s_HandOff);
+
+            for (size_t Block = 0; Block < _BlockCount; ++Block)
+            {
+                Blocks.push_back(Heap.Allocate());
+                if (Blocks.size() == s_HandOff)
+                {
+                    HandOff.Push(Blocks);
+                }
+            }
+
+            HandOff.Push(Blocks);
+            Heap.Flush();
+            HandOff.Finish();
+        }));
+    }
+
+    Threads.push_back(std::thread([&]()
+    {
+        std::vector<void*> Blocks;
+
+        while (HandOff.Pop(Blocks))
+        {
+            for (size_t Index = 0; Index < Blocks.size(); ++Index)
+            {
+                Heap.Deallocate(Blocks[Index]);
+            }
+            Blocks.clear();
+        }
+
+        Heap.Flush();
+    }));
+
+    for (size_t Thread = 0; Thread < Threads.size(); ++Thread)
+    {
+        Threads[Thread].join();
+    }
+
+    return 2.0 * _ProducerCount * _BlockCount / (BENCH::GetSeconds() - Start);
+}
+
+int
+main(int _ArgCount, char** _ppArgs)
+{
+    size_t MaxProducers = BENCH::GetArgument(_ArgCount, _ppArgs, 1, 4);
+    size_t BlockCount   = BENCH::GetArgument(_ArgCount, _ppArgs, 2, 1000000);
+
+    for (size_t Producers = 1; Producers <= MaxProducers; ++Producers)
+    {
+        RunStress(Producers, BlockCount / 4);
+    }
+
+    printf("\n%-10s %14s %18s\n", "producers", "pool Mops/s", "new/delete Mops/s");
+    for (size_t Producers = 1; Producers <= MaxProducers; ++Producers)
+    {
+        double Pool   = RunThroughput<SPoolHeap>(Producers, BlockCount);
+        double Global = RunThroughput<SGlobalHeap>(Producers, BlockCount);
+        printf("%-10zu %14.1f %18.1f\n", Producers, Pool / 1e6, Global / 1e6);
+    }
+
+    return 0;
+}
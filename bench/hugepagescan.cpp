@@ -0,0 +1,130 @@
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+/**
+ * TLB cost of scans over a big CVector, regular against huge pages.
+ *     g++ -std=c++11 -O2 -DNDEBUG -pthread -I.. hugepagescan.cpp -o hugepagescan
+ *     ./hugepagescan [MiB = 512] [random steps = 20000000]
+ * The same data lives in a CVector on CHugePageAllocator in every mode.
+ * The sequential pass sums all elements, prefetching hides most page
+ * walks there. The random pass follows a single cycle through the whole
+ * array, every step lands on another page, so nearly every step misses
+ * the TLB with 4 KiB pages and far fewer do with 2 MiB pages. On Linux
+ * the AnonHugePages column shows how much of the process really got huge
+ * pages; explicit mode needs pages reserved in /proc/sys/vm/nr_hugepages.
+ **/
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "benchmark.h"
+#include "../container/sequential/vector.h"
+#include "../memory/hugepageallocator.h"
+
+using BASE::MEM::CHugePageAllocator;
+using BASE::MEM::EHugePageMode;
+
+typedef BASE::CNT::CVector<uint64_t, CHugePageAllocator> vector_type;
+
+static size_t
+GetAnonHugeBytes()                                                      // 0 where /proc is not available
+{
+    FILE* pFile = fopen("/proc/self/smaps_rollup", "r");
+    if (pFile == 0)
+    {
+        return 0;
+    }
+
+    char   Line[256];
+    size_t KiB = 0;
+    while (fgets(Line, sizeof(Line), pFile) != 0)
+    {
+        unsigned long Value = 0;
+        if (sscanf(Line, "AnonHugePages: %lu kB", &Value) == 1)
+        {
+            KiB = Value;
+        }
+    }
+    fclose(pFile);
+
+    return KiB * 1024;
+}
+
+static void
+Run(const char* _pName, EHugePageMode _Mode, const std::vector<uint64_t>& _rCycle, size_t _StepCount)
+{
+    size_t BaseHuge = GetAnonHugeBytes();
+
+    vector_type Data((CHugePageAllocator<uint64_t>(_Mode)));
+    Data.Resize(_rCycle.size());
+    memcpy(Data.GetData(), &_rCycle[0], _rCycle.size() * sizeof(uint64_t));
+
+    size_t Huge = GetAnonHugeBytes() - BaseHuge;
+
+    const uint64_t* pData = Data.GetData();
+    size_t          Count = Data.GetCount();
+
+    double   Start = BENCH::GetSeconds();
+    uint64_t Sum   = 0;
+    for (size_t Index = 0; Index < Count; ++Index)
+    {
+        Sum += pData[Index];
+    }
+    double Sequential = BENCH::GetSeconds() - Start;
+    BENCH::KeepAlive(Sum);
+
+    Start = BENCH::GetSeconds();
+    uint64_t Position = 0;
+    for (size_t Step = 0; Step < _StepCount; ++Step)
+    {
+        Position = pData[Position];
+    }
+    double Random = BENCH::GetSeconds() - Start;
+    BENCH::KeepAlive(Position);
+
+    printf("%-12s %14.2f %16.1f %18.1f\n", _pName, Count * sizeof(uint64_t) / Sequential / 1e9, Random / _StepCount * 1e9, Huge / 1048576.0);
+}
+
+int
+main(int _ArgCount, char** _ppArgs)
+{
+    size_t MiB       = BENCH::GetArgument(_ArgCount, _ppArgs, 1, 512);
+    size_t StepCount = BENCH::GetArgument(_ArgCount, _ppArgs, 2, 20000000);
+    size_t Count     = MiB * 1024 * 1024 / sizeof(uint64_t);
+
+    // one cycle through all elements (Sattolo), a chase visits every one of them
+    std::vector<uint64_t> Cycle(Count);
+    for (size_t Index = 0; Index < Count; ++Index)
+    {
+        Cycle[Index] = Index;
+    }
+
+    uint64_t Random = 88172645463325252ull;
+    for (size_t Index = Count - 1; Index > 0; --Index)
+    {
+        Random ^= Random << 13;
+        Random ^= Random >> 7;
+        Random ^= Random << 17;
+
+        size_t Other  = static_cast<size_t>(Random % Index);
+        uint64_t Swap = Cycle[Index];
+        Cycle[Index]  = Cycle[Other];
+        Cycle[Other]  = Swap;
+    }
+
+    printf("%zu MiB, %zu random steps\n", MiB, StepCount);
+    printf("%-12s %14s %16s %18s\n", "pages", "seq. GB/s", "random ns/step", "AnonHugePages MiB");
+
+    Run("4 KiB", BASE::MEM::HugePagesOff, Cycle, StepCount);
+    Run("transparent", BASE::MEM::HugePagesTransparent, Cycle, StepCount);
+    Run("explicit", BASE::MEM::HugePagesExplicit, Cycle, StepCount);
+
+    return 0;
+}
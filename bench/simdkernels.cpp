@@ -0,0 +1,243 @@
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+/**
+ * Throughput of the SIMD kernels against the plain loop a caller would write.
+ *     g++ -std=c++11 -O2 -DNDEBUG -pthread -I.. simdkernels.cpp -o simdkernels
+ *     ./simdkernels [elements = 4096,262144,16777216]
+ * Every operation runs over int32_t, float and double arrays of each size
+ * (the defaults fit L1, L2 and main memory) and reports GB/s read. Find
+ * searches a value that is not there, Equal compares two equal arrays. The
+ * loop column is whatever the compiler makes of a plain loop with the given
+ * flags; with -O3 -march=native it may vectorize the integer loops itself,
+ * which is a fair baseline. Kernels the CPU cannot run show a dash.
+ **/
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "../algorithm/simd.h"
+
+using namespace BASE::ALGO;
+
+static const double s_BytesPerRun = 1e9;                                // data read per measurement
+
+template <typename TFunction>
+static double
+Measure(TFunction _Function, size_t _Bytes)                             // GB/s
+{
+    size_t Repeats = static_cast<size_t>(s_BytesPerRun / _Bytes) + 1;
+
+    _Function();                                                        // warm caches and page tables
+
+    double Start = BENCH::GetSeconds();
+    for (size_t Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        BENCH::KeepAlive(_Function());
+    }
+    return static_cast<double>(_Bytes) * Repeats / (BENCH::GetSeconds() - Start) / 1e9;
+}
+
+static void
+PrintRate(double _Rate)                                                 // 0 for kernels the CPU cannot run
+{
+    if (_Rate > 0.0)
+    {
+        printf(" %10.2f", _Rate);
+    }
+    else
+    {
+        printf(" %10s", "-");
+    }
+}
+
+template <typename TLoop, typename TSse2, typename TAvx2, typename TAvx512>
+static void
+Report(const char* _pOperation, size_t _Bytes, TLoop _Loop, TSse2 _Sse2, TAvx2 _Avx2, TAvx512 _Avx512)
+{
+    ESimdLevel Level = GetSimdLevel();
+
+    double Loop   = Measure(_Loop, _Bytes);
+    double Sse2   = Level >= SimdSse2 ? Measure(_Sse2, _Bytes) : 0.0;
+    double Avx2   = Level >= SimdAvx2 ? Measure(_Avx2, _Bytes) : 0.0;
+    double Avx512 = Level >= SimdAvx512 ? Measure(_Avx512, _Bytes) : 0.0;
+    double Best   = Avx2 > Sse2 ? Avx2 : Sse2;
+    Best = Avx512 > Best ? Avx512 : Best;
+
+    printf("  %-8s", _pOperation);
+    PrintRate(Loop);
+    PrintRate(Sse2);
+    PrintRate(Avx2);
+    PrintRate(Avx512);
+    PrintRate(Best / Loop);
+    printf("\n");
+}
+
+/*************************************************************************
+ * PLAIN LOOP SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+struct SPlainLoops
+{
+    typedef typename SSimdSum<T>::type sum_type;
+
+    static size_t Find(const T* _pData, size_t _Count, T _Value)
+    {
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            if (_pData[Index] == _Value)
+            {
+                return Index;
+            }
+        }
+        return _Count;
+    }
+
+    static size_t Count(const T* _pData, size_t _Count, T _Value)
+    {
+        size_t Matches = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Matches += _pData[Index] == _Value;
+        }
+        return Matches;
+    }
+
+    static SMinMax<T> MinMax(const T* _pData, size_t _Count)
+    {
+        SMinMax<T> Result = { _pData[0], _pData[0] };
+        for (size_t Index = 1; Index < _Count; ++Index)
+        {
+            Result.m_Min = _pData[Index] < Result.m_Min ? _pData[Index] : Result.m_Min;
+            Result.m_Max = Result.m_Max < _pData[Index] ? _pData[Index] : Result.m_Max;
+        }
+        return Result;
+    }
+
+    static sum_type Sum(const T* _pData, size_t _Count)
+    {
+        sum_type Result = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Result += _pData[Index];
+        }
+        return Result;
+    }
+
+    static sum_type Dot(const T* _pLhs, const T* _pRhs, size_t _Count)
+    {
+        sum_type Result = 0;
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            Result += static_cast<sum_type>(_pLhs[Index]) * _pRhs[Index];
+        }
+        return Result;
+    }
+
+    static bool Equal(const T* _pLhs, const T* _pRhs, size_t _Count)
+    {
+        for (size_t Index = 0; Index < _Count; ++Index)
+        {
+            if (!(_pLhs[Index] == _pRhs[Index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/*************************************************************************
+ * DRIVER SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+static void
+RunType(const char* _pType, size_t _Count)
+{
+    std::vector<T> Lhs(_Count);
+    std::vector<T> Rhs(_Count);
+    for (size_t Index = 0; Index < _Count; ++Index)
+    {
+        Lhs[Index] = static_cast<T>(static_cast<int>(Index % 1000) - 500);
+        Rhs[Index] = Lhs[Index];
+    }
+
+    const T* pLhs    = &Lhs[0];
+    const T* pRhs    = &Rhs[0];
+    T        Missing = static_cast<T>(100000);
+    size_t   Bytes   = _Count * sizeof(T);
+
+    typedef SPlainLoops<T> loop_type;
+
+    printf("%s, %zu elements\n", _pType, _Count);
+
+    Report("Find", Bytes,
+           [&]() { return loop_type::Find(pLhs, _Count, Missing); },
+           [&]() { return SSse2Kernels::Find(pLhs, _Count, Missing); },
+           [&]() { return SAvx2Kernels::Find(pLhs, _Count, Missing); },
+           [&]() { return SAvx512Kernels::Find(pLhs, _Count, Missing); });
+    Report("Count", Bytes,
+           [&]() { return loop_type::Count(pLhs, _Count, T(7)); },
+           [&]() { return SSse2Kernels::Count(pLhs, _Count, T(7)); },
+           [&]() { return SAvx2Kernels::Count(pLhs, _Count, T(7)); },
+           [&]() { return SAvx512Kernels::Count(pLhs, _Count, T(7)); });
+    Report("MinMax", Bytes,
+           [&]() { return loop_type::MinMax(pLhs, _Count); },
+           [&]() { return SSse2Kernels::MinMax(pLhs, _Count); },
+           [&]() { return SAvx2Kernels::MinMax(pLhs, _Count); },
+           [&]() { return SAvx512Kernels::MinMax(pLhs, _Count); });
+    Report("Sum", Bytes,
+           [&]() { return loop_type::Sum(pLhs, _Count); },
+           [&]() { return SSse2Kernels::Sum(pLhs, _Count); },
+           [&]() { return SAvx2Kernels::Sum(pLhs, _Count); },
+           [&]() { return SAvx512Kernels::Sum(pLhs, _Count); });
+    Report("Dot", 2 * Bytes,
+           [&]() { return loop_type::Dot(pLhs, pRhs, _Count); },
+           [&]() { return SSse2Kernels::Dot(pLhs, pRhs, _Count); },
+           [&]() { return SAvx2Kernels::Dot(pLhs, pRhs, _Count); },
+           [&]() { return SAvx512Kernels::Dot(pLhs, pRhs, _Count); });
+    Report("Equal", 2 * Bytes,
+           [&]() { return loop_type::Equal(pLhs, pRhs, _Count); },
+           [&]() { return SSse2Kernels::Equal(pLhs, pRhs, _Count); },
+           [&]() { return SAvx2Kernels::Equal(pLhs, pRhs, _Count); },
+           [&]() { return SAvx512Kernels::Equal(pLhs, pRhs, _Count); });
+}
+
+int
+main(int _ArgCount, char** _ppArgs)
+{
+    std::vector<size_t> Counts;
+
+    std::string Sizes = _ArgCount > 1 ? _ppArgs[1] : "4096,262144,16777216";
+    for (size_t Begin = 0; Begin < Sizes.size(); )
+    {
+        size_t End = Sizes.find(',', Begin);
+        End = End == std::string::npos ? Sizes.size() : End;
+        Counts.push_back(static_cast<size_t>(strtoull(Sizes.substr(Begin, End - Begin).c_str(), 0, 10)));
+        Begin = End + 1;
+    }
+
+    const char* Levels[] = { "scalar", "SSE2", "AVX2", "AVX-512" };
+    printf("best kernel level: %s, GB/s read\n", Levels[GetSimdLevel()]);
+    printf("  %-8s %10s %10s %10s %10s %10s\n", "", "loop", "SSE2", "AVX2", "AVX-512", "best/loop");
+
+    for (size_t Size = 0; Size < Counts.size(); ++Size)
+    {
+        RunType<int32_t>("int32_t", Counts[Size]);
+        RunType<float>("float", Counts[Size]);
+        RunType<double>("double", Counts[Size]);
+    }
+
+    return 0;
+}
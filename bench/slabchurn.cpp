@@ -0,0 +1,229 @@
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+/**
+ * Allocation churn of CSlabHeap against malloc, measuring speed and RSS.
+ *     g++ -std=c++11 -O2 -DNDEBUG -pthread -I.. slabchurn.cpp -o slabchurn
+ *     ./slabchurn [cycles = 8] [peak live blocks = 400000] [malloc | slab | retain]
+ * Imitates a long running process: every cycle grows the live set to its
+ * peak with buffer sized requests (16 bytes to 16 KiB, a few large ones),
+ * fills every block, then frees all but a random tenth, which survive into
+ * the next cycle and pin the pages around them. The slab heap calls Decay()
+ * at the end of every cycle; retain is the same heap with unbounded caches
+ * and no Decay(), so it keeps its pages like malloc does and shows what
+ * giving memory back costs. RSS is read from /proc, so the driver runs on
+ * Linux only; without a mode argument it runs each heap in its own child
+ * process.
+ **/
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "benchmark.h"
+#include "../memory/slaballocator.h"
+
+using BASE::MEM::CSlabHeap;
+
+struct SSlabHeap
+{
+    static const char* GetName()                             { return "slab"; }
+    static void*       Allocate(size_t _Size)                { return CSlabHeap::GetDefault().Allocate(_Size, 16); }
+    static void        Deallocate(void* _pMem, size_t _Size) { CSlabHeap::GetDefault().Deallocate(_pMem, _Size, 16); }
+    static void        EndCycle()                            { CSlabHeap::GetDefault().Decay(); }
+};
+
+struct SRetainingSlabHeap
+{
+    static const char* GetName()                             { return "retain"; }
+    static void*       Allocate(size_t _Size)                { return CSlabHeap::GetDefault().Allocate(_Size, 16); }
+    static void        Deallocate(void* _pMem, size_t _Size) { CSlabHeap::GetDefault().Deallocate(_pMem, _Size, 16); }
+    static void        EndCycle()                            { }
+};
+
+struct SMallocHeap
+{
+    static const char* GetName()                             { return "malloc"; }
+    static void*       Allocate(size_t _Size)                { return malloc(_Size); }
+    static void        Deallocate(void* _pMem, size_t)       { free(_pMem); }
+    static void        EndCycle()                            { }
+};
+
+struct SBlock
+{
+    void*  m_pMem;
+    size_t m_Size;
+};
+
+static uint32_t
+GetRandom(uint32_t& _rState)
+{
+    _rState ^= _rState << 13;
+    _rState ^= _rState >> 17;
+    _rState ^= _rState << 5;
+    return _rState;
+}
+
+static size_t
+GetSize(uint32_t& _rState)                                              // mostly vector buffers, 1 in 500 large
+{
+    uint32_t Random = GetRandom(_rState);
+
+    if (Random % 500 == 0)
+    {
+        return (64 + Random % 960) * 1024;
+    }
+
+    size_t Size = size_t(16) << ((Random >> 8) % 11);                   // 16 bytes .. 16 KiB, geometric like growth
+    return Size - (Random >> 20) % (Size / 2);
+}
+
+static size_t
+GetResidentBytes()
+{
+    FILE* pFile = fopen("/proc/self/statm", "r");
+    if (pFile == 0)
+    {
+        return 0;
+    }
+
+    unsigned long Total    = 0;
+    unsigned long Resident = 0;
+    if (fscanf(pFile, "%lu %lu", &Total, &Resident) != 2)
+    {
+        Resident = 0;
+    }
+    fclose(pFile);
+
+    return static_cast<size_t>(Resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+template <typename THeap>
+static void
+Run(size_t _CycleCount, size_t _PeakCount)
+{
+    std::vector<SBlock> Live;
+    Live.reserve(_PeakCount);
+
+    uint32_t Random     = 12345;
+    size_t   Operations = 0;
+    size_t   PeakRss    = 0;
+    size_t   BaseRss    = GetResidentBytes();
+    double   Start      = BENCH::GetSeconds();
+
+    printf("%s\n%-6s %14s %14s %14s\n", THeap::GetName(), "cycle", "live MiB", "peak RSS MiB", "trough RSS MiB");
+
+    for (size_t Cycle = 0; Cycle < _CycleCount; ++Cycle)
+    {
+        size_t LiveBytes = 0;
+
+        while (Live.size() < _PeakCount)
+        {
+            SBlock Block = { 0, GetSize(Random) };
+            Block.m_pMem = THeap::Allocate(Block.m_Size);
+            memset(Block.m_pMem, 1, Block.m_Size);                      // filled like a real buffer, every page resident
+
+            Live.push_back(Block);
+            ++Operations;
+        }
+
+        for (size_t Index = 0; Index < Live.size(); ++Index)
+        {
+            LiveBytes += Live[Index].m_Size;
+        }
+
+        size_t Rss = GetResidentBytes() - BaseRss;
+        PeakRss = Rss > PeakRss ? Rss : PeakRss;
+
+        // a random tenth survives into the next cycle, the rest is freed
+        size_t Kept = 0;
+        for (size_t Index = 0; Index < Live.size(); ++Index)
+        {
+            if (GetRandom(Random) % 10 == 0)
+            {
+                Live[Kept++] = Live[Index];
+            }
+            else
+            {
+                THeap::Deallocate(Live[Index].m_pMem, Live[Index].m_Size);
+                ++Operations;
+            }
+        }
+        Live.resize(Kept);
+        THeap::EndCycle();
+
+        printf("%-6zu %14.1f %14.1f %14.1f\n", Cycle, LiveBytes / 1048576.0, Rss / 1048576.0, (GetResidentBytes() - BaseRss) / 1048576.0);
+    }
+
+    double Seconds = BENCH::GetSeconds() - Start;
+
+    for (size_t Index = 0; Index < Live.size(); ++Index)
+    {
+        THeap::Deallocate(Live[Index].m_pMem, Live[Index].m_Size);
+    }
+    THeap::EndCycle();
+
+    printf("%s: %.1f Mops/s, peak RSS %.1f MiB, after teardown %.1f MiB\n\n", THeap::GetName(),
+           Operations / Seconds / 1e6, PeakRss / 1048576.0, (GetResidentBytes() - BaseRss) / 1048576.0);
+}
+
+static void
+RunMode(const char* _pMode, size_t _CycleCount, size_t _PeakCount)
+{
+    if (strcmp(_pMode, "slab") == 0)
+    {
+        Run<SSlabHeap>(_CycleCount, _PeakCount);
+    }
+    else if (strcmp(_pMode, "retain") == 0)
+    {
+        CSlabHeap::GetDefault().SetCacheLimit(static_cast<size_t>(-1));
+        CSlabHeap::GetDefault().SetLargeCacheLimit(static_cast<size_t>(-1));
+        Run<SRetainingSlabHeap>(_CycleCount, _PeakCount);
+    }
+    else
+    {
+        Run<SMallocHeap>(_CycleCount, _PeakCount);
+    }
+}
+
+int
+main(int _ArgCount, char** _ppArgs)
+{
+    size_t CycleCount = BENCH::GetArgument(_ArgCount, _ppArgs, 1, 8);
+    size_t PeakCount  = BENCH::GetArgument(_ArgCount, _ppArgs, 2, 400000);
+
+    if (_ArgCount > 3)
+    {
+        RunMode(_ppArgs[3], CycleCount, PeakCount);
+        return 0;
+    }
+
+    // separate processes, so neither heap sees pages the other one touched
+    const char* Modes[] = { "malloc", "slab", "retain" };
+    for (size_t Mode = 0; Mode < 3; ++Mode)
+    {
+        fflush(stdout);
+
+        pid_t Child = fork();
+        if (Child == 0)
+        {
+            RunMode(Modes[Mode], CycleCount, PeakCount);
+            fflush(stdout);
+            _exit(0);
+        }
+
+        int Status = 0;
+        waitpid(Child, &Status, 0);
+        BENCH::Check(WIFEXITED(Status) && WEXITSTATUS(Status) == 0, "benchmark child failed");
+    }
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+/**
+ * Sort, RadixSort and ParallelSort against std::sort.
+ *     g++ -std=c++11 -O2 -DNDEBUG -pthread -I.. sort.cpp -o sort
+ *     ./sort [elements = 1000000,10000000,100000000]
+ * Sorts uint64_t and double keys in a CVector, random, already sorted,
+ * reversed and with only 16 distinct values, and prints milliseconds per
+ * run (best of three below 10M elements, one run above). Every result is
+ * checked to be ordered and to hold the same elements. 100M uint64_t need
+ * about 2.4 GB: the input, the copy being sorted and the buffer of
+ * RadixSort and ParallelSort. ParallelSort uses the default CThreadPool.
+ **/
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "../algorithm/sort.h"
+#include "../container/sequential/vector.h"
+
+enum EPattern
+{
+    PatternRandom,
+    PatternSorted,
+    PatternReversed,
+    PatternFewUnique,
+};
+
+static const char* const s_PatternNames[] = { "random", "sorted", "reversed", "16 unique" };
+
+template <typename T>
+static void
+Fill(BASE::CNT::CVector<T>& _rData, size_t _Count, EPattern _Pattern)
+{
+    uint64_t Random = 88172645463325252ull;
+
+    _rData.Resize(_Count);
+    for (size_t Index = 0; Index < _Count; ++Index)
+    {
+        Random ^= Random << 13;
+        Random ^= Random >> 7;
+        Random ^= Random << 17;
+
+        switch (_Pattern)
+        {
+        case PatternRandom:    _rData[Index] = static_cast<T>(Random >> 11); break;
+        case PatternSorted:    _rData[Index] = static_cast<T>(Index); break;
+        case PatternReversed:  _rData[Index] = static_cast<T>(_Count - Index); break;
+        case PatternFewUnique: _rData[Index] = static_cast<T>(Random % 16); break;
+        }
+    }
+}
+
+template <typename T>
+static uint64_t
+Checksum(const BASE::CNT::CVector<T>& _rData)                           // order independent, exact
+{
+    uint64_t Sum = 0;
+    for (size_t Index = 0; Index < _rData.GetCount(); ++Index)
+    {
+        uint64_t Bits = 0;
+        memcpy(&Bits, &_rData[Index], sizeof(T));
+        Sum += Bits * 0x9E3779B97F4A7C15ull ^ (Bits >> 29);
+    }
+    return Sum;
+}
+
+template <typename T, typename TSort>
+static double
+Measure(const BASE::CNT::CVector<T>& _rInput, BASE::CNT::CVector<T>& _rWork, TSort _Sort)   // milliseconds
+{
+    size_t Runs = _rInput.GetCount() < 10000000 ? 3 : 1;
+    double Best = 0.0;
+
+    for (size_t Run = 0; Run < Runs; ++Run)
+    {
+        _rWork = _rInput;
+
+        double Start = BENCH::GetSeconds();
+        _Sort(_rWork.GetData(), _rWork.GetData() + _rWork.GetCount());
+        double Seconds = BENCH::GetSeconds() - Start;
+
+        Best = (Run == 0 || Seconds < Best) ? Seconds : Best;
+    }
+
+    BENCH::Check(std::is_sorted(_rWork.GetData(), _rWork.GetData() + _rWork.GetCount()), "result not ordered");
+    BENCH::Check(Checksum(_rWork) == Checksum(_rInput), "result lost elements");
+
+    return Best * 1e3;
+}
+
+template <typename T>
+static void
+RunType(const char* _pType, size_t _Count)
+{
+    typedef T* iterator;                                                // CVector iterators do not fit std::sort
+
+    BASE::CNT::CVector<T> Input;
+    BASE::CNT::CVector<T> Work;
+
+    for (size_t Pattern = PatternRandom; Pattern <= PatternFewUnique; ++Pattern)
+    {
+        Fill(Input, _Count, static_cast<EPattern>(Pattern));
+
+        double Std      = Measure(Input, Work, [](iterator _First, iterator _Last) { std::sort(_First, _Last); });
+        double Intro    = Measure(Input, Work, [](iterator _First, iterator _Last) { BASE::ALGO::Sort(_First, _Last); });
+        double Radix    = Measure(Input, Work, [](iterator _First, iterator _Last) { BASE::ALGO::RadixSort(_First, _Last); });
+        double Parallel = Measure(Input, Work, [](iterator _First, iterator _Last) { BASE::ALGO::ParallelSort(_First, _Last); });
+
+        printf("%-9s %11zu %-10s %10.1f %10.1f %10.1f %10.1f\n", _pType, _Count, s_PatternNames[Pattern], Std, Intro, Radix, Parallel);
+    }
+}
+
+int
+main(int _ArgCount, char** _ppArgs)
+{
+    std::vector<size_t> Counts;
+
+    std::string Sizes = _ArgCount > 1 ? _ppArgs[1] : "1000000,10000000,100000000";
+    for (size_t Begin = 0; Begin < Sizes.size(); )
+    {
+        size_t End = Sizes.find(',', Begin);
+        End = End == std::string::npos ? Sizes.size() : End;
+        Counts.push_back(static_cast<size_t>(strtoull(Sizes.substr(Begin, End - Begin).c_str(), 0, 10)));
+        Begin = End + 1;
+    }
+
+    printf("%zu pool threads plus the caller, milliseconds\n", BASE::UTIL::CThreadPool::GetDefault().GetThreadCount());
+    printf("%-9s %11s %-10s %10s %10s %10s %10s\n", "type", "elements", "input", "std::sort", "Sort", "RadixSort", "Parallel");
+
+    for (size_t Size = 0; Size < Counts.size(); ++Size)
+    {
+        RunType<uint64_t>("uint64_t", Counts[Size]);
+        RunType<double>("double", Counts[Size]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+/**
+ * Thread scaling of CThreadCacheAllocator against ::operator new/delete.
+ *     g++ -std=c++11 -O2 -DNDEBUG -pthread -I.. threadcache.cpp -o threadcache
+ *     ./threadcache [max threads = 8] [operations per thread = 4000000]
+ * Every thread keeps a working set of small blocks (16 to 512 bytes) and
+ * replaces a random one per step. At the end a tenth of every working set
+ * is freed by another thread, which is not timed. The table lists million
+ * operations (allocation plus free) per second and the speedup over one
+ * thread; ideal scaling doubles with the thread count as long as there are
+ * cores for them.
+ **/
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#include "benchmark.h"
+#include "../memory/threadcacheallocator.h"
+
+static const size_t s_WorkingSet = 4096;                                // live blocks per thread
+
+struct SCachedHeap
+{
+    static void* Allocate(size_t _Size)                { return BASE::MEM::CThreadCacheAllocator<char>().Allocate(_Size); }
+    static void  Deallocate(void* _pMem, size_t _Size) { BASE::MEM::CThreadCacheAllocator<char>().Deallocate(static_cast<char*>(_pMem), _Size); }
+};
+
+struct SGlobalHeap
+{
+    static void* Allocate(size_t _Size)                { return ::operator new(_Size); }
+    static void  Deallocate(void* _pMem, size_t)       { ::operator delete(_pMem); }
+};
+
+struct SSlot
+{
+    void*  m_pMem;
+    size_t m_Size;
+};
+
+static uint32_t
+GetRandom(uint32_t& _rState)                                            // xorshift, cheap next to the allocator
+{
+    _rState ^= _rState << 13;
+    _rState ^= _rState >> 17;
+    _rState ^= _rState << 5;
+    return _rState;
+}
+
+template <typename THeap>
+static double
+Run(size_t _ThreadCount, size_t _OperationCount)                        // returns operations per second
+{
+    std::vector<std::vector<SSlot> > Sets(_ThreadCount, std::vector<SSlot>(s_WorkingSet));
+    std::vector<std::thread>          Threads;
+
+    double Start = BENCH::GetSeconds();
+
+    for (size_t Thread = 0; Thread < _ThreadCount; ++Thread)
+    {
+        Threads.push_back(std::thread([&, Thread]()
+        {
+            std::vector<SSlot>& rSet   = Sets[Thread];
+            uint32_t            Random = static_cast<uint32_t>(Thread) * 7919 + 1;
+
+            for (size_t Slot = 0; Slot < s_WorkingSet; ++Slot)
+            {
+                rSet[Slot].m_Size = 16 + (GetRandom(Random) & 31) * 16;
+                rSet[Slot].m_pMem = THeap::Allocate(rSet[Slot].m_Size);
+            }
+
+            for (size_t Operation = 0; Operation < _OperationCount; ++Operation)
+            {
+                SSlot& rSlot = rSet[GetRandom(Random) % s_WorkingSet];
+
+                THeap::Deallocate(rSlot.m_pMem, rSlot.m_Size);
+                rSlot.m_Size = 16 + (GetRandom(Random) & 31) * 16;
+                rSlot.m_pMem = THeap::Allocate(rSlot.m_Size);
+                *static_cast<char*>(rSlot.m_pMem) = 1;
+            }
+        }));
+    }
+
+    for (size_t Thread = 0; Thread < _ThreadCount; ++Thread)
+    {
+        Threads[Thread].join();
+    }
+
+    double Seconds = BENCH::GetSeconds() - Start;
+
+    // free a tenth of every set on the neighbouring thread, the rest at home
+    Threads.clear();
+    for (size_t Thread = 0; Thread < _ThreadCount; ++Thread)
+    {
+        Threads.push_back(std::thread([&, Thread]()
+        {
+            std::vector<SSlot>& rOwn   = Sets[Thread];
+            std::vector<SSlot>& rOther = Sets[(Thread + 1) % _ThreadCount];
+
+            for (size_t Slot = 0; Slot < s_WorkingSet; ++Slot)
+            {
+                std::vector<SSlot>& rSet = (Slot % 10 == 0) ? rOther : rOwn;
+                THeap::Deallocate(rSet[Slot].m_pMem, rSet[Slot].m_Size);
+            }
+        }));
+        Threads.back().join();                                          // one after the other, the sets are shared
+    }
+
+    return static_cast<double>(_ThreadCount) * _OperationCount / Seconds;
+}
+
+int
+main(int _ArgCount, char** _ppArgs)
+{
+    size_t MaxThreads     = BENCH::GetArgument(_ArgCount, _ppArgs, 1, 8);
+    size_t OperationCount = BENCH::GetArgument(_ArgCount, _ppArgs, 2, 4000000);
+
+    printf("%u hardware threads\n", std::thread::hardware_concurrency());
+    printf("%-8s %16s %8s %18s %8s\n", "threads", "cache Mops/s", "speedup", "new/delete Mops/s", "speedup");
+
+    double CachedBase = 0.0;
+    double GlobalBase = 0.0;
+
+    for (size_t Threads = 1; Threads <= MaxThreads; Threads *= 2)
+    {
+        double Cached = Run<SCachedHeap>(Threads, OperationCount);
+        double Global = Run<SGlobalHeap>(Threads, OperationCount);
+
+        if (Threads == 1)
+        {
+            CachedBase = Cached;
+            GlobalBase = Global;
+        }
+
+        printf("%-8zu %16.1f %7.2fx %18.1f %7.2fx\n", Threads, Cached / 1e6, Cached / CachedBase, Global / 1e6, Global / GlobalBase);
+    }
+
+    return 0;
+}
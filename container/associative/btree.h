@@ -18,7 +18,8 @@
  ************************************************************************************/
 
 #include <assert.h>
-#include <exception>
+#include <stdexcept>
+#include <utility>
 #include "../iterator/iterator.h"
 #include "../../memory/allocator.h"
 #include "../../typetraits/is_cstring.h"
@@ -72,19 +73,23 @@ public: // public typdefs
     typedef CReverseIterator<iterator>       reverse_iterator;
     typedef CReverseIterator<const_iterator> const_reverse_iterator;
 
+    typedef TAllocator<value_type> allocator_type;
+
 private: // private typedefs
 
     typedef SNode                                  node_type;
     typedef THash<key_type>                        hash_func_type;
     typedef typename hash_func_type::key_hash_type key_hash_type;
 
-    typedef TAllocator<node_type> allocator_type;
+    typedef typename allocator_type::template SRebind<node_type>::other node_allocator_type;
 
 public: // ctor, dtor
 
-    CBinaryTree();
-    CBinaryTree(const self_type& _rList);                                   // copy ctor
-    self_type& operator=(const self_type& _rList);                          // assignment operator
+    CBinaryTree(const allocator_type& _Allocator = allocator_type());
+    CBinaryTree(const self_type& _rTree);                                   // copy ctor, takes over the allocator
+    CBinaryTree(self_type&& _rTree);                                        // move ctor, takes over nodes and allocator
+    self_type& operator=(const self_type& _rTree);                          // assignment operator, keeps the own allocator
+    self_type& operator=(self_type&& _rTree);                               // move assignment, takes over nodes and allocator
 
     ~CBinaryTree();
 
@@ -111,30 +116,33 @@ public: // public operations
     value_const_reference_type GetElement(const key_reference_type _rKey) const;
 
     void Clear();                                                           // clear the list of all inserted elements
+    void Swap(self_type& _rTree);                                           // swap nodes and allocators
 
 public: // public properties
 
     bool      IsEmpty() const;                                              // return if list is empty
     size_type GetElementCount() const;                                      // return number of elements in list
 
+    allocator_type GetAllocator() const;                                    // return copy of the allocator
+
 public: // iterator declaration
 
     class CConstIterator : public SIterator<SBidirectionalIteratorTag, TValue>
     {
     public:
 
-        friend typename CBinaryTree<TKey, TValue, THash, TAllocator>;
+        friend class CBinaryTree<TKey, TValue, THash, TAllocator>;
 
     public:
 
         typedef CConstIterator                               self_type;
         typedef SIterator<SBidirectionalIteratorTag, TValue> base_type;
 
-        typedef typename base_type::iterator_tag_type          iterator_tag_type;
-        typedef typename base_type::value_type                 value_type;
-        typedef typename const base_type::value_reference_type value_reference_type;
-        typedef typename const base_type::value_pointer_type   value_pointer_type;
-        typedef typename base_type::difference_type            difference_type;
+        typedef typename base_type::iterator_tag_type iterator_tag_type;
+        typedef typename base_type::value_type        value_type;
+        typedef const value_type&                     value_reference_type;
+        typedef const value_type*                     value_pointer_type;
+        typedef typename base_type::difference_type   difference_type;
 
     private:
 
@@ -175,12 +183,16 @@ public: // iterator declaration
     {
     public:
 
-        friend typename CBinaryTree<TKey, TValue, THash, TAllocator>;
+        friend class CBinaryTree<TKey, TValue, THash, TAllocator>;
 
     public:
 
         typedef CIterator self_type;
 
+        typedef typename CConstIterator::value_type value_type;
+        typedef value_type&                         value_reference_type;
+        typedef value_type*                         value_pointer_type;
+
     private:
 
         typedef typename CBinaryTree::node_type node_type;
@@ -219,13 +231,16 @@ private: // node declaration
 
 private: // member
 
-    hash_func_type m_HashFunc;
-    allocator_type m_Allocator;
-    node_type*     m_pRoot;
-    size_type      m_ElementCount;
+    hash_func_type      m_HashFunc;
+    node_allocator_type m_Allocator;
+    node_type*          m_pRoot;
+    size_type           m_ElementCount;
 
 private: // internal methods
 
+    node_type* CloneChild(const node_type* _pChild, node_type* _pParent);
+    void       DestroyNode(node_type* _pNode);
+    void       TakeOver(self_type& _rTree);
     iterator InsertOnChild(node_type** _ppChild, node_type* _pParent, const key_hash_type& _rHashKey, const value_type& _rValue);
     iterator FindOnChild(node_type* _pChild, const key_hash_type& _rHashKey) const;
     SNode*   FindMostLeftChild(node_type* _pChild, node_type* _pParent) const;
@@ -235,12 +250,57 @@ private: // internal methods
 };
 
 template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
-CBinaryTree<TKey, TValue, THash, TAllocator>::CBinaryTree()
+CBinaryTree<TKey, TValue, THash, TAllocator>::CBinaryTree(const allocator_type& _Allocator)
     : m_HashFunc()
-    , m_Allocator()
+    , m_Allocator(_Allocator)
+    , m_pRoot(0)
+    , m_ElementCount(0)
+{
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+CBinaryTree<TKey, TValue, THash, TAllocator>::CBinaryTree(const self_type& _rTree)
+    : m_HashFunc(_rTree.m_HashFunc)
+    , m_Allocator(_rTree.m_Allocator)
     , m_pRoot(0)
     , m_ElementCount(0)
 {
+    m_pRoot = CloneChild(_rTree.m_pRoot, 0);
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+CBinaryTree<TKey, TValue, THash, TAllocator>::CBinaryTree(self_type&& _rTree)
+    : m_HashFunc(_rTree.m_HashFunc)
+    , m_Allocator(_rTree.m_Allocator)
+    , m_pRoot(0)
+    , m_ElementCount(0)
+{
+    TakeOver(_rTree);
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::self_type&
+    CBinaryTree<TKey, TValue, THash, TAllocator>::operator=(const self_type& _rTree)
+{
+    if (this != &_rTree)
+    {
+        Clear();
+        m_pRoot = CloneChild(_rTree.m_pRoot, 0);
+    }
+    return *this;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::self_type&
+    CBinaryTree<TKey, TValue, THash, TAllocator>::operator=(self_type&& _rTree)
+{
+    if (this != &_rTree)
+    {
+        Clear();
+        m_Allocator = _rTree.m_Allocator;
+        TakeOver(_rTree);
+    }
+    return *this;
 }
 
 template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
@@ -319,7 +379,9 @@ typename CBinaryTree<TKey, TValue, THash, TAllocator>::iterator
 {
     if (*_ppChild == 0)
     { // child doesn't exist
-        *_ppChild = new SNode(_pParent, 0, 0, _rHashKey, _rValue);
+        node_type* pNode = m_Allocator.Allocate(1);
+        m_Allocator.Construct(pNode, SNode(_pParent, 0, 0, _rHashKey, _rValue));
+        *_ppChild = pNode;
         ++m_ElementCount;
 
         return *_ppChild;
@@ -357,19 +419,19 @@ typename CBinaryTree<TKey, TValue, THash, TAllocator>::iterator
     if (pNode->m_pLeftChild == 0 && pNode->m_pRightChild == 0)
     { // leaf node
         *ppParentLink = 0;
-        delete pNode;
+        DestroyNode(pNode);
     }
     else if (pNode->m_pLeftChild == 0)
     { // only right leaf
         pNode->m_pRightChild->m_pParent = pParent;
         *ppParentLink = pNode->m_pRightChild;
-        delete pNode;
+        DestroyNode(pNode);
     }
     else if (pNode->m_pRightChild == 0)
     { // only left leaf
         pNode->m_pLeftChild->m_pParent = pParent;
         *ppParentLink = pNode->m_pLeftChild;
-        delete pNode;
+        DestroyNode(pNode);
     }
     else
     { // node has two leaves
@@ -391,6 +453,20 @@ void
     }
 }
 
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+void
+    CBinaryTree<TKey, TValue, THash, TAllocator>::Swap(self_type& _rTree)
+{
+    if (this == &_rTree)
+    {
+        return;
+    }
+
+    self_type Temp(std::move(_rTree));
+    _rTree = std::move(*this);
+    *this = std::move(Temp);
+}
+
 template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
 typename CBinaryTree<TKey, TValue, THash, TAllocator>::iterator
     CBinaryTree<TKey, TValue, THash, TAllocator>::Find(const key_type& _rKey) const
@@ -426,7 +502,7 @@ typename CBinaryTree<TKey, TValue, THash, TAllocator>::value_reference_type
 
     if (It == 0)
     {
-        throw std::exception("Element not in binary tree.");
+        throw std::out_of_range("Element not in binary tree.");
     }
 
     return *Find(_rKey);
@@ -440,7 +516,7 @@ typename CBinaryTree<TKey, TValue, THash, TAllocator>::value_const_reference_typ
 
     if (It == 0)
     {
-        throw std::exception("Element not in binary tree.");
+        throw std::out_of_range("Element not in binary tree.");
     }
 
     return *Find(_rKey);
@@ -474,6 +550,53 @@ typename CBinaryTree<TKey, TValue, THash, TAllocator>::size_type
     return m_ElementCount;
 }
 
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::allocator_type
+    CBinaryTree<TKey, TValue, THash, TAllocator>::GetAllocator() const
+{
+    return allocator_type(m_Allocator);
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::node_type*
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CloneChild(const node_type* _pChild, node_type* _pParent)
+{
+    if (_pChild == 0)
+    {
+        return 0;
+    }
+
+    node_type* pNode = m_Allocator.Allocate(1);
+    m_Allocator.Construct(pNode, SNode(_pParent, 0, 0, _pChild->m_HashKey, _pChild->m_Value));
+    ++m_ElementCount;
+
+    pNode->m_pLeftChild  = CloneChild(_pChild->m_pLeftChild, pNode);
+    pNode->m_pRightChild = CloneChild(_pChild->m_pRightChild, pNode);
+
+    return pNode;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+void
+    CBinaryTree<TKey, TValue, THash, TAllocator>::DestroyNode(node_type* _pNode)
+{
+    m_Allocator.Destroy(_pNode);
+    m_Allocator.Deallocate(_pNode, 1);
+    --m_ElementCount;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+void
+    CBinaryTree<TKey, TValue, THash, TAllocator>::TakeOver(self_type& _rTree)
+{
+    // nodes stay in place, only the root changes hands
+    m_pRoot        = _rTree.m_pRoot;
+    m_ElementCount = _rTree.m_ElementCount;
+
+    _rTree.m_pRoot        = 0;
+    _rTree.m_ElementCount = 0;
+}
+
 template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
 typename CBinaryTree<TKey, TValue, THash, TAllocator>::node_type**
     CBinaryTree<TKey, TValue, THash, TAllocator>::GetParentChildLink(node_type* _pChild) const
@@ -552,6 +675,54 @@ const bool
     return m_pNode != _rRhs.m_pNode;
 }
 
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::value_reference_type
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::operator*() const
+{
+    return m_pNode->m_Value;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::value_pointer_type
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::operator->() const
+{
+    return &(operator*());
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::self_type&
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::operator++()
+{
+    Increment();
+    return *this;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+const typename CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::self_type
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::operator++(int)
+{
+    self_type Temp = *this;
+    Increment();
+    return Temp;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+typename CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::self_type&
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::operator--()
+{
+    Decrement();
+    return *this;
+}
+
+template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
+const typename CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::self_type
+    CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::operator--(int)
+{
+    self_type Temp = *this;
+    Decrement();
+    return Temp;
+}
+
 template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
 void 
     CBinaryTree<TKey, TValue, THash, TAllocator>::CConstIterator::Increment()
@@ -647,7 +818,7 @@ template <typename TKey, typename TValue, template <typename> class THash, templ
 typename CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::value_reference_type
     CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::operator*() const
 {
-    return m_pNode->m_Value;
+    return this->m_pNode->m_Value;
 }
 
 template <typename TKey, typename TValue, template <typename> class THash, template <typename> class TAllocator>
@@ -661,7 +832,7 @@ template <typename TKey, typename TValue, template <typename> class THash, templ
 typename CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::self_type&
     CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::operator++()
 {
-    Increment();
+    this->Increment();
     return *this;
 }
 
@@ -670,7 +841,7 @@ const typename CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::self_typ
     CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::operator++(int)
 {
     self_type Temp = *this;
-    Increment();
+    this->Increment();
     return Temp;
 }
 
@@ -678,7 +849,7 @@ template <typename TKey, typename TValue, template <typename> class THash, templ
 typename CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::self_type&
     CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::operator--()
 {
-    Decrement();
+    this->Decrement();
     return *this;
 }
 
@@ -687,7 +858,7 @@ const typename CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::self_typ
     CBinaryTree<TKey, TValue, THash, TAllocator>::CIterator::operator--(int)
 {
     self_type Temp = *this;
-    Decrement();
+    this->Decrement();
     return Temp;
 }
 
@@ -215,6 +215,66 @@ typename CReverseIterator<TIterator>::value_reference_type
     return *(*this + _Pos);
 }
 
+/*************************************************************************
+ * ITERATOR TRAITS SUBSECTION
+ *************************************************************************/
+
+/**
+ * Tag of an iterator: its iterator_tag_type, random access for pointers
+ * and input for foreign iterators, so algorithms stay usable with them.
+ **/
+template <class T>
+struct SIteratorVoid
+{
+    typedef void type;
+};
+
+template <class TIterator, class TEnable = void>
+struct SIteratorTraits
+{
+    typedef SInputIteratorTag iterator_tag_type;
+};
+
+template <class TIterator>
+struct SIteratorTraits<TIterator, typename SIteratorVoid<typename TIterator::iterator_tag_type>::type>
+{
+    typedef typename TIterator::iterator_tag_type iterator_tag_type;
+};
+
+template <class T>
+struct SIteratorTraits<T*, void>
+{
+    typedef SRandomAccessIteratorTag iterator_tag_type;
+};
+
+/*************************************************************************
+ * DISTANCE SUBSECTION
+ *************************************************************************/
+
+template <class TIterator>
+ptrdiff_t Distance(TIterator _First, TIterator _Last, SInputIteratorTag)
+{
+    ptrdiff_t Distance = 0;
+
+    for (; _First != _Last; ++_First)
+    {
+        ++Distance;
+    }
+
+    return Distance;
+}
+
+template <class TIterator>
+ptrdiff_t Distance(TIterator _First, TIterator _Last, SRandomAccessIteratorTag)
+{
+    return _Last - _First;
+}
+
+template <class TIterator>
+ptrdiff_t Distance(TIterator _First, TIterator _Last)                   // steps from _First to _Last
+{
+    return Distance(_First, _Last, typename SIteratorTraits<TIterator>::iterator_tag_type());
+}
 
     } // namespace CNT
 } // namespace BASE
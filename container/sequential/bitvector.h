@@ -0,0 +1,717 @@
+#ifndef __INCLUDE_BIT_VECTOR_H_
+#define __INCLUDE_BIT_VECTOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdexcept>
+#include "vector.h"
+#include "../../algorithm/simd.h"
+#include "../../memory/allocator.h"
+#include "../../utility/binary/bits.h"
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * Vector of bits packed into 64 bit words, one bit per flag instead of the
+ * byte a bool takes. Bit i lives in word i / 64 at position i % 64, the bits
+ * behind the last one are always 0, so whole words can be counted and
+ * combined without masking. SetRange and ResetRange work word by word,
+ * GetPopCount uses the SIMD kernels of SimdPopCount and the operators
+ * combine vectors of the same length in place.
+ **/
+template <template <typename> class TAllocator = BASE::MEM::CAllocator>
+class CBitVector
+{
+public: // typedefs
+
+    typedef CBitVector<TAllocator> self_type;
+
+    typedef uint64_t                         word_type;
+    typedef CVector<word_type, TAllocator>   word_vector_type;
+    typedef size_t                           size_type;
+
+    typedef typename word_vector_type::allocator_type allocator_type;
+
+    static const size_type s_WordBits = 64;
+
+public: // ctor, dtor
+
+    explicit CBitVector(const allocator_type& _Allocator = allocator_type());  // does not allocate
+    explicit CBitVector(size_type _Count, bool _Value = false, const allocator_type& _Allocator = allocator_type());
+
+public: // operations
+
+    void PushBack(bool _Value);
+    void PopBack();
+
+    bool operator[](size_type _Index) const;
+    bool Test(size_type _Index) const;
+
+    void Set(size_type _Index);
+    void Set(size_type _Index, bool _Value);
+    void Reset(size_type _Index);
+    void Flip(size_type _Index);
+
+    void SetRange(size_type _First, size_type _Last);                       // sets the bits [_First, _Last)
+    void ResetRange(size_type _First, size_type _Last);
+    void SetAll();
+    void ResetAll();
+
+    self_type& operator&=(const self_type& _rBits);                         // both vectors have to be of the same length
+    self_type& operator|=(const self_type& _rBits);
+    self_type& operator^=(const self_type& _rBits);
+    self_type& AndNot(const self_type& _rBits);                             // clears the bits set in _rBits
+
+    void Resize(size_type _Count, bool _Value = false);                     // new bits are _Value
+    void Reserve(size_type _Count);
+    void ShrinkToFit();
+    void Clear();
+
+    void Swap(self_type& _rBits);
+
+public: // properties
+
+    size_type         GetCount() const;
+    size_type         GetPopCount() const;                                  // number of set bits
+    size_type         GetWordCount() const;
+    const word_type*  GetWords() const;
+    allocator_type    GetAllocator() const;
+    bool              IsEmpty() const;
+
+private: // internal operations
+
+    static size_type GetWordIndex(size_type _Index);
+    static word_type GetBitMask(size_type _Index);
+    static size_type GetWordCount(size_type _Count);
+
+    void FillRange(size_type _First, size_type _Last, bool _Value);
+    void ClearTail();                                                       // restores the zero bits behind the last one
+
+private: // member
+
+    word_vector_type m_Words;
+    size_type        m_Count;
+};
+
+/**
+ * Rank and select index over a CBitVector.
+ * Rank(i) counts the set bits in front of position i, Select(k) finds the
+ * position of the set bit with rank k. Every 2048 bits the index stores a
+ * 64 bit word holding the rank at their start (relative to the last 2^32
+ * bit boundary) and the bit counts of their first three 512 bit blocks,
+ * 3.1% of the vector. Rank reads this word and counts at most eight more
+ * words. Select starts from the position of every 8192nd set bit, searches
+ * the 2048 bit blocks in between and the words of one 512 bit block.
+ * The index keeps a pointer to the vector and has to be rebuilt (Build)
+ * whenever the vector changes.
+ **/
+template <template <typename> class TAllocator = BASE::MEM::CAllocator>
+class CRankSelectIndex
+{
+public: // typedefs
+
+    typedef CRankSelectIndex<TAllocator> self_type;
+    typedef CBitVector<TAllocator>       bit_vector_type;
+
+    typedef typename bit_vector_type::word_type      word_type;
+    typedef typename bit_vector_type::size_type      size_type;
+    typedef typename bit_vector_type::allocator_type allocator_type;
+
+    static const size_type s_BlockBits      = 512;
+    static const size_type s_SuperBlockBits = 2048;
+    static const size_type s_SelectSample   = 8192;                         // set bits between two select samples
+
+public: // ctor, dtor
+
+    explicit CRankSelectIndex(const bit_vector_type& _rBits);                // builds the index
+
+public: // operations
+
+    void Build();
+
+    size_type Rank(size_type _Index) const;                                 // set bits in [0, _Index), _Index may be GetCount()
+    size_type RankZero(size_type _Index) const;                             // cleared bits in [0, _Index)
+    size_type Select(size_type _Rank) const;                                // position of the set bit with rank _Rank
+
+public: // properties
+
+    size_type GetPopCount() const;
+    size_type GetMemoryUsage() const;                                       // bytes taken by the index
+
+private: // internal typedefs
+
+    typedef CVector<uint32_t, TAllocator> sample_vector_type;
+
+private: // internal operations
+
+    uint64_t GetSuperBlockRank(size_type _SuperBlock) const;
+    size_type CountWords(size_type _First, size_type _Last) const;
+
+    static size_type SelectInWord(word_type _Word, size_type _Rank);
+
+private: // member
+
+    const bit_vector_type*                        m_pBits;
+    typename bit_vector_type::word_vector_type    m_UpperRanks;              // absolute rank every 2^32 bits
+    typename bit_vector_type::word_vector_type    m_SuperBlocks;             // relative rank << 32 | three 10 bit block counts
+    sample_vector_type                            m_Samples;                 // super block holding every s_SelectSample-th set bit
+    size_type                                     m_PopCount;
+};
+
+/*************************************************************************
+ * BIT VECTOR SUBSECTION
+ *************************************************************************/
+
+template <template <typename> class TAllocator>
+CBitVector<TAllocator>::CBitVector(const allocator_type& _Allocator)
+    : m_Words(_Allocator)
+    , m_Count(0)
+{
+}
+
+template <template <typename> class TAllocator>
+CBitVector<TAllocator>::CBitVector(size_type _Count, bool _Value, const allocator_type& _Allocator)
+    : m_Words(_Allocator)
+    , m_Count(0)
+{
+    Resize(_Count, _Value);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::PushBack(bool _Value)
+{
+    if (m_Count % s_WordBits == 0)
+    {
+        m_Words.PushBack(0);
+    }
+
+    if (_Value)
+    {
+        m_Words[GetWordIndex(m_Count)] |= GetBitMask(m_Count);
+    }
+    ++m_Count;
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::PopBack()
+{
+    assert(m_Count > 0);
+
+    Reset(m_Count - 1);
+    --m_Count;
+
+    if (m_Count % s_WordBits == 0)
+    {
+        m_Words.PopBack();
+    }
+}
+
+template <template <typename> class TAllocator>
+bool CBitVector<TAllocator>::operator[](size_type _Index) const
+{
+    return (m_Words[GetWordIndex(_Index)] & GetBitMask(_Index)) != 0;
+}
+
+template <template <typename> class TAllocator>
+bool CBitVector<TAllocator>::Test(size_type _Index) const
+{
+    if (_Index >= m_Count)
+    {
+        throw std::out_of_range("index out of range");
+    }
+
+    return (*this)[_Index];
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Set(size_type _Index)
+{
+    assert(_Index < m_Count);
+    m_Words[GetWordIndex(_Index)] |= GetBitMask(_Index);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Set(size_type _Index, bool _Value)
+{
+    if (_Value)
+    {
+        Set(_Index);
+    }
+    else
+    {
+        Reset(_Index);
+    }
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Reset(size_type _Index)
+{
+    assert(_Index < m_Count);
+    m_Words[GetWordIndex(_Index)] &= ~GetBitMask(_Index);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Flip(size_type _Index)
+{
+    assert(_Index < m_Count);
+    m_Words[GetWordIndex(_Index)] ^= GetBitMask(_Index);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::SetRange(size_type _First, size_type _Last)
+{
+    FillRange(_First, _Last, true);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::ResetRange(size_type _First, size_type _Last)
+{
+    FillRange(_First, _Last, false);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::SetAll()
+{
+    FillRange(0, m_Count, true);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::ResetAll()
+{
+    FillRange(0, m_Count, false);
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::self_type& CBitVector<TAllocator>::operator&=(const self_type& _rBits)
+{
+    assert(m_Count == _rBits.m_Count);
+
+    word_type*       pWords = m_Words.GetData();
+    const word_type* pOther = _rBits.m_Words.GetData();
+    for (size_type Word = 0, WordCount = m_Words.GetCount(); Word < WordCount; ++Word)
+    {
+        pWords[Word] &= pOther[Word];
+    }
+
+    return *this;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::self_type& CBitVector<TAllocator>::operator|=(const self_type& _rBits)
+{
+    assert(m_Count == _rBits.m_Count);
+
+    word_type*       pWords = m_Words.GetData();
+    const word_type* pOther = _rBits.m_Words.GetData();
+    for (size_type Word = 0, WordCount = m_Words.GetCount(); Word < WordCount; ++Word)
+    {
+        pWords[Word] |= pOther[Word];
+    }
+
+    return *this;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::self_type& CBitVector<TAllocator>::operator^=(const self_type& _rBits)
+{
+    assert(m_Count == _rBits.m_Count);
+
+    word_type*       pWords = m_Words.GetData();
+    const word_type* pOther = _rBits.m_Words.GetData();
+    for (size_type Word = 0, WordCount = m_Words.GetCount(); Word < WordCount; ++Word)
+    {
+        pWords[Word] ^= pOther[Word];
+    }
+
+    return *this;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::self_type& CBitVector<TAllocator>::AndNot(const self_type& _rBits)
+{
+    assert(m_Count == _rBits.m_Count);
+
+    word_type*       pWords = m_Words.GetData();
+    const word_type* pOther = _rBits.m_Words.GetData();
+    for (size_type Word = 0, WordCount = m_Words.GetCount(); Word < WordCount; ++Word)
+    {
+        pWords[Word] &= ~pOther[Word];
+    }
+
+    return *this;
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Resize(size_type _Count, bool _Value)
+{
+    size_type OldCount = m_Count;
+
+    m_Words.Resize(GetWordCount(_Count), 0);
+    m_Count = _Count;
+
+    if (_Count > OldCount)
+    {
+        FillRange(OldCount, _Count, _Value);
+    }
+    else
+    {
+        ClearTail();
+    }
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Reserve(size_type _Count)
+{
+    m_Words.Reserve(GetWordCount(_Count));
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::ShrinkToFit()
+{
+    m_Words.ShrinkToFit();
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Clear()
+{
+    m_Words.Resize(0);
+    m_Count = 0;
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::Swap(self_type& _rBits)
+{
+    m_Words.Swap(_rBits.m_Words);
+
+    size_type Count = m_Count;
+    m_Count         = _rBits.m_Count;
+    _rBits.m_Count  = Count;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::size_type CBitVector<TAllocator>::GetCount() const
+{
+    return m_Count;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::size_type CBitVector<TAllocator>::GetPopCount() const
+{
+    return BASE::ALGO::SimdPopCount(m_Words.GetData(), m_Words.GetCount());
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::size_type CBitVector<TAllocator>::GetWordCount() const
+{
+    return m_Words.GetCount();
+}
+
+template <template <typename> class TAllocator>
+const typename CBitVector<TAllocator>::word_type* CBitVector<TAllocator>::GetWords() const
+{
+    return m_Words.GetData();
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::allocator_type CBitVector<TAllocator>::GetAllocator() const
+{
+    return m_Words.GetAllocator();
+}
+
+template <template <typename> class TAllocator>
+bool CBitVector<TAllocator>::IsEmpty() const
+{
+    return m_Count == 0;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::size_type CBitVector<TAllocator>::GetWordIndex(size_type _Index)
+{
+    return _Index / s_WordBits;
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::word_type CBitVector<TAllocator>::GetBitMask(size_type _Index)
+{
+    return word_type(1) << (_Index % s_WordBits);
+}
+
+template <template <typename> class TAllocator>
+typename CBitVector<TAllocator>::size_type CBitVector<TAllocator>::GetWordCount(size_type _Count)
+{
+    return (_Count + s_WordBits - 1) / s_WordBits;
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::FillRange(size_type _First, size_type _Last, bool _Value)
+{
+    assert(_First <= _Last && _Last <= m_Count);
+
+    if (_First == _Last)
+    {
+        return;
+    }
+
+    word_type* pWords    = m_Words.GetData();
+    size_type  FirstWord = GetWordIndex(_First);
+    size_type  LastWord  = GetWordIndex(_Last - 1);
+    word_type  FirstMask = ~word_type(0) << (_First % s_WordBits);
+    word_type  LastMask  = ~word_type(0) >> (s_WordBits - 1 - (_Last - 1) % s_WordBits);
+
+    if (FirstWord == LastWord)
+    {
+        FirstMask &= LastMask;
+    }
+
+    pWords[FirstWord] = _Value ? (pWords[FirstWord] | FirstMask) : (pWords[FirstWord] & ~FirstMask);
+
+    if (FirstWord == LastWord)
+    {
+        return;
+    }
+
+    if (LastWord - FirstWord > 1)
+    {
+        memset(pWords + FirstWord + 1, _Value ? 0xFF : 0, (LastWord - FirstWord - 1) * sizeof(word_type));
+    }
+
+    pWords[LastWord] = _Value ? (pWords[LastWord] | LastMask) : (pWords[LastWord] & ~LastMask);
+}
+
+template <template <typename> class TAllocator>
+void CBitVector<TAllocator>::ClearTail()
+{
+    if (m_Count % s_WordBits != 0)
+    {
+        m_Words[GetWordIndex(m_Count)] &= GetBitMask(m_Count) - 1;
+    }
+}
+
+/*************************************************************************
+ * RANK SELECT INDEX SUBSECTION
+ *************************************************************************/
+
+template <template <typename> class TAllocator>
+CRankSelectIndex<TAllocator>::CRankSelectIndex(const bit_vector_type& _rBits)
+    : m_pBits(&_rBits)
+    , m_UpperRanks(_rBits.GetAllocator())
+    , m_SuperBlocks(_rBits.GetAllocator())
+    , m_Samples(typename sample_vector_type::allocator_type(_rBits.GetAllocator()))
+    , m_PopCount(0)
+{
+    Build();
+}
+
+template <template <typename> class TAllocator>
+void CRankSelectIndex<TAllocator>::Build()
+{
+    static const size_type s_BlockWords       = s_BlockBits / bit_vector_type::s_WordBits;
+    static const size_type s_SuperBlockWords  = s_SuperBlockBits / bit_vector_type::s_WordBits;
+    static const size_type s_UpperSuperBlocks = size_type(1) << 21;                             // super blocks per 2^32 bits
+
+    // one more super block than full ones, so Rank(GetCount()) has an entry
+    size_type SuperBlockCount = m_pBits->GetCount() / s_SuperBlockBits + 1;
+    size_type WordCount       = m_pBits->GetWordCount();
+
+    m_UpperRanks.Resize(0);
+    m_SuperBlocks.Resize(0);
+    m_Samples.Resize(0);
+    m_SuperBlocks.Reserve(SuperBlockCount);
+
+    uint64_t Total      = 0;
+    uint64_t UpperRank  = 0;
+    uint64_t NextSample = 0;
+
+    for (size_type SuperBlock = 0; SuperBlock < SuperBlockCount; ++SuperBlock)
+    {
+        if (SuperBlock % s_UpperSuperBlocks == 0)
+        {
+            UpperRank = Total;
+            m_UpperRanks.PushBack(UpperRank);
+        }
+
+        word_type Entry = (Total - UpperRank) << 32;
+
+        for (size_type Block = 0; Block < 4; ++Block)
+        {
+            size_type First = SuperBlock * s_SuperBlockWords + Block * s_BlockWords;
+            size_type Last  = First + s_BlockWords;
+
+            uint64_t Count = CountWords((First < WordCount) ? First : WordCount, (Last < WordCount) ? Last : WordCount);
+            if (Block < 3)
+            {
+                Entry |= Count << (20 - 10 * Block);
+            }
+            Total += Count;
+        }
+
+        for (; NextSample < Total; NextSample += s_SelectSample)
+        {
+            m_Samples.PushBack(static_cast<uint32_t>(SuperBlock));
+        }
+
+        m_SuperBlocks.PushBack(Entry);
+    }
+
+    m_PopCount = static_cast<size_type>(Total);
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::Rank(size_type _Index) const
+{
+    assert(_Index <= m_pBits->GetCount());
+
+    size_type SuperBlock = _Index / s_SuperBlockBits;
+    size_type Block      = _Index / s_BlockBits % 4;
+    word_type Entry      = m_SuperBlocks[SuperBlock];
+
+    uint64_t Result = GetSuperBlockRank(SuperBlock);
+    for (size_type Previous = 0; Previous < Block; ++Previous)
+    {
+        Result += (Entry >> (20 - 10 * Previous)) & 0x3FF;
+    }
+
+    size_type Word = _Index / bit_vector_type::s_WordBits;
+    Result += CountWords(_Index / s_BlockBits * (s_BlockBits / bit_vector_type::s_WordBits), Word);
+
+    if (_Index % bit_vector_type::s_WordBits != 0)
+    {
+        word_type Mask = (word_type(1) << (_Index % bit_vector_type::s_WordBits)) - 1;
+        Result += BASE::UTIL::GetPopCount(m_pBits->GetWords()[Word] & Mask);
+    }
+
+    return static_cast<size_type>(Result);
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::RankZero(size_type _Index) const
+{
+    return _Index - Rank(_Index);
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::Select(size_type _Rank) const
+{
+    assert(_Rank < m_PopCount);
+
+    // the super block holding the bit lies between the samples around it
+    size_type Sample = _Rank / s_SelectSample;
+    size_type Low    = m_Samples[Sample];
+    size_type High   = (Sample + 1 < m_Samples.GetCount()) ? m_Samples[Sample + 1] : m_SuperBlocks.GetCount() - 1;
+
+    while (Low < High)
+    {
+        size_type Middle = Low + (High - Low + 1) / 2;
+        if (GetSuperBlockRank(Middle) <= _Rank)
+        {
+            Low = Middle;
+        }
+        else
+        {
+            High = Middle - 1;
+        }
+    }
+
+    uint64_t  Remaining = _Rank - GetSuperBlockRank(Low);
+    word_type Entry     = m_SuperBlocks[Low];
+    size_type Block     = 0;
+
+    for (; Block < 3; ++Block)
+    {
+        uint64_t Count = (Entry >> (20 - 10 * Block)) & 0x3FF;
+        if (Remaining < Count)
+        {
+            break;
+        }
+        Remaining -= Count;
+    }
+
+    const word_type* pWords = m_pBits->GetWords();
+    size_type        Word   = (Low * 4 + Block) * (s_BlockBits / bit_vector_type::s_WordBits);
+
+    for (;; ++Word)
+    {
+        size_type Count = BASE::UTIL::GetPopCount(pWords[Word]);
+        if (Remaining < Count)
+        {
+            break;
+        }
+        Remaining -= Count;
+    }
+
+    return Word * bit_vector_type::s_WordBits + SelectInWord(pWords[Word], static_cast<size_type>(Remaining));
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::GetPopCount() const
+{
+    return m_PopCount;
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::GetMemoryUsage() const
+{
+    return (m_UpperRanks.GetCapacity() + m_SuperBlocks.GetCapacity()) * sizeof(word_type) + m_Samples.GetCapacity() * sizeof(uint32_t);
+}
+
+template <template <typename> class TAllocator>
+uint64_t CRankSelectIndex<TAllocator>::GetSuperBlockRank(size_type _SuperBlock) const
+{
+    uint64_t FirstBit = static_cast<uint64_t>(_SuperBlock) * s_SuperBlockBits;
+    return m_UpperRanks[static_cast<size_type>(FirstBit >> 32)] + (m_SuperBlocks[_SuperBlock] >> 32);
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::CountWords(size_type _First, size_type _Last) const
+{
+    const word_type* pWords = m_pBits->GetWords();
+
+    size_type Count = 0;
+    for (; _First < _Last; ++_First)
+    {
+        Count += BASE::UTIL::GetPopCount(pWords[_First]);
+    }
+    return Count;
+}
+
+template <template <typename> class TAllocator>
+typename CRankSelectIndex<TAllocator>::size_type CRankSelectIndex<TAllocator>::SelectInWord(word_type _Word, size_type _Rank)
+{
+    // narrow down to the byte first, then drop the lower set bits of it
+    size_type Bit = 0;
+    for (size_type Count = BASE::UTIL::GetPopCount(_Word & 0xFF); _Rank >= Count; Count = BASE::UTIL::GetPopCount(_Word & 0xFF))
+    {
+        _Rank -= Count;
+        _Word >>= 8;
+        Bit   += 8;
+    }
+
+    size_type Byte = static_cast<size_type>(_Word & 0xFF);
+    for (; _Rank > 0; --_Rank)
+    {
+        Byte &= Byte - 1;
+    }
+
+    return Bit + BASE::UTIL::GetLowestBit(Byte);
+}
+
+
+    } // namespace CNT
+} // namespace BASE
+
+
+#endif // __INCLUDE_BIT_VECTOR_H_
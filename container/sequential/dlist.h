@@ -3,7 +3,6 @@
 
 /**
  * todo:
- * - operator=
  * - range functions
  * - ...
  **/
@@ -19,6 +18,7 @@
  ************************************************************************************/
 
 #include <assert.h>
+#include <utility>
 #include "../../memory/allocator.h"
 
 namespace BASE {
@@ -72,15 +72,18 @@ private: // private typedefs
     typedef SLink link_type;
     typedef SNode node_type;
 
-    //typedef typename allocator_type::template SRebind<node_type>::other node_allocator_type;
-    typedef TAllocator<node_type> node_allocator_type;
+    typedef typename allocator_type::template SRebind<node_type>::other node_allocator_type;
 
 public: // ctor, dtor
 
     CDoubleLinkedList(const allocator_type& _Allocator = allocator_type());
-    CDoubleLinkedList(const CDoubleLinkedList<T, TAllocator>& _rList);
+    CDoubleLinkedList(const CDoubleLinkedList<T, TAllocator>& _rList);      // takes over the allocator of _rList
+    CDoubleLinkedList(CDoubleLinkedList<T, TAllocator>&& _rList);           // takes over elements and allocator
     ~CDoubleLinkedList();
 
+    self& operator=(const self& _rList);                                    // keeps the own allocator
+    self& operator=(self&& _rList);                                         // takes over elements and allocator
+
 public: // iterator creation
 
     iterator               Begin();                                         // returns iterator to first element
@@ -106,6 +109,7 @@ public: // list operations
     void Insert(iterator _Pos, const_iterator _First, const_iterator _Last);    // insert elements _First to _Last from another list to _Pos
 
     void Clear();                                                           // clear the list of all inserted elements
+    void Swap(self& _rList);                                                // swap elements and allocators
 
 public: // unintentional
 
@@ -119,13 +123,15 @@ public: // list properties
     bool      IsEmpty() const;                                              // return if list is empty
     size_type GetElementCount() const;                                      // return number of elements in list
 
+    allocator_type GetAllocator() const;                                    // return copy of the allocator
+
 public: // iterator declaration
 
     class CConstIterator
     {
     public:
 
-        friend typename CDoubleLinkedList<T, TAllocator>;
+        friend class CDoubleLinkedList<T, TAllocator>;
 
     public:
 
@@ -169,7 +175,7 @@ public: // iterator declaration
 
         link_type* m_pLink;
 
-    private: // internal operations
+    protected: // internal operations
 
         void Increment();
         void Decrement();
@@ -179,7 +185,7 @@ public: // iterator declaration
     {
     public:
 
-        friend typename CDoubleLinkedList<T, TAllocator>;
+        friend class CDoubleLinkedList<T, TAllocator>;
 
     public:
 
@@ -221,7 +227,7 @@ public: // iterator declaration
     {
     public:
 
-        friend typename CDoubleLinkedList<T, TAllocator>;
+        friend class CDoubleLinkedList<T, TAllocator>;
 
     public:
 
@@ -265,7 +271,7 @@ public: // iterator declaration
 
         link_type* m_pLink;
 
-    private: // internal operations
+    protected: // internal operations
 
         void Increment();
         void Decrement();
@@ -275,7 +281,7 @@ public: // iterator declaration
     {
     public:
 
-        friend typename CDoubleLinkedList<T, TAllocator>;
+        friend class CDoubleLinkedList<T, TAllocator>;
 
     public:
 
@@ -323,6 +329,8 @@ private: // node declaration
 
     struct SNode : public SLink
     {
+        explicit SNode(const value_type& _rElement) : SLink(), m_Element(_rElement) {}
+
         value_type m_Element;
     };
 
@@ -335,6 +343,7 @@ private: // member
 private: // internal methods
 
     iterator GetIteratorByIndex(index_type _Index);
+    void     TakeOver(self& _rList);                                        // move elements of _rList into empty this
 };
 
 /*************************************************************************
@@ -373,7 +382,7 @@ template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::CConstIterator::const_reference
 CDoubleLinkedList<T, TAllocator>::CConstIterator::operator*() const
 {
-    return static_cast<node_type*>(m_pLink)->m_Element;
+    return static_cast<node_type*>(this->m_pLink)->m_Element;
 }
 
 template <typename T, template <typename> class TAllocator>
@@ -453,7 +462,7 @@ template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::CIterator::reference
 CDoubleLinkedList<T, TAllocator>::CIterator::operator*() const
 {
-    return static_cast<node_type*>(m_pLink)->m_Element;
+    return static_cast<node_type*>(this->m_pLink)->m_Element;
 }
 
 template <typename T, template <typename> class TAllocator>
@@ -467,7 +476,7 @@ template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::CIterator
 CDoubleLinkedList<T, TAllocator>::CIterator::operator++()
 {
-    Increment();
+    this->Increment();
     return *this;
 }
 
@@ -476,7 +485,7 @@ typename CDoubleLinkedList<T, TAllocator>::CIterator
 CDoubleLinkedList<T, TAllocator>::CIterator::operator++(int)
 {
     self Temp = *this;
-    Increment();
+    this->Increment();
     return Temp;
 }
 
@@ -484,7 +493,7 @@ template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::CIterator
 CDoubleLinkedList<T, TAllocator>::CIterator::operator--()
 {
-    Decrement();
+    this->Decrement();
     return *this;
 }
 
@@ -493,7 +502,7 @@ typename CDoubleLinkedList<T, TAllocator>::CIterator
 CDoubleLinkedList<T, TAllocator>::CIterator::operator--(int)
 {
     self Temp = *this;
-    Decrement();
+    this->Decrement();
     return Temp;
 }
 
@@ -533,7 +542,7 @@ template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::CConstReverseIterator::const_reference
 CDoubleLinkedList<T, TAllocator>::CConstReverseIterator::operator*() const
 {
-    return static_cast<node_type*>(m_pLink)->m_Element;
+    return static_cast<node_type*>(this->m_pLink)->m_Element;
 }
 
 template <typename T, template <typename> class TAllocator>
@@ -613,7 +622,7 @@ template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::CReverseIterator::reference
 CDoubleLinkedList<T, TAllocator>::CReverseIterator::operator*() const
 {
-    return static_cast<node_type*>(m_pLink)->m_Element;
+    return static_cast<node_type*>(this->m_pLink)->m_Element;
 }
 
 template <typename T, template <typename> class TAllocator>
@@ -664,6 +673,7 @@ CDoubleLinkedList<T, TAllocator>::CReverseIterator::operator--(int)
 template <typename T, template <typename> class TAllocator>
 CDoubleLinkedList<T, TAllocator>::CDoubleLinkedList(const allocator_type& _Allocator)
     : m_Allocator(_Allocator)
+    , m_NodeAllocator(_Allocator)
     , m_Anchor()
 {
     m_Anchor.m_pNext = &m_Anchor;
@@ -672,19 +682,56 @@ CDoubleLinkedList<T, TAllocator>::CDoubleLinkedList(const allocator_type& _Alloc
 
 template <typename T, template <typename> class TAllocator>
 CDoubleLinkedList<T, TAllocator>::CDoubleLinkedList(const self& _rList)
-    : m_Anchor()
+    : m_Allocator(_rList.m_Allocator)
+    , m_NodeAllocator(_rList.m_NodeAllocator)
+    , m_Anchor()
 {
     m_Anchor.m_pNext = &m_Anchor;
     m_Anchor.m_pPrev = &m_Anchor;
     Insert(Begin(), _rList.Begin(), _rList.End());
 }
 
+template <typename T, template <typename> class TAllocator>
+CDoubleLinkedList<T, TAllocator>::CDoubleLinkedList(self&& _rList)
+    : m_Allocator(_rList.m_Allocator)
+    , m_NodeAllocator(_rList.m_NodeAllocator)
+    , m_Anchor()
+{
+    TakeOver(_rList);
+}
+
 template <typename T, template <typename> class TAllocator>
 CDoubleLinkedList<T, TAllocator>::~CDoubleLinkedList()
 {
     Clear();
 }
 
+template <typename T, template <typename> class TAllocator>
+typename CDoubleLinkedList<T, TAllocator>::self&
+CDoubleLinkedList<T, TAllocator>::operator=(const self& _rList)
+{
+    if (this != &_rList)
+    {
+        Clear();
+        Insert(End(), _rList.Begin(), _rList.End());
+    }
+    return *this;
+}
+
+template <typename T, template <typename> class TAllocator>
+typename CDoubleLinkedList<T, TAllocator>::self&
+CDoubleLinkedList<T, TAllocator>::operator=(self&& _rList)
+{
+    if (this != &_rList)
+    {
+        Clear();
+        m_Allocator     = _rList.m_Allocator;
+        m_NodeAllocator = _rList.m_NodeAllocator;
+        TakeOver(_rList);
+    }
+    return *this;
+}
+
 template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::iterator
 CDoubleLinkedList<T, TAllocator>::Begin()
@@ -776,8 +823,7 @@ typename CDoubleLinkedList<T, TAllocator>::iterator
 CDoubleLinkedList<T, TAllocator>::Insert(iterator _Pos, const_reference _rElement)
 {
     node_type* pTemp = m_NodeAllocator.Allocate(1);
-    m_NodeAllocator.Construct(pTemp, node_type());
-    pTemp->m_Element = _rElement;
+    m_NodeAllocator.Construct(pTemp, _rElement);
     pTemp->m_pPrev = _Pos.m_pLink->m_pPrev;
     pTemp->m_pNext = _Pos.m_pLink;
     _Pos.m_pLink->m_pPrev->m_pNext = pTemp;
@@ -840,6 +886,20 @@ CDoubleLinkedList<T, TAllocator>::Clear()
     m_Anchor.m_pNext = &m_Anchor;
 }
 
+template <typename T, template <typename> class TAllocator>
+void
+CDoubleLinkedList<T, TAllocator>::Swap(self& _rList)
+{
+    if (this == &_rList)
+    {
+        return;
+    }
+
+    self Temp(std::move(_rList));
+    _rList = std::move(*this);
+    *this = std::move(Temp);
+}
+
 template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::reference
 CDoubleLinkedList<T, TAllocator>::GetElementAt(index_type _Index)
@@ -870,6 +930,13 @@ CDoubleLinkedList<T, TAllocator>::GetElementCount() const
     return Size;
 }
 
+template <typename T, template <typename> class TAllocator>
+typename CDoubleLinkedList<T, TAllocator>::allocator_type
+CDoubleLinkedList<T, TAllocator>::GetAllocator() const
+{
+    return m_Allocator;
+}
+
 template <typename T, template <typename> class TAllocator>
 typename CDoubleLinkedList<T, TAllocator>::iterator
 CDoubleLinkedList<T, TAllocator>::GetIteratorByIndex(index_type _Index)
@@ -882,6 +949,27 @@ CDoubleLinkedList<T, TAllocator>::GetIteratorByIndex(index_type _Index)
     return It;
 }
 
+template <typename T, template <typename> class TAllocator>
+void
+CDoubleLinkedList<T, TAllocator>::TakeOver(self& _rList)
+{
+    if (_rList.IsEmpty())
+    {
+        m_Anchor.m_pNext = &m_Anchor;
+        m_Anchor.m_pPrev = &m_Anchor;
+        return;
+    }
+
+    // relink first and last node to our anchor, nodes themselves stay in place
+    m_Anchor.m_pNext = _rList.m_Anchor.m_pNext;
+    m_Anchor.m_pPrev = _rList.m_Anchor.m_pPrev;
+    m_Anchor.m_pNext->m_pPrev = &m_Anchor;
+    m_Anchor.m_pPrev->m_pNext = &m_Anchor;
+
+    _rList.m_Anchor.m_pNext = &_rList.m_Anchor;
+    _rList.m_Anchor.m_pPrev = &_rList.m_Anchor;
+}
+
 
     } // namespace CNT
 } // namespace BASE
@@ -0,0 +1,121 @@
+#ifndef __INCLUDE_GROWTH_POLICY_H_
+#define __INCLUDE_GROWTH_POLICY_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * Growth policies decide the new capacity of a full CVector.
+ * A policy is a copyable class with the member
+ *     size_t GetNextCapacity(size_t _Capacity, size_t _MinCapacity) const;
+ * which returns a capacity of at least _MinCapacity. The container keeps
+ * one instance, so policies may carry state.
+ **/
+
+/**
+ * Multiplies the capacity by Numerator / Denominator, doubling by default.
+ * Appending is amortized O(1) and every element is copied at most
+ * Numerator / (Numerator - Denominator) times on average.
+ **/
+template <size_t Numerator = 2, size_t Denominator = 1>
+class CGeometricGrowth
+{
+public: // static constants
+
+    static const size_t s_MinCapacity = 4;                              // first allocation of an empty container
+
+public: // operations
+
+    size_t GetNextCapacity(size_t _Capacity, size_t _MinCapacity) const;
+};
+
+/**
+ * Adds a fixed number of elements, the behaviour CVector used to have.
+ * Appending is O(n) amortized, only useful when memory is very tight
+ * and the final size is roughly known.
+ **/
+class CLinearGrowth
+{
+public: // ctor
+
+    explicit CLinearGrowth(size_t _Increase = 8);
+
+public: // operations
+
+    size_t GetNextCapacity(size_t _Capacity, size_t _MinCapacity) const;
+
+public: // properties
+
+    size_t GetIncrease() const;
+
+private: // member
+
+    size_t m_Increase;
+};
+
+/*************************************************************************
+ * GEOMETRIC GROWTH SUBSECTION
+ *************************************************************************/
+
+template <size_t Numerator, size_t Denominator>
+size_t
+CGeometricGrowth<Numerator, Denominator>::GetNextCapacity(size_t _Capacity, size_t _MinCapacity) const
+{
+    static_assert(Numerator > Denominator, "geometric growth needs a factor above one");
+
+    size_t Capacity = _Capacity / Denominator * Numerator + _Capacity % Denominator * Numerator / Denominator;
+
+    if (Capacity < s_MinCapacity)
+    {
+        Capacity = s_MinCapacity;
+    }
+    if (Capacity < _Capacity)
+    { // overflow
+        Capacity = static_cast<size_t>(-1);
+    }
+
+    return Capacity > _MinCapacity ? Capacity : _MinCapacity;
+}
+
+/*************************************************************************
+ * LINEAR GROWTH SUBSECTION
+ *************************************************************************/
+
+inline
+CLinearGrowth::CLinearGrowth(size_t _Increase)
+    : m_Increase(_Increase > 0 ? _Increase : 1)
+{
+}
+
+inline size_t
+CLinearGrowth::GetNextCapacity(size_t _Capacity, size_t _MinCapacity) const
+{
+    size_t Capacity = _Capacity + m_Increase;
+    return Capacity > _MinCapacity ? Capacity : _MinCapacity;
+}
+
+inline size_t
+CLinearGrowth::GetIncrease() const
+{
+    return m_Increase;
+}
+
+
+    } // namespace CNT
+} // namespace BASE
+
+
+#endif // __INCLUDE_GROWTH_POLICY_H_
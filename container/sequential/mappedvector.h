@@ -0,0 +1,443 @@
+#ifndef __INCLUDE_MAPPED_VECTOR_H_
+#define __INCLUDE_MAPPED_VECTOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "vector.h"
+#include "../../typetraits/is_trivially_copyable.h"
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * Header in front of the elements of a CMappedVector file.
+ * All fields are in the byte order of the writing machine, the elements
+ * start at m_DataOffset, a multiple of m_Alignment.
+ **/
+struct SMappedVectorHeader
+{
+    static const uint64_t s_Magic   = 0x4D415044564543ULL;              // "MAPDVEC"
+    static const uint32_t s_Version = 1;
+
+    uint64_t m_Magic;
+    uint32_t m_Version;
+    uint32_t m_HeaderSize;
+    uint64_t m_ElementSize;
+    uint64_t m_Count;
+    uint64_t m_Alignment;
+    uint64_t m_DataOffset;
+};
+
+/**
+ * Access pattern hints for the pages of a CMappedVector.
+ **/
+enum EMappedAccess
+{
+    MappedAccessNormal,
+    MappedAccessSequential,                                             // read ahead aggressively, drop pages behind
+    MappedAccessRandom,                                                 // no read ahead
+    MappedAccessWillNeed,                                               // start loading all pages now
+};
+
+/**
+ * Read-only view of an array of trivially copyable elements stored in a file.
+ * Opening maps the file and checks its header, no element is read until it
+ * is accessed, so a table of any size opens in constant time. The file is
+ * written by Write, from a CVector or any contiguous array:
+ *     CMappedVector<SFeature>::Write("features.bin", Features);
+ *     CMappedVector<SFeature> Table("features.bin");
+ * Errors while opening or writing throw std::runtime_error. Elements and
+ * iterators stay valid as long as the view lives, the file must not be
+ * changed meanwhile. Write goes through a temporary file, which replaces the
+ * old one only when complete, so readers never map a half written table and
+ * open views keep the old contents.
+ **/
+template <typename TValue>
+class CMappedVector
+{
+public: // typedefs
+
+    typedef CMappedVector<TValue> self_type;
+
+    typedef TValue            value_type;
+    typedef const value_type& value_const_reference_type;
+    typedef const value_type* value_const_pointer_type;
+
+    typedef size_t size_type;
+
+    typedef value_const_pointer_type const_iterator;
+
+    static const size_type s_Alignment = (alignof(TValue) > 64) ? alignof(TValue) : 64;  // of the data inside the file
+
+public: // ctor, dtor
+
+    CMappedVector();                                                        // empty, maps nothing
+    explicit CMappedVector(const char* _pPath);
+    CMappedVector(self_type&& _rVector);
+    ~CMappedVector();
+
+    self_type& operator=(self_type&& _rVector);
+
+public: // iterator creation
+
+    const_iterator Begin() const;
+    const_iterator End() const;
+
+public: // operations
+
+    value_const_reference_type operator[](size_type _Index) const throw();
+    value_const_reference_type At(size_type _Index) const;
+
+    void Advise(EMappedAccess _Access) const;                               // a hint, failures are ignored
+    void Swap(self_type& _rVector);
+
+    template <template <typename> class TAllocator, typename TGrowthPolicy>
+    static void Write(const char* _pPath, const CVector<TValue, TAllocator, TGrowthPolicy>& _rVector);
+    static void Write(const char* _pPath, value_const_pointer_type _pData, size_type _Count);
+
+public: // properties
+
+    size_type                GetCount() const;
+    bool                     IsEmpty() const;
+    value_const_pointer_type GetData() const;                               // aligned to s_Alignment
+
+private: // non-copyable
+
+    CMappedVector(const self_type&);
+    self_type& operator=(const self_type&);
+
+private: // internal operations
+
+    void Close();
+
+private: // member
+
+    static_assert(BASE::TYPET::SIsTriviallyCopyable<TValue>::Result, "mapped elements are taken from the file as they are");
+
+    const char*              m_pMapping;
+    size_type                m_MappingSize;
+    value_const_pointer_type m_pData;
+    size_type                m_Count;
+};
+
+/*************************************************************************
+ * MAPPED VECTOR SUBSECTION
+ *************************************************************************/
+
+template <typename TValue>
+CMappedVector<TValue>::CMappedVector()
+    : m_pMapping(0)
+    , m_MappingSize(0)
+    , m_pData(0)
+    , m_Count(0)
+{
+}
+
+template <typename TValue>
+CMappedVector<TValue>::CMappedVector(const char* _pPath)
+    : m_pMapping(0)
+    , m_MappingSize(0)
+    , m_pData(0)
+    , m_Count(0)
+{
+    // the handles can go right away, the mapping keeps the file open
+#ifdef _WIN32
+    HANDLE File = CreateFileA(_pPath, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (File == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("cannot open mapped vector file");
+    }
+
+    LARGE_INTEGER Size;
+    if (!GetFileSizeEx(File, &Size) || static_cast<uint64_t>(Size.QuadPart) < sizeof(SMappedVectorHeader) || static_cast<uint64_t>(Size.QuadPart) > static_cast<size_t>(-1))
+    {
+        CloseHandle(File);
+        throw std::runtime_error("mapped vector file is truncated");
+    }
+
+    HANDLE Mapping = CreateFileMappingA(File, 0, PAGE_READONLY, 0, 0, 0);
+    m_MappingSize  = static_cast<size_type>(Size.QuadPart);
+    m_pMapping     = (Mapping != 0) ? static_cast<const char*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0)) : 0;
+
+    if (Mapping != 0)
+    {
+        CloseHandle(Mapping);
+    }
+    CloseHandle(File);
+#else
+    int File = open(_pPath, O_RDONLY);
+    if (File < 0)
+    {
+        throw std::runtime_error("cannot open mapped vector file");
+    }
+
+    struct stat Status;
+    if (fstat(File, &Status) != 0 || static_cast<uint64_t>(Status.st_size) < sizeof(SMappedVectorHeader) || static_cast<uint64_t>(Status.st_size) > static_cast<size_t>(-1))
+    {
+        close(File);
+        throw std::runtime_error("mapped vector file is truncated");
+    }
+
+    m_MappingSize = static_cast<size_type>(Status.st_size);
+    void* pMem    = mmap(0, m_MappingSize, PROT_READ, MAP_SHARED, File, 0);
+    m_pMapping    = (pMem != MAP_FAILED) ? static_cast<const char*>(pMem) : 0;
+
+    close(File);
+#endif
+
+    if (m_pMapping == 0)
+    {
+        throw std::runtime_error("cannot map mapped vector file");
+    }
+
+    const SMappedVectorHeader* pHeader = reinterpret_cast<const SMappedVectorHeader*>(m_pMapping);
+
+    if (pHeader->m_Magic != SMappedVectorHeader::s_Magic || pHeader->m_Version != SMappedVectorHeader::s_Version || pHeader->m_HeaderSize != sizeof(SMappedVectorHeader))
+    {
+        Close();
+        throw std::runtime_error("not a mapped vector file");
+    }
+
+    if (pHeader->m_ElementSize != sizeof(TValue) || pHeader->m_DataOffset % alignof(TValue) != 0)
+    {
+        Close();
+        throw std::runtime_error("mapped vector file holds a different element type");
+    }
+
+    // compared by division, a forged count must not overflow the product
+    if (pHeader->m_DataOffset > m_MappingSize || (m_MappingSize - pHeader->m_DataOffset) / sizeof(TValue) < pHeader->m_Count)
+    {
+        Close();
+        throw std::runtime_error("mapped vector file is truncated");
+    }
+
+    m_pData = reinterpret_cast<value_const_pointer_type>(m_pMapping + pHeader->m_DataOffset);
+    m_Count = static_cast<size_type>(pHeader->m_Count);
+}
+
+template <typename TValue>
+CMappedVector<TValue>::CMappedVector(self_type&& _rVector)
+    : m_pMapping(_rVector.m_pMapping)
+    , m_MappingSize(_rVector.m_MappingSize)
+    , m_pData(_rVector.m_pData)
+    , m_Count(_rVector.m_Count)
+{
+    _rVector.m_pMapping    = 0;
+    _rVector.m_MappingSize = 0;
+    _rVector.m_pData       = 0;
+    _rVector.m_Count       = 0;
+}
+
+template <typename TValue>
+CMappedVector<TValue>::~CMappedVector()
+{
+    Close();
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::self_type& CMappedVector<TValue>::operator=(self_type&& _rVector)
+{
+    if (this != &_rVector)
+    {
+        Close();
+        Swap(_rVector);
+    }
+
+    return *this;
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::const_iterator CMappedVector<TValue>::Begin() const
+{
+    return m_pData;
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::const_iterator CMappedVector<TValue>::End() const
+{
+    return m_pData + m_Count;
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::value_const_reference_type CMappedVector<TValue>::operator[](size_type _Index) const throw()
+{
+    return *(m_pData + _Index);
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::value_const_reference_type CMappedVector<TValue>::At(size_type _Index) const
+{
+    if (_Index >= m_Count)
+    {
+        throw std::out_of_range("index out of range");
+    }
+
+    return *(m_pData + _Index);
+}
+
+template <typename TValue>
+void CMappedVector<TValue>::Advise(EMappedAccess _Access) const
+{
+    if (m_pMapping == 0)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    // only prefetching has a counterpart, and only from Windows 8 on
+#   if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    if (_Access == MappedAccessWillNeed)
+    {
+        WIN32_MEMORY_RANGE_ENTRY Range;
+        Range.VirtualAddress = const_cast<char*>(m_pMapping);
+        Range.NumberOfBytes  = m_MappingSize;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &Range, 0);
+    }
+#   else
+    (void)_Access;
+#   endif
+#else
+    static const int s_Advice[] = { POSIX_MADV_NORMAL, POSIX_MADV_SEQUENTIAL, POSIX_MADV_RANDOM, POSIX_MADV_WILLNEED };
+
+    posix_madvise(const_cast<char*>(m_pMapping), m_MappingSize, s_Advice[_Access]);
+#endif
+}
+
+template <typename TValue>
+void CMappedVector<TValue>::Swap(self_type& _rVector)
+{
+    std::swap(m_pMapping, _rVector.m_pMapping);
+    std::swap(m_MappingSize, _rVector.m_MappingSize);
+    std::swap(m_pData, _rVector.m_pData);
+    std::swap(m_Count, _rVector.m_Count);
+}
+
+template <typename TValue>
+template <template <typename> class TAllocator, typename TGrowthPolicy>
+void CMappedVector<TValue>::Write(const char* _pPath, const CVector<TValue, TAllocator, TGrowthPolicy>& _rVector)
+{
+    Write(_pPath, _rVector.GetData(), _rVector.GetCount());
+}
+
+template <typename TValue>
+void CMappedVector<TValue>::Write(const char* _pPath, value_const_pointer_type _pData, size_type _Count)
+{
+    static const char s_Padding[s_Alignment] = {};
+
+    SMappedVectorHeader Header;
+    Header.m_Magic       = SMappedVectorHeader::s_Magic;
+    Header.m_Version     = SMappedVectorHeader::s_Version;
+    Header.m_HeaderSize  = sizeof(SMappedVectorHeader);
+    Header.m_ElementSize = sizeof(TValue);
+    Header.m_Count       = _Count;
+    Header.m_Alignment   = s_Alignment;
+    Header.m_DataOffset  = (sizeof(SMappedVectorHeader) + s_Alignment - 1) / s_Alignment * s_Alignment;
+
+    std::string TempPath = std::string(_pPath) + ".tmp";
+
+    FILE* pFile = fopen(TempPath.c_str(), "wb");
+    if (pFile == 0)
+    {
+        throw std::runtime_error("cannot create mapped vector file");
+    }
+
+    size_t PaddingSize = static_cast<size_t>(Header.m_DataOffset) - sizeof(SMappedVectorHeader);
+
+    bool IsWritten = fwrite(&Header, sizeof(Header), 1, pFile) == 1
+        && fwrite(s_Padding, 1, PaddingSize, pFile) == PaddingSize
+        && (_Count == 0 || fwrite(_pData, sizeof(TValue), _Count, pFile) == _Count)
+        && fflush(pFile) == 0;
+
+#ifndef _WIN32
+    // the data has to be on disk before the rename makes it visible
+    IsWritten = IsWritten && fsync(fileno(pFile)) == 0;
+#endif
+
+    if (fclose(pFile) != 0 || !IsWritten)
+    {
+        remove(TempPath.c_str());
+        throw std::runtime_error("cannot write mapped vector file");
+    }
+
+#ifdef _WIN32
+    bool IsReplaced = MoveFileExA(TempPath.c_str(), _pPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool IsReplaced = rename(TempPath.c_str(), _pPath) == 0;
+#endif
+
+    if (!IsReplaced)
+    {
+        remove(TempPath.c_str());
+        throw std::runtime_error("cannot replace mapped vector file");
+    }
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::size_type CMappedVector<TValue>::GetCount() const
+{
+    return m_Count;
+}
+
+template <typename TValue>
+bool CMappedVector<TValue>::IsEmpty() const
+{
+    return m_Count == 0;
+}
+
+template <typename TValue>
+typename CMappedVector<TValue>::value_const_pointer_type CMappedVector<TValue>::GetData() const
+{
+    return m_pData;
+}
+
+template <typename TValue>
+void CMappedVector<TValue>::Close()
+{
+    if (m_pMapping != 0)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_pMapping);
+#else
+        munmap(const_cast<char*>(m_pMapping), m_MappingSize);
+#endif
+    }
+
+    m_pMapping    = 0;
+    m_MappingSize = 0;
+    m_pData       = 0;
+    m_Count       = 0;
+}
+
+
+    } // namespace CNT
+} // namespace BASE
+
+
+#endif // __INCLUDE_MAPPED_VECTOR_H_
@@ -0,0 +1,133 @@
+#ifndef __INCLUDE_SMALL_VECTOR_H_
+#define __INCLUDE_SMALL_VECTOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <utility>
+#include "vector.h"
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * CVector keeping up to InlineCount elements inside the object.
+ * Only a vector growing beyond that asks the allocator for memory, shrinking
+ * (ShrinkToFit, moving the elements away) returns to the inline storage.
+ * Everything else, iterators included, is CVector, so a CSmallVector can be
+ * passed wherever a CVector reference is expected.
+ * Moving or swapping a vector whose elements are inline moves the elements
+ * one by one instead of stealing the block.
+ **/
+template <
+    typename TValue,
+    size_t InlineCount,
+    template <typename> class TAllocator = BASE::MEM::CAllocator,
+    typename TGrowthPolicy = CGeometricGrowth<>
+>
+class CSmallVector : public CVector<TValue, TAllocator, TGrowthPolicy>
+{
+public: // typedefs
+
+    typedef CVector<TValue, TAllocator, TGrowthPolicy>                   base_type;
+    typedef CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy> self_type;
+
+    typedef typename base_type::value_type               value_type;
+    typedef typename base_type::value_pointer_type       value_pointer_type;
+    typedef typename base_type::value_const_pointer_type value_const_pointer_type;
+    typedef typename base_type::size_type                size_type;
+    typedef typename base_type::allocator_type           allocator_type;
+    typedef typename base_type::growth_policy_type       growth_policy_type;
+
+    static const size_type s_InlineCount = InlineCount;
+
+public: // ctor, dtor
+
+    explicit CSmallVector(const allocator_type& _Allocator = allocator_type());    // does not allocate
+    CSmallVector(const self_type& _rVector);                                // takes over the allocator of _rVector
+    CSmallVector(const base_type& _rVector);
+    CSmallVector(self_type&& _rVector);                                     // takes over elements and allocator
+    CSmallVector(base_type&& _rVector);
+    self_type& operator=(const self_type& _rVector);                        // keeps the own allocator
+    self_type& operator=(self_type&& _rVector);                             // takes over elements and allocator
+
+public: // properties
+
+    using base_type::IsInline;
+
+private: // member
+
+    static_assert(InlineCount > 0, "use CVector for vectors without inline storage");
+
+    alignas(TValue) alignas(base_type::s_Alignment) char m_Storage[InlineCount * sizeof(TValue)];
+};
+
+/*************************************************************************
+ * SMALL VECTOR SUBSECTION
+ *************************************************************************/
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::CSmallVector(const allocator_type& _Allocator)
+    : base_type(reinterpret_cast<value_pointer_type>(m_Storage), InlineCount, growth_policy_type(), _Allocator)
+{
+}
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::CSmallVector(const self_type& _rVector)
+    : base_type(reinterpret_cast<value_pointer_type>(m_Storage), InlineCount, _rVector.GetGrowthPolicy(), _rVector.GetAllocator())
+{
+    this->Assign(_rVector.GetData(), _rVector.GetData() + _rVector.GetCount());
+}
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::CSmallVector(const base_type& _rVector)
+    : base_type(reinterpret_cast<value_pointer_type>(m_Storage), InlineCount, _rVector.GetGrowthPolicy(), _rVector.GetAllocator())
+{
+    this->Assign(_rVector.GetData(), _rVector.GetData() + _rVector.GetCount());
+}
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::CSmallVector(self_type&& _rVector)
+    : base_type(reinterpret_cast<value_pointer_type>(m_Storage), InlineCount, _rVector.GetGrowthPolicy(), _rVector.GetAllocator())
+{
+    base_type::operator=(std::move(_rVector));
+}
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::CSmallVector(base_type&& _rVector)
+    : base_type(reinterpret_cast<value_pointer_type>(m_Storage), InlineCount, _rVector.GetGrowthPolicy(), _rVector.GetAllocator())
+{
+    base_type::operator=(std::move(_rVector));
+}
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::self_type&
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::operator=(const self_type& _rVector)
+{
+    base_type::operator=(_rVector);
+    return *this;
+}
+
+template <typename TValue, size_t InlineCount, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::self_type&
+CSmallVector<TValue, InlineCount, TAllocator, TGrowthPolicy>::operator=(self_type&& _rVector)
+{
+    base_type::operator=(std::move(_rVector));
+    return *this;
+}
+
+
+    } // namespace CNT
+} // namespace BASE
+
+
+#endif // __INCLUDE_SMALL_VECTOR_H_
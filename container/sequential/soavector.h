@@ -0,0 +1,1048 @@
+#ifndef __INCLUDE_SOA_VECTOR_H_
+#define __INCLUDE_SOA_VECTOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "../iterator/iterator.h"
+#include "growthpolicy.h"
+#include "span.h"
+#include "../../memory/alignment.h"
+#include "../../typetraits/index_list.h"
+#include "../../typetraits/is_trivially_relocatable.h"
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * Vector of records stored as structure of arrays: every field lives in
+ * its own contiguous column, each column starts on a cache line.
+ * A loop over one field only touches that field's memory and vectorizes
+ * like a loop over an array:
+ *     CSoaVector<float, float, int> Particles;
+ *     Particles.PushBack(1.0f, 2.0f, 3);
+ *     CSpan<float> X = Particles.GetColumn<0>();
+ * Rows are read and written through proxies (CRowReference), iterators
+ * are random access and yield these proxies. All columns share one block,
+ * growing moves every column, which invalidates spans and references.
+ **/
+template <typename... TFields>
+class CSoaVector
+{
+public: // forward declarations
+
+    class CConstRowReference;
+    class CRowReference;
+    class CConstIterator;
+    class CIterator;
+
+public: // typedefs
+
+    typedef CSoaVector<TFields...> self_type;
+
+    typedef std::tuple<TFields...> value_type;
+
+    typedef size_t size_type;
+
+    typedef CIterator                        iterator;
+    typedef CConstIterator                   const_iterator;
+    typedef CReverseIterator<iterator>       reverse_iterator;
+    typedef CReverseIterator<const_iterator> const_reverse_iterator;
+
+    typedef CGeometricGrowth<> growth_policy_type;
+
+    template <size_t Column>
+    struct SColumn
+    {
+        typedef typename std::tuple_element<Column, value_type>::type type;
+    };
+
+    static const size_type s_ColumnCount = sizeof...(TFields);
+    static const size_type s_Alignment   = BASE::MEM::s_CacheLineSize;     // guaranteed alignment of every column
+
+public: // ctor, dtor
+
+    CSoaVector();                                                           // does not allocate
+    explicit CSoaVector(size_type _Capacity);
+    CSoaVector(const self_type& _rVector);
+    CSoaVector(self_type&& _rVector);
+    self_type& operator=(const self_type& _rVector);
+    self_type& operator=(self_type&& _rVector);
+
+    ~CSoaVector();
+
+public: // iterator creation
+
+    iterator       Begin();
+    const_iterator Begin() const;
+    iterator       End();
+    const_iterator End() const;
+
+public: // operations
+
+    void PushBack(const TFields&... _Fields);
+    void PushBack(const value_type& _rRow);
+    void PopBack();
+    void Clear();
+
+    CRowReference      operator[](size_type _Index);
+    CConstRowReference operator[](size_type _Index) const;
+
+    template <size_t Column>
+    typename SColumn<Column>::type& Get(size_type _Index);
+    template <size_t Column>
+    const typename SColumn<Column>::type& Get(size_type _Index) const;
+
+    value_type GetRow(size_type _Index) const;                              // copies the fields into a tuple
+    void       SetRow(size_type _Index, const value_type& _rRow);
+
+    void Reserve(size_type _Capacity);                                      // capacity becomes at least _Capacity
+    void Resize(size_type _Count);                                          // new rows are value initialized
+
+    void Swap(self_type& _rVector);
+
+public: // properties
+
+    size_type GetCount() const;
+    size_type GetCapacity() const;
+
+    template <size_t Column>
+    CSpan<typename SColumn<Column>::type> GetColumn();                      // contiguous, aligned to s_Alignment
+    template <size_t Column>
+    CSpan<const typename SColumn<Column>::type> GetColumn() const;
+
+public: // row reference declaration
+
+    class CConstRowReference
+    {
+    public:
+
+        friend class CSoaVector<TFields...>;
+
+    public:
+
+        template <size_t Column>
+        const typename SColumn<Column>::type& Get() const;
+
+        operator value_type() const;
+
+    private:
+
+        CConstRowReference(const CSoaVector<TFields...>* _pVector, size_type _Index);
+
+    private: // member
+
+        const CSoaVector<TFields...>* m_pVector;
+        size_type                     m_Index;
+    };
+
+    class CRowReference
+    {
+    public:
+
+        friend class CSoaVector<TFields...>;
+
+    public:
+
+        CRowReference(const CRowReference& _rRow);
+        const CRowReference& operator=(const CRowReference& _rRow) const;   // assigns the fields, not the proxy
+        const CRowReference& operator=(const value_type& _rRow) const;
+
+        template <size_t Column>
+        typename SColumn<Column>::type& Get() const;
+
+        operator value_type() const;
+        operator CConstRowReference() const;
+
+    private:
+
+        CRowReference(CSoaVector<TFields...>* _pVector, size_type _Index);
+
+    private: // member
+
+        CSoaVector<TFields...>* m_pVector;
+        size_type               m_Index;
+    };
+
+public: // iterator declaration
+
+    class CConstIterator : public SIterator<SRandomAccessIteratorTag, std::tuple<TFields...>, ptrdiff_t, void, CConstRowReference>
+    {
+    public:
+
+        friend class CSoaVector<TFields...>;
+
+    public:
+
+        typedef CConstIterator                                                                              self_type;
+        typedef SIterator<SRandomAccessIteratorTag, std::tuple<TFields...>, ptrdiff_t, void, CConstRowReference> base_type;
+
+        typedef typename base_type::iterator_tag_type    iterator_tag_type;
+        typedef typename base_type::value_type           value_type;
+        typedef typename base_type::value_reference_type value_reference_type;
+        typedef typename base_type::difference_type      difference_type;
+
+    public: // ctor
+
+        CConstIterator(const self_type& _rIt);
+
+    protected: // private ctor
+
+        CConstIterator(const CSoaVector<TFields...>* _pVector, size_type _Index);
+
+    public: // operations
+
+        const bool operator==(const self_type& _rRhs) const;
+        const bool operator!=(const self_type& _rRhs) const;
+        const bool operator<(const self_type& _rRhs) const;
+
+        value_reference_type operator*() const;
+
+        self_type&      operator++();
+        const self_type operator++(int);
+        self_type&      operator--();
+        const self_type operator--(int);
+
+        const self_type& operator+=(difference_type _Off);
+        self_type        operator+(difference_type _Off) const;
+        const self_type& operator-=(difference_type _Off);
+        self_type        operator-(difference_type _Off) const;
+        difference_type  operator-(const self_type& _rRhs) const;
+
+    protected: // member
+
+        CSoaVector<TFields...>* m_pVector;                                  // const-ness is restored by the reference type
+        size_type               m_Index;
+    };
+
+    class CIterator : public CConstIterator
+    {
+    public:
+
+        friend class CSoaVector<TFields...>;
+
+    public:
+
+        typedef CIterator     self_type;
+        typedef CRowReference value_reference_type;
+
+        typedef typename CConstIterator::difference_type difference_type;
+
+    public: // ctor
+
+        CIterator(const self_type& _rIt);
+
+    private: // private ctor
+
+        CIterator(CSoaVector<TFields...>* _pVector, size_type _Index);
+
+    public: // operations
+
+        value_reference_type operator*() const;
+
+        self_type&      operator++();
+        const self_type operator++(int);
+        self_type&      operator--();
+        const self_type operator--(int);
+
+        const self_type& operator+=(difference_type _Off);
+        self_type        operator+(difference_type _Off) const;
+        const self_type& operator-=(difference_type _Off);
+        self_type        operator-(difference_type _Off) const;
+        difference_type  operator-(const CConstIterator& _rRhs) const;
+    };
+
+private: // internal typedefs
+
+    typedef typename BASE::TYPET::SMakeIndexList<sizeof...(TFields)>::type index_list;
+    typedef std::tuple<TFields*...>                                       column_pointers;
+
+private: // internal operations
+
+    void Grow(size_type _MinCapacity);
+    void Reallocate(size_type _Capacity);                                   // capacity becomes exactly _Capacity
+
+    static size_type GetLayout(size_type _Capacity, size_type* _pOffsets);  // block size, offsets of the columns
+
+    template <size_t... Indices>
+    static column_pointers GetColumns(char* _pBlock, const size_type* _pOffsets, BASE::TYPET::SIndexList<Indices...>);
+
+    template <size_t... Indices>
+    void PushRow(const value_type& _rRow, BASE::TYPET::SIndexList<Indices...>);
+    template <size_t... Indices>
+    void ConstructBack(BASE::TYPET::SIndexList<Indices...>, const TFields&... _Fields);
+    template <size_t... Indices>
+    void ConstructDefault(size_type _First, size_type _Last, BASE::TYPET::SIndexList<Indices...>);
+    template <size_t... Indices>
+    void CopyRows(const self_type& _rVector, BASE::TYPET::SIndexList<Indices...>);
+    template <size_t... Indices>
+    void DestroyRows(size_type _First, size_type _Last, BASE::TYPET::SIndexList<Indices...>);
+    template <size_t... Indices>
+    void RelocateRows(const column_pointers& _rTarget, BASE::TYPET::SIndexList<Indices...>);
+    template <size_t... Indices>
+    value_type GetRow(size_type _Index, BASE::TYPET::SIndexList<Indices...>) const;
+    template <size_t... Indices>
+    void SetRow(size_type _Index, const value_type& _rRow, BASE::TYPET::SIndexList<Indices...>);
+
+    template <typename T>
+    static void CopyColumn(T* _pTarget, const T* _pSource, size_type _Count, std::true_type);      // memcpy
+    template <typename T>
+    static void CopyColumn(T* _pTarget, const T* _pSource, size_type _Count, std::false_type);
+    template <typename T>
+    static void RelocateColumn(T* _pTarget, T* _pSource, size_type _Count, std::true_type);        // memcpy, sources are gone
+    template <typename T>
+    static void RelocateColumn(T* _pTarget, T* _pSource, size_type _Count, std::false_type);
+    template <typename T>
+    static void DestroyColumn(T* _pFirst, T* _pLast);
+
+private: // member
+
+    growth_policy_type m_GrowthPolicy;
+    size_type          m_Capacity;
+    size_type          m_ElementCount;
+    char*              m_pBlock;
+    column_pointers    m_Columns;
+
+    static_assert(sizeof...(TFields) > 0, "a structure of arrays needs at least one field");
+};
+
+/*************************************************************************
+ * CONST ROW REFERENCE SUBSECTION
+ *************************************************************************/
+
+template <typename... TFields>
+CSoaVector<TFields...>::CConstRowReference::CConstRowReference(const CSoaVector<TFields...>* _pVector, size_type _Index)
+    : m_pVector(_pVector)
+    , m_Index(_Index)
+{
+}
+
+template <typename... TFields>
+template <size_t Column>
+const typename CSoaVector<TFields...>::template SColumn<Column>::type&
+CSoaVector<TFields...>::CConstRowReference::Get() const
+{
+    return m_pVector->template Get<Column>(m_Index);
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CConstRowReference::operator value_type() const
+{
+    return m_pVector->GetRow(m_Index);
+}
+
+/*************************************************************************
+ * ROW REFERENCE SUBSECTION
+ *************************************************************************/
+
+template <typename... TFields>
+CSoaVector<TFields...>::CRowReference::CRowReference(CSoaVector<TFields...>* _pVector, size_type _Index)
+    : m_pVector(_pVector)
+    , m_Index(_Index)
+{
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CRowReference::CRowReference(const CRowReference& _rRow)
+    : m_pVector(_rRow.m_pVector)
+    , m_Index(_rRow.m_Index)
+{
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CRowReference&
+CSoaVector<TFields...>::CRowReference::operator=(const CRowReference& _rRow) const
+{
+    return (*this = static_cast<value_type>(_rRow));
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CRowReference&
+CSoaVector<TFields...>::CRowReference::operator=(const value_type& _rRow) const
+{
+    m_pVector->SetRow(m_Index, _rRow);
+    return *this;
+}
+
+template <typename... TFields>
+template <size_t Column>
+typename CSoaVector<TFields...>::template SColumn<Column>::type&
+CSoaVector<TFields...>::CRowReference::Get() const
+{
+    return m_pVector->template Get<Column>(m_Index);
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CRowReference::operator value_type() const
+{
+    return m_pVector->GetRow(m_Index);
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CRowReference::operator CConstRowReference() const
+{
+    return CConstRowReference(m_pVector, m_Index);
+}
+
+/*************************************************************************
+ * CONST ITERATOR SUBSECTION
+ *************************************************************************/
+
+template <typename... TFields>
+CSoaVector<TFields...>::CConstIterator::CConstIterator(const CSoaVector<TFields...>* _pVector, size_type _Index)
+    : m_pVector(const_cast<CSoaVector<TFields...>*>(_pVector))
+    , m_Index(_Index)
+{
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CConstIterator::CConstIterator(const self_type& _rIt)
+    : m_pVector(_rIt.m_pVector)
+    , m_Index(_rIt.m_Index)
+{
+}
+
+template <typename... TFields>
+const bool
+CSoaVector<TFields...>::CConstIterator::operator==(const self_type& _rRhs) const
+{
+    return m_Index == _rRhs.m_Index;
+}
+
+template <typename... TFields>
+const bool
+CSoaVector<TFields...>::CConstIterator::operator!=(const self_type& _rRhs) const
+{
+    return m_Index != _rRhs.m_Index;
+}
+
+template <typename... TFields>
+const bool
+CSoaVector<TFields...>::CConstIterator::operator<(const self_type& _rRhs) const
+{
+    return m_Index < _rRhs.m_Index;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstIterator::value_reference_type
+CSoaVector<TFields...>::CConstIterator::operator*() const
+{
+    return CConstRowReference(m_pVector, m_Index);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstIterator::self_type&
+CSoaVector<TFields...>::CConstIterator::operator++()
+{
+    ++m_Index;
+    return *this;
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CConstIterator::self_type
+CSoaVector<TFields...>::CConstIterator::operator++(int)
+{
+    self_type Temp(*this);
+    ++m_Index;
+    return Temp;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstIterator::self_type&
+CSoaVector<TFields...>::CConstIterator::operator--()
+{
+    --m_Index;
+    return *this;
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CConstIterator::self_type
+CSoaVector<TFields...>::CConstIterator::operator--(int)
+{
+    self_type Temp(*this);
+    --m_Index;
+    return Temp;
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CConstIterator::self_type&
+CSoaVector<TFields...>::CConstIterator::operator+=(difference_type _Off)
+{
+    m_Index += _Off;
+    return *this;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstIterator::self_type
+CSoaVector<TFields...>::CConstIterator::operator+(difference_type _Off) const
+{
+    return self_type(m_pVector, m_Index + _Off);
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CConstIterator::self_type&
+CSoaVector<TFields...>::CConstIterator::operator-=(difference_type _Off)
+{
+    m_Index -= _Off;
+    return *this;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstIterator::self_type
+CSoaVector<TFields...>::CConstIterator::operator-(difference_type _Off) const
+{
+    return self_type(m_pVector, m_Index - _Off);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstIterator::difference_type
+CSoaVector<TFields...>::CConstIterator::operator-(const self_type& _rRhs) const
+{
+    return static_cast<difference_type>(m_Index) - static_cast<difference_type>(_rRhs.m_Index);
+}
+
+/*************************************************************************
+ * ITERATOR SUBSECTION
+ *************************************************************************/
+
+template <typename... TFields>
+CSoaVector<TFields...>::CIterator::CIterator(CSoaVector<TFields...>* _pVector, size_type _Index)
+    : CConstIterator(_pVector, _Index)
+{
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CIterator::CIterator(const self_type& _rIt)
+    : CConstIterator(_rIt)
+{
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CIterator::value_reference_type
+CSoaVector<TFields...>::CIterator::operator*() const
+{
+    return CRowReference(this->m_pVector, this->m_Index);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CIterator::self_type&
+CSoaVector<TFields...>::CIterator::operator++()
+{
+    ++this->m_Index;
+    return *this;
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CIterator::self_type
+CSoaVector<TFields...>::CIterator::operator++(int)
+{
+    self_type Temp(*this);
+    ++this->m_Index;
+    return Temp;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CIterator::self_type&
+CSoaVector<TFields...>::CIterator::operator--()
+{
+    --this->m_Index;
+    return *this;
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CIterator::self_type
+CSoaVector<TFields...>::CIterator::operator--(int)
+{
+    self_type Temp(*this);
+    --this->m_Index;
+    return Temp;
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CIterator::self_type&
+CSoaVector<TFields...>::CIterator::operator+=(difference_type _Off)
+{
+    this->m_Index += _Off;
+    return *this;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CIterator::self_type
+CSoaVector<TFields...>::CIterator::operator+(difference_type _Off) const
+{
+    return self_type(this->m_pVector, this->m_Index + _Off);
+}
+
+template <typename... TFields>
+const typename CSoaVector<TFields...>::CIterator::self_type&
+CSoaVector<TFields...>::CIterator::operator-=(difference_type _Off)
+{
+    this->m_Index -= _Off;
+    return *this;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CIterator::self_type
+CSoaVector<TFields...>::CIterator::operator-(difference_type _Off) const
+{
+    return self_type(this->m_pVector, this->m_Index - _Off);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CIterator::difference_type
+CSoaVector<TFields...>::CIterator::operator-(const CConstIterator& _rRhs) const
+{
+    return CConstIterator::operator-(_rRhs);
+}
+
+/*************************************************************************
+ * SOA VECTOR SUBSECTION
+ *************************************************************************/
+
+template <typename... TFields>
+CSoaVector<TFields...>::CSoaVector()
+    : m_GrowthPolicy()
+    , m_Capacity(0)
+    , m_ElementCount(0)
+    , m_pBlock(0)
+    , m_Columns()
+{
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CSoaVector(size_type _Capacity)
+    : m_GrowthPolicy()
+    , m_Capacity(0)
+    , m_ElementCount(0)
+    , m_pBlock(0)
+    , m_Columns()
+{
+    Reserve(_Capacity);
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CSoaVector(const self_type& _rVector)
+    : m_GrowthPolicy(_rVector.m_GrowthPolicy)
+    , m_Capacity(0)
+    , m_ElementCount(0)
+    , m_pBlock(0)
+    , m_Columns()
+{
+    Reserve(_rVector.m_ElementCount);
+    CopyRows(_rVector, index_list());
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::CSoaVector(self_type&& _rVector)
+    : m_GrowthPolicy(_rVector.m_GrowthPolicy)
+    , m_Capacity(_rVector.m_Capacity)
+    , m_ElementCount(_rVector.m_ElementCount)
+    , m_pBlock(_rVector.m_pBlock)
+    , m_Columns(_rVector.m_Columns)
+{
+    _rVector.m_Capacity     = 0;
+    _rVector.m_ElementCount = 0;
+    _rVector.m_pBlock       = 0;
+    _rVector.m_Columns      = column_pointers();
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::self_type& CSoaVector<TFields...>::operator=(const self_type& _rVector)
+{
+    if (this != &_rVector)
+    {
+        Clear();
+        Reserve(_rVector.m_ElementCount);
+        CopyRows(_rVector, index_list());
+    }
+    return *this;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::self_type& CSoaVector<TFields...>::operator=(self_type&& _rVector)
+{
+    if (this != &_rVector)
+    {
+        Clear();
+        BASE::MEM::DeallocateAligned(m_pBlock);
+
+        m_GrowthPolicy = _rVector.m_GrowthPolicy;
+        m_Capacity     = _rVector.m_Capacity;
+        m_ElementCount = _rVector.m_ElementCount;
+        m_pBlock       = _rVector.m_pBlock;
+        m_Columns      = _rVector.m_Columns;
+
+        _rVector.m_Capacity     = 0;
+        _rVector.m_ElementCount = 0;
+        _rVector.m_pBlock       = 0;
+        _rVector.m_Columns      = column_pointers();
+    }
+    return *this;
+}
+
+template <typename... TFields>
+CSoaVector<TFields...>::~CSoaVector()
+{
+    Clear();
+    BASE::MEM::DeallocateAligned(m_pBlock);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::iterator CSoaVector<TFields...>::Begin()
+{
+    return iterator(this, 0);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::const_iterator CSoaVector<TFields...>::Begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::iterator CSoaVector<TFields...>::End()
+{
+    return iterator(this, m_ElementCount);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::const_iterator CSoaVector<TFields...>::End() const
+{
+    return const_iterator(this, m_ElementCount);
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::PushBack(const TFields&... _Fields)
+{
+    if (m_ElementCount == m_Capacity)
+    { // the fields may refer to elements, copy them before the columns move
+        value_type Temp(_Fields...);
+        Grow(m_ElementCount + 1);
+        PushRow(Temp, index_list());
+    }
+    else
+    {
+        ConstructBack(index_list(), _Fields...);
+    }
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::PushBack(const value_type& _rRow)
+{
+    PushRow(_rRow, index_list());
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::PopBack()
+{
+    assert(m_ElementCount > 0);
+
+    DestroyRows(m_ElementCount - 1, m_ElementCount, index_list());
+    --m_ElementCount;
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::Clear()
+{
+    DestroyRows(0, m_ElementCount, index_list());
+    m_ElementCount = 0;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CRowReference CSoaVector<TFields...>::operator[](size_type _Index)
+{
+    return CRowReference(this, _Index);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::CConstRowReference CSoaVector<TFields...>::operator[](size_type _Index) const
+{
+    return CConstRowReference(this, _Index);
+}
+
+template <typename... TFields>
+template <size_t Column>
+typename CSoaVector<TFields...>::template SColumn<Column>::type& CSoaVector<TFields...>::Get(size_type _Index)
+{
+    return *(std::get<Column>(m_Columns) + _Index);
+}
+
+template <typename... TFields>
+template <size_t Column>
+const typename CSoaVector<TFields...>::template SColumn<Column>::type& CSoaVector<TFields...>::Get(size_type _Index) const
+{
+    return *(std::get<Column>(m_Columns) + _Index);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::value_type CSoaVector<TFields...>::GetRow(size_type _Index) const
+{
+    return GetRow(_Index, index_list());
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::SetRow(size_type _Index, const value_type& _rRow)
+{
+    SetRow(_Index, _rRow, index_list());
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::Reserve(size_type _Capacity)
+{
+    if (_Capacity > m_Capacity)
+    {
+        Reallocate(_Capacity);
+    }
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::Resize(size_type _Count)
+{
+    if (_Count < m_ElementCount)
+    {
+        DestroyRows(_Count, m_ElementCount, index_list());
+    }
+    else if (_Count > m_ElementCount)
+    {
+        if (_Count > m_Capacity)
+        {
+            Grow(_Count);
+        }
+
+        ConstructDefault(m_ElementCount, _Count, index_list());
+    }
+
+    m_ElementCount = _Count;
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::Swap(self_type& _rVector)
+{
+    std::swap(m_GrowthPolicy, _rVector.m_GrowthPolicy);
+    std::swap(m_Capacity,     _rVector.m_Capacity);
+    std::swap(m_ElementCount, _rVector.m_ElementCount);
+    std::swap(m_pBlock,       _rVector.m_pBlock);
+    std::swap(m_Columns,      _rVector.m_Columns);
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::size_type CSoaVector<TFields...>::GetCount() const
+{
+    return m_ElementCount;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::size_type CSoaVector<TFields...>::GetCapacity() const
+{
+    return m_Capacity;
+}
+
+template <typename... TFields>
+template <size_t Column>
+CSpan<typename CSoaVector<TFields...>::template SColumn<Column>::type> CSoaVector<TFields...>::GetColumn()
+{
+    return CSpan<typename SColumn<Column>::type>(BASE::MEM::AssumeAligned<s_Alignment>(std::get<Column>(m_Columns)), m_ElementCount);
+}
+
+template <typename... TFields>
+template <size_t Column>
+CSpan<const typename CSoaVector<TFields...>::template SColumn<Column>::type> CSoaVector<TFields...>::GetColumn() const
+{
+    const typename SColumn<Column>::type* pColumn = std::get<Column>(m_Columns);
+
+    return CSpan<const typename SColumn<Column>::type>(BASE::MEM::AssumeAligned<s_Alignment>(pColumn), m_ElementCount);
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::Grow(size_type _MinCapacity)
+{
+    Reallocate(m_GrowthPolicy.GetNextCapacity(m_Capacity, _MinCapacity));
+}
+
+template <typename... TFields>
+void CSoaVector<TFields...>::Reallocate(size_type _Capacity)
+{
+    assert(_Capacity >= m_ElementCount);
+
+    size_type Offsets[s_ColumnCount];
+    size_type BlockSize = GetLayout(_Capacity, Offsets);
+
+    char*           pBlock  = static_cast<char*>(BASE::MEM::AllocateAligned(BlockSize, s_Alignment));
+    column_pointers Columns = GetColumns(pBlock, Offsets, index_list());
+
+    RelocateRows(Columns, index_list());
+    BASE::MEM::DeallocateAligned(m_pBlock);
+
+    m_pBlock   = pBlock;
+    m_Columns  = Columns;
+    m_Capacity = _Capacity;
+}
+
+template <typename... TFields>
+typename CSoaVector<TFields...>::size_type CSoaVector<TFields...>::GetLayout(size_type _Capacity, size_type* _pOffsets)
+{
+    const size_type Sizes[] = { sizeof(TFields)... };
+
+    size_type Offset = 0;
+
+    for (size_type Column = 0; Column < s_ColumnCount; ++Column)
+    {
+        _pOffsets[Column] = Offset;
+
+        Offset += Sizes[Column] * _Capacity;
+        Offset  = (Offset + s_Alignment - 1) & ~(s_Alignment - 1);
+    }
+
+    return Offset;
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+typename CSoaVector<TFields...>::column_pointers
+CSoaVector<TFields...>::GetColumns(char* _pBlock, const size_type* _pOffsets, BASE::TYPET::SIndexList<Indices...>)
+{
+    return column_pointers(reinterpret_cast<TFields*>(_pBlock + _pOffsets[Indices])...);
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::PushRow(const value_type& _rRow, BASE::TYPET::SIndexList<Indices...>)
+{
+    PushBack(std::get<Indices>(_rRow)...);
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::ConstructBack(BASE::TYPET::SIndexList<Indices...>, const TFields&... _Fields)
+{
+    // one expression per column, the array only sequences them
+    int Expand[] = { 0, (::new (static_cast<void*>(std::get<Indices>(m_Columns) + m_ElementCount)) TFields(_Fields), 0)... };
+    (void)Expand;
+
+    ++m_ElementCount;
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::ConstructDefault(size_type _First, size_type _Last, BASE::TYPET::SIndexList<Indices...>)
+{
+    for (size_type Row = _First; Row < _Last; ++Row)
+    {
+        int Expand[] = { 0, (::new (static_cast<void*>(std::get<Indices>(m_Columns) + Row)) TFields(), 0)... };
+        (void)Expand;
+    }
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::CopyRows(const self_type& _rVector, BASE::TYPET::SIndexList<Indices...>)
+{
+    int Expand[] = { 0, (CopyColumn(std::get<Indices>(m_Columns), std::get<Indices>(_rVector.m_Columns), _rVector.m_ElementCount,
+        std::integral_constant<bool, BASE::TYPET::SIsTriviallyCopyable<TFields>::Result>()), 0)... };
+    (void)Expand;
+
+    m_ElementCount = _rVector.m_ElementCount;
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::DestroyRows(size_type _First, size_type _Last, BASE::TYPET::SIndexList<Indices...>)
+{
+    int Expand[] = { 0, (DestroyColumn(std::get<Indices>(m_Columns) + _First, std::get<Indices>(m_Columns) + _Last), 0)... };
+    (void)Expand;
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::RelocateRows(const column_pointers& _rTarget, BASE::TYPET::SIndexList<Indices...>)
+{
+    int Expand[] = { 0, (RelocateColumn(std::get<Indices>(_rTarget), std::get<Indices>(m_Columns), m_ElementCount,
+        std::integral_constant<bool, BASE::TYPET::SIsTriviallyRelocatable<TFields>::Result>()), 0)... };
+    (void)Expand;
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+typename CSoaVector<TFields...>::value_type CSoaVector<TFields...>::GetRow(size_type _Index, BASE::TYPET::SIndexList<Indices...>) const
+{
+    return value_type(*(std::get<Indices>(m_Columns) + _Index)...);
+}
+
+template <typename... TFields>
+template <size_t... Indices>
+void CSoaVector<TFields...>::SetRow(size_type _Index, const value_type& _rRow, BASE::TYPET::SIndexList<Indices...>)
+{
+    int Expand[] = { 0, (*(std::get<Indices>(m_Columns) + _Index) = std::get<Indices>(_rRow), 0)... };
+    (void)Expand;
+}
+
+template <typename... TFields>
+template <typename T>
+void CSoaVector<TFields...>::CopyColumn(T* _pTarget, const T* _pSource, size_type _Count, std::true_type)
+{
+    if (_Count > 0)
+    {
+        memcpy(static_cast<void*>(_pTarget), _pSource, _Count * sizeof(T));
+    }
+}
+
+template <typename... TFields>
+template <typename T>
+void CSoaVector<TFields...>::CopyColumn(T* _pTarget, const T* _pSource, size_type _Count, std::false_type)
+{
+    for (const T* pEnd = _pSource + _Count; _pSource != pEnd; ++_pTarget, ++_pSource)
+    {
+        ::new (static_cast<void*>(_pTarget)) T(*_pSource);
+    }
+}
+
+template <typename... TFields>
+template <typename T>
+void CSoaVector<TFields...>::RelocateColumn(T* _pTarget, T* _pSource, size_type _Count, std::true_type)
+{
+    if (_Count > 0)
+    {
+        memcpy(static_cast<void*>(_pTarget), _pSource, _Count * sizeof(T));
+    }
+}
+
+template <typename... TFields>
+template <typename T>
+void CSoaVector<TFields...>::RelocateColumn(T* _pTarget, T* _pSource, size_type _Count, std::false_type)
+{
+    for (T* pEnd = _pSource + _Count; _pSource != pEnd; ++_pTarget, ++_pSource)
+    {
+        ::new (static_cast<void*>(_pTarget)) T(std::move_if_noexcept(*_pSource));
+        _pSource->~T();
+    }
+}
+
+template <typename... TFields>
+template <typename T>
+void CSoaVector<TFields...>::DestroyColumn(T* _pFirst, T* _pLast)
+{
+    for (; _pFirst != _pLast; ++_pFirst)
+    {
+        _pFirst->~T();
+    }
+}
+
+    } // namespace CNT
+} // namespace BASE
+
+#endif // __INCLUDE_SOA_VECTOR_H_
@@ -0,0 +1,125 @@
+#ifndef __INCLUDE_SPAN_H_
+#define __INCLUDE_SPAN_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * Non-owning view of contiguous elements, e.g. a column of a CSoaVector.
+ * Iterators are plain pointers, loops over Begin() and End() compile to
+ * the same code as a loop over an array. Use CSpan<const T> for read-only
+ * views. The span is invalid once the owner reallocates.
+ **/
+template <typename TValue>
+class CSpan
+{
+public: // typedefs
+
+    typedef CSpan<TValue> self_type;
+
+    typedef TValue      value_type;
+    typedef value_type& value_reference_type;
+    typedef value_type* value_pointer_type;
+
+    typedef size_t size_type;
+
+    typedef value_pointer_type iterator;
+
+public: // ctor
+
+    CSpan();
+    CSpan(value_pointer_type _pData, size_type _Count);
+
+public: // iterator creation
+
+    iterator Begin() const;
+    iterator End() const;
+
+public: // operations
+
+    value_reference_type operator[](size_type _Index) const;
+
+public: // properties
+
+    value_pointer_type GetData() const;
+    size_type          GetCount() const;
+    bool               IsEmpty() const;
+
+private: // member
+
+    value_pointer_type m_pData;
+    size_type          m_Count;
+};
+
+/*************************************************************************
+ * SPAN SUBSECTION
+ *************************************************************************/
+
+template <typename TValue>
+CSpan<TValue>::CSpan()
+    : m_pData(0)
+    , m_Count(0)
+{
+}
+
+template <typename TValue>
+CSpan<TValue>::CSpan(value_pointer_type _pData, size_type _Count)
+    : m_pData(_pData)
+    , m_Count(_Count)
+{
+}
+
+template <typename TValue>
+typename CSpan<TValue>::iterator CSpan<TValue>::Begin() const
+{
+    return m_pData;
+}
+
+template <typename TValue>
+typename CSpan<TValue>::iterator CSpan<TValue>::End() const
+{
+    return m_pData + m_Count;
+}
+
+template <typename TValue>
+typename CSpan<TValue>::value_reference_type CSpan<TValue>::operator[](size_type _Index) const
+{
+    return *(m_pData + _Index);
+}
+
+template <typename TValue>
+typename CSpan<TValue>::value_pointer_type CSpan<TValue>::GetData() const
+{
+    return m_pData;
+}
+
+template <typename TValue>
+typename CSpan<TValue>::size_type CSpan<TValue>::GetCount() const
+{
+    return m_Count;
+}
+
+template <typename TValue>
+bool CSpan<TValue>::IsEmpty() const
+{
+    return m_Count == 0;
+}
+
+
+    } // namespace CNT
+} // namespace BASE
+
+#endif // __INCLUDE_SPAN_H_
@@ -0,0 +1,834 @@
+#ifndef __INCLUDE_STABLE_VECTOR_H_
+#define __INCLUDE_STABLE_VECTOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdexcept>
+#include <utility>
+#include "../iterator/iterator.h"
+#include "span.h"
+#include "../../memory/allocator.h"
+#include "../../utility/binary/bits.h"
+
+namespace BASE {
+    namespace CNT {
+
+
+/**
+ * Vector that never moves its elements.
+ * The elements live in blocks of FirstBlockSize, 2 * FirstBlockSize,
+ * 4 * FirstBlockSize, ... elements, a fixed directory holds the blocks.
+ * Growing adds a block and copies nothing, so pointers and references to
+ * elements stay valid until the element is removed. The block and the
+ * offset of an index follow from its highest bit, indexing is O(1).
+ * Blocks are kept when elements are removed, ShrinkToFit frees them.
+ * GetBlock gives contiguous spans for loops that want to vectorize.
+ **/
+template <
+    typename TValue,
+    template <typename> class TAllocator = BASE::MEM::CAllocator,
+    size_t FirstBlockSize = 16
+>
+class CStableVector
+{
+public: // forward declarations
+
+    class CConstIterator;
+    class CIterator;
+
+public: // typedefs
+
+    typedef CStableVector<TValue, TAllocator, FirstBlockSize> self_type;
+
+    typedef TValue            value_type;
+    typedef value_type&       value_reference_type;
+    typedef const value_type& value_const_reference_type;
+    typedef value_type*       value_pointer_type;
+    typedef const value_type* value_const_pointer_type;
+
+    typedef size_t size_type;
+
+    typedef CIterator                        iterator;
+    typedef CConstIterator                   const_iterator;
+    typedef CReverseIterator<iterator>       reverse_iterator;
+    typedef CReverseIterator<const_iterator> const_reverse_iterator;
+
+    typedef TAllocator<value_type> allocator_type;
+
+    static const size_type s_FirstBlockSize  = FirstBlockSize;
+    static const size_type s_FirstBlockShift = BASE::UTIL::SLog2<FirstBlockSize>::Result;
+    static const size_type s_MaxBlockCount   = sizeof(size_type) * 8 - s_FirstBlockShift;
+
+public: // ctor, dtor
+
+    explicit CStableVector(const allocator_type& _Allocator = allocator_type());   // does not allocate
+    CStableVector(const self_type& _rVector);                               // takes over the allocator of _rVector
+    CStableVector(self_type&& _rVector);                                    // takes over elements and allocator
+    self_type& operator=(const self_type& _rVector);                        // keeps the own allocator
+    self_type& operator=(self_type&& _rVector);                             // takes over elements and allocator
+
+    ~CStableVector();
+
+public: // iterator creation
+
+    iterator               Begin();
+    const_iterator         Begin() const;
+    reverse_iterator       RBegin();
+    const_reverse_iterator RBegin() const;
+
+    iterator               End();
+    const_iterator         End() const;
+    reverse_iterator       REnd();
+    const_reverse_iterator REnd() const;
+
+public: // operations
+
+    void PushBack(value_const_reference_type _rItem);
+    void PushBack(value_type&& _rItem);
+    void PopBack();
+    void Clear();                                                           // keeps the blocks
+
+    template <typename... TArgs>
+    value_reference_type EmplaceBack(TArgs&&... _Args);                     // constructs the element in place
+
+    value_reference_type       operator[](size_type _Index) throw();
+    value_const_reference_type operator[](size_type _Index) const throw();
+    value_reference_type       At(size_type _Index);
+    value_const_reference_type At(size_type _Index) const;
+
+    void Reserve(size_type _Capacity);                                      // capacity becomes at least _Capacity
+    void Resize(size_type _Count);                                          // new elements are value initialized
+    void Resize(size_type _Count, value_const_reference_type _rValue);      // new elements are copies of _rValue
+    void ShrinkToFit();                                                     // frees the blocks behind the last element
+
+    void Swap(self_type& _rVector);
+
+public: // properties
+
+    size_type      GetCount() const;
+    size_type      GetCapacity() const;
+    allocator_type GetAllocator() const;
+
+    size_type               GetBlockCount() const;                          // blocks holding elements
+    CSpan<value_type>       GetBlock(size_type _Block);                     // the elements of a block
+    CSpan<const value_type> GetBlock(size_type _Block) const;
+
+public: // iterator declaration
+
+    class CConstIterator : public SIterator<SRandomAccessIteratorTag, TValue>
+    {
+    public:
+
+        friend class CStableVector<TValue, TAllocator, FirstBlockSize>;
+
+    public:
+
+        typedef CConstIterator                              self_type;
+        typedef SIterator<SRandomAccessIteratorTag, TValue> base_type;
+
+        typedef typename base_type::iterator_tag_type iterator_tag_type;
+        typedef typename base_type::value_type        value_type;
+        typedef const value_type&                     value_reference_type;
+        typedef const value_type*                     value_pointer_type;
+        typedef typename base_type::difference_type   difference_type;
+
+    public: // ctor
+
+        CConstIterator(const self_type& _rIt);
+
+    protected: // private ctor
+
+        CConstIterator(const CStableVector<TValue, TAllocator, FirstBlockSize>* _pVector, size_type _Index);
+
+    public: // operations
+
+        const bool operator==(const self_type& _rRhs) const;
+        const bool operator!=(const self_type& _rRhs) const;
+
+        value_reference_type operator*() const;
+        value_pointer_type   operator->() const;
+
+        self_type&      operator++();
+        const self_type operator++(int);
+        self_type&      operator--();
+        const self_type operator--(int);
+
+        const self_type& operator+=(difference_type _Off);
+        self_type        operator+(difference_type _Off) const;
+        const self_type& operator-=(difference_type _Off);
+        self_type        operator-(difference_type _Off) const;
+        difference_type  operator-(const self_type& _rRhs) const;
+
+    protected: // member
+
+        CStableVector<TValue, TAllocator, FirstBlockSize>* m_pVector;
+        size_type                                          m_Index;
+    };
+
+    class CIterator : public CConstIterator
+    {
+    public:
+
+        friend class CStableVector<TValue, TAllocator, FirstBlockSize>;
+
+    public:
+
+        typedef CIterator   self_type;
+        typedef value_type& value_reference_type;
+        typedef value_type* value_pointer_type;
+
+        typedef typename CConstIterator::difference_type difference_type;
+
+    public: // ctor
+
+        CIterator(const self_type& _rIt);
+
+    private: // private ctor
+
+        CIterator(CStableVector<TValue, TAllocator, FirstBlockSize>* _pVector, size_type _Index);
+
+    public: // operations
+
+        value_reference_type operator*() const;
+        value_pointer_type   operator->() const;
+
+        self_type&      operator++();
+        const self_type operator++(int);
+        self_type&      operator--();
+        const self_type operator--(int);
+
+        const self_type& operator+=(difference_type _Off);
+        self_type        operator+(difference_type _Off) const;
+        const self_type& operator-=(difference_type _Off);
+        self_type        operator-(difference_type _Off) const;
+        difference_type  operator-(const CConstIterator& _rRhs) const;
+    };
+
+private: // internal operations
+
+    static size_type GetBlockSize(size_type _Block);
+    static size_type GetBlockIndex(size_type _Index);                       // block holding element _Index
+    static size_type GetCapacity(size_type _BlockCount);                    // elements in the first _BlockCount blocks
+
+    value_pointer_type GetAddress(size_type _Index) const;
+    void               AddBlock();
+    void               FreeBlocks(size_type _BlockCount);                   // keeps the first _BlockCount blocks
+    void               TakeBlocks(self_type& _rVector);                     // _rVector is left without blocks
+
+private: // member
+
+    allocator_type     m_Allocator;
+    size_type          m_ElementCount;
+    size_type          m_BlockCount;                                        // allocated blocks
+    value_pointer_type m_pBlocks[s_MaxBlockCount];
+
+    static_assert(FirstBlockSize > 0 && (FirstBlockSize & (FirstBlockSize - 1)) == 0, "the first block size has to be a power of two");
+};
+
+/*************************************************************************
+ * CONST ITERATOR SUBSECTION
+ *************************************************************************/
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::CConstIterator(const CStableVector<TValue, TAllocator, FirstBlockSize>* _pVector, size_type _Index)
+    : m_pVector(const_cast<CStableVector<TValue, TAllocator, FirstBlockSize>*>(_pVector))
+    , m_Index(_Index)
+{
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::CConstIterator(const self_type& _rIt)
+    : m_pVector(_rIt.m_pVector)
+    , m_Index(_rIt.m_Index)
+{
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const bool
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator==(const self_type& _rRhs) const
+{
+    return m_Index == _rRhs.m_Index;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const bool
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator!=(const self_type& _rRhs) const
+{
+    return m_Index != _rRhs.m_Index;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::value_reference_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator*() const
+{
+    return *m_pVector->GetAddress(m_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::value_pointer_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator->() const
+{
+    return m_pVector->GetAddress(m_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator++()
+{
+    ++m_Index;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator++(int)
+{
+    self_type Temp(*this);
+    ++m_Index;
+    return Temp;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator--()
+{
+    --m_Index;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator--(int)
+{
+    self_type Temp(*this);
+    --m_Index;
+    return Temp;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator+=(difference_type _Off)
+{
+    m_Index += _Off;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator+(difference_type _Off) const
+{
+    return self_type(m_pVector, m_Index + _Off);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator-=(difference_type _Off)
+{
+    m_Index -= _Off;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator-(difference_type _Off) const
+{
+    return self_type(m_pVector, m_Index - _Off);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::difference_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CConstIterator::operator-(const self_type& _rRhs) const
+{
+    return static_cast<difference_type>(m_Index) - static_cast<difference_type>(_rRhs.m_Index);
+}
+
+/*************************************************************************
+ * ITERATOR SUBSECTION
+ *************************************************************************/
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::CIterator(CStableVector<TValue, TAllocator, FirstBlockSize>* _pVector, size_type _Index)
+    : CConstIterator(_pVector, _Index)
+{
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::CIterator(const self_type& _rIt)
+    : CConstIterator(_rIt)
+{
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::value_reference_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator*() const
+{
+    return *this->m_pVector->GetAddress(this->m_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::value_pointer_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator->() const
+{
+    return this->m_pVector->GetAddress(this->m_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator++()
+{
+    ++this->m_Index;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator++(int)
+{
+    self_type Temp(*this);
+    ++this->m_Index;
+    return Temp;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator--()
+{
+    --this->m_Index;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator--(int)
+{
+    self_type Temp(*this);
+    --this->m_Index;
+    return Temp;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator+=(difference_type _Off)
+{
+    this->m_Index += _Off;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator+(difference_type _Off) const
+{
+    return self_type(this->m_pVector, this->m_Index + _Off);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+const typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type&
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator-=(difference_type _Off)
+{
+    this->m_Index -= _Off;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::self_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator-(difference_type _Off) const
+{
+    return self_type(this->m_pVector, this->m_Index - _Off);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::difference_type
+CStableVector<TValue, TAllocator, FirstBlockSize>::CIterator::operator-(const CConstIterator& _rRhs) const
+{
+    return CConstIterator::operator-(_rRhs);
+}
+
+/*************************************************************************
+ * STABLE VECTOR SUBSECTION
+ *************************************************************************/
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CStableVector(const allocator_type& _Allocator)
+    : m_Allocator(_Allocator)
+    , m_ElementCount(0)
+    , m_BlockCount(0)
+{
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CStableVector(const self_type& _rVector)
+    : m_Allocator(_rVector.m_Allocator)
+    , m_ElementCount(0)
+    , m_BlockCount(0)
+{
+    Reserve(_rVector.m_ElementCount);
+
+    for (size_type Index = 0; Index < _rVector.m_ElementCount; ++Index)
+    {
+        PushBack(_rVector[Index]);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::CStableVector(self_type&& _rVector)
+    : m_Allocator(_rVector.m_Allocator)
+    , m_ElementCount(0)
+    , m_BlockCount(0)
+{
+    TakeBlocks(_rVector);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::self_type& CStableVector<TValue, TAllocator, FirstBlockSize>::operator=(const self_type& _rVector)
+{
+    if (this != &_rVector)
+    {
+        Clear();
+        Reserve(_rVector.m_ElementCount);
+
+        for (size_type Index = 0; Index < _rVector.m_ElementCount; ++Index)
+        {
+            PushBack(_rVector[Index]);
+        }
+    }
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::self_type& CStableVector<TValue, TAllocator, FirstBlockSize>::operator=(self_type&& _rVector)
+{
+    if (this != &_rVector)
+    {
+        Clear();
+        FreeBlocks(0);
+
+        m_Allocator = _rVector.m_Allocator;
+        TakeBlocks(_rVector);
+    }
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CStableVector<TValue, TAllocator, FirstBlockSize>::~CStableVector()
+{
+    Clear();
+    FreeBlocks(0);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::iterator CStableVector<TValue, TAllocator, FirstBlockSize>::Begin()
+{
+    return iterator(this, 0);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::const_iterator CStableVector<TValue, TAllocator, FirstBlockSize>::Begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::reverse_iterator CStableVector<TValue, TAllocator, FirstBlockSize>::RBegin()
+{
+    return reverse_iterator(End() - 1);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::const_reverse_iterator CStableVector<TValue, TAllocator, FirstBlockSize>::RBegin() const
+{
+    return const_reverse_iterator(End() - 1);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::iterator CStableVector<TValue, TAllocator, FirstBlockSize>::End()
+{
+    return iterator(this, m_ElementCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::const_iterator CStableVector<TValue, TAllocator, FirstBlockSize>::End() const
+{
+    return const_iterator(this, m_ElementCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::reverse_iterator CStableVector<TValue, TAllocator, FirstBlockSize>::REnd()
+{
+    return reverse_iterator(Begin() - 1);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::const_reverse_iterator CStableVector<TValue, TAllocator, FirstBlockSize>::REnd() const
+{
+    return const_reverse_iterator(Begin() - 1);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::PushBack(value_const_reference_type _rItem)
+{
+    EmplaceBack(_rItem);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::PushBack(value_type&& _rItem)
+{
+    EmplaceBack(std::move(_rItem));
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+template <typename... TArgs>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_reference_type CStableVector<TValue, TAllocator, FirstBlockSize>::EmplaceBack(TArgs&&... _Args)
+{
+    // nothing moves on growth, the arguments stay valid
+    if (m_ElementCount == GetCapacity(m_BlockCount))
+    {
+        AddBlock();
+    }
+
+    value_pointer_type pElement = GetAddress(m_ElementCount);
+    m_Allocator.Construct(pElement, std::forward<TArgs>(_Args)...);
+    ++m_ElementCount;
+
+    return *pElement;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::PopBack()
+{
+    assert(m_ElementCount > 0);
+
+    --m_ElementCount;
+    m_Allocator.Destroy(GetAddress(m_ElementCount));
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::Clear()
+{
+    while (m_ElementCount > 0)
+    {
+        PopBack();
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_reference_type CStableVector<TValue, TAllocator, FirstBlockSize>::operator[](size_type _Index) throw()
+{
+    return *GetAddress(_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_const_reference_type CStableVector<TValue, TAllocator, FirstBlockSize>::operator[](size_type _Index) const throw()
+{
+    return *GetAddress(_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_reference_type CStableVector<TValue, TAllocator, FirstBlockSize>::At(size_type _Index)
+{
+    if (_Index >= m_ElementCount)
+    {
+        throw std::out_of_range("index out of range");
+    }
+
+    return *GetAddress(_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_const_reference_type CStableVector<TValue, TAllocator, FirstBlockSize>::At(size_type _Index) const
+{
+    if (_Index >= m_ElementCount)
+    {
+        throw std::out_of_range("index out of range");
+    }
+
+    return *GetAddress(_Index);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::Reserve(size_type _Capacity)
+{
+    while (GetCapacity(m_BlockCount) < _Capacity)
+    {
+        AddBlock();
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::Resize(size_type _Count)
+{
+    while (m_ElementCount > _Count)
+    {
+        PopBack();
+    }
+
+    Reserve(_Count);
+
+    while (m_ElementCount < _Count)
+    {
+        EmplaceBack();
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::Resize(size_type _Count, value_const_reference_type _rValue)
+{
+    while (m_ElementCount > _Count)
+    {
+        PopBack();
+    }
+
+    Reserve(_Count);
+
+    while (m_ElementCount < _Count)
+    {
+        EmplaceBack(_rValue);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::ShrinkToFit()
+{
+    FreeBlocks(GetBlockCount());
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::Swap(self_type& _rVector)
+{
+    size_type BlockCount = (m_BlockCount > _rVector.m_BlockCount) ? m_BlockCount : _rVector.m_BlockCount;
+
+    for (size_type Block = 0; Block < BlockCount; ++Block)
+    {
+        std::swap(m_pBlocks[Block], _rVector.m_pBlocks[Block]);
+    }
+
+    std::swap(m_Allocator,    _rVector.m_Allocator);
+    std::swap(m_ElementCount, _rVector.m_ElementCount);
+    std::swap(m_BlockCount,   _rVector.m_BlockCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::size_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetCount() const
+{
+    return m_ElementCount;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::size_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetCapacity() const
+{
+    return GetCapacity(m_BlockCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::allocator_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetAllocator() const
+{
+    return m_Allocator;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::size_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetBlockCount() const
+{
+    return (m_ElementCount == 0) ? 0 : GetBlockIndex(m_ElementCount - 1) + 1;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CSpan<typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_type> CStableVector<TValue, TAllocator, FirstBlockSize>::GetBlock(size_type _Block)
+{
+    assert(_Block < GetBlockCount());
+
+    size_type Begin = GetCapacity(_Block);
+    size_type End   = GetCapacity(_Block + 1);
+
+    return CSpan<value_type>(m_pBlocks[_Block], (End < m_ElementCount ? End : m_ElementCount) - Begin);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+CSpan<const typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_type> CStableVector<TValue, TAllocator, FirstBlockSize>::GetBlock(size_type _Block) const
+{
+    assert(_Block < GetBlockCount());
+
+    size_type Begin = GetCapacity(_Block);
+    size_type End   = GetCapacity(_Block + 1);
+
+    return CSpan<const value_type>(m_pBlocks[_Block], (End < m_ElementCount ? End : m_ElementCount) - Begin);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::size_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetBlockSize(size_type _Block)
+{
+    return s_FirstBlockSize << _Block;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::size_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetBlockIndex(size_type _Index)
+{
+    // block b starts at FirstBlockSize * (2^b - 1), so _Index + FirstBlockSize has its highest bit at b + shift
+    return BASE::UTIL::GetHighestBit(_Index + s_FirstBlockSize) - s_FirstBlockShift;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::size_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetCapacity(size_type _BlockCount)
+{
+    return (GetBlockSize(_BlockCount) - s_FirstBlockSize);
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+typename CStableVector<TValue, TAllocator, FirstBlockSize>::value_pointer_type CStableVector<TValue, TAllocator, FirstBlockSize>::GetAddress(size_type _Index) const
+{
+    size_type Block = GetBlockIndex(_Index);
+
+    return m_pBlocks[Block] + (_Index + s_FirstBlockSize - GetBlockSize(Block));
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::AddBlock()
+{
+    if (m_BlockCount == s_MaxBlockCount - 1)
+    {
+        throw std::length_error("stable vector is full");
+    }
+
+    m_pBlocks[m_BlockCount] = m_Allocator.Allocate(GetBlockSize(m_BlockCount));
+    ++m_BlockCount;
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::FreeBlocks(size_type _BlockCount)
+{
+    assert(GetCapacity(_BlockCount) >= m_ElementCount);
+
+    while (m_BlockCount > _BlockCount)
+    {
+        --m_BlockCount;
+        m_Allocator.Deallocate(m_pBlocks[m_BlockCount], GetBlockSize(m_BlockCount));
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, size_t FirstBlockSize>
+void CStableVector<TValue, TAllocator, FirstBlockSize>::TakeBlocks(self_type& _rVector)
+{
+    m_ElementCount = _rVector.m_ElementCount;
+    m_BlockCount   = _rVector.m_BlockCount;
+
+    for (size_type Block = 0; Block < m_BlockCount; ++Block)
+    {
+        m_pBlocks[Block] = _rVector.m_pBlocks[Block];
+    }
+
+    _rVector.m_ElementCount = 0;
+    _rVector.m_BlockCount   = 0;
+}
+
+    } // namespace CNT
+} // namespace BASE
+
+#endif // __INCLUDE_STABLE_VECTOR_H_
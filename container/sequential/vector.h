@@ -12,8 +12,18 @@
  ************************************************************************************/
 
 #include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include "../iterator/iterator.h"
+#include "growthpolicy.h"
 #include "../../memory/allocator.h"
+#include "../../memory/allocatortraits.h"
+#include "../../memory/alignment.h"
+#include "../../typetraits/is_trivially_relocatable.h"
 
 namespace BASE {
     namespace CNT {
@@ -21,15 +31,11 @@ namespace BASE {
             
 template <
     typename TValue,
-    template <typename> class TAllocator = BASE::MEM::CAllocator
+    template <typename> class TAllocator = BASE::MEM::CAllocator,
+    typename TGrowthPolicy = CGeometricGrowth<>
 >
 class CVector
 {
-public: // static constants
-
-    static const int s_DefaultCapacity = 1;
-    static const int s_DefaultIncrease = 8;
-
 public: // forward declarations
 
     class CConstIterator;
@@ -37,7 +43,7 @@ public: // forward declarations
 
 public: // typedefs
 
-	typedef CVector<TValue, TAllocator> self_type;
+	typedef CVector<TValue, TAllocator, TGrowthPolicy> self_type;
 
 	typedef TValue            value_type;
 	typedef value_type&       value_reference_type;
@@ -53,16 +59,27 @@ public: // typedefs
     typedef CReverseIterator<const_iterator> const_reverse_iterator;
 
     typedef TAllocator<value_type> allocator_type;
+    typedef TGrowthPolicy          growth_policy_type;
+
+    static const size_type s_Alignment = BASE::MEM::SAllocatorTraits<allocator_type>::s_Alignment;   // guaranteed alignment of the data
 
 public: // ctor, dtor
 
-    CVector();
-    CVector(int _Capacity, int _Increase);
-    CVector(const self_type& _rVector);
-    self_type& operator=(const self_type& _rVector);
+    explicit CVector(const allocator_type& _Allocator = allocator_type());     // does not allocate
+    explicit CVector(size_type _Capacity, const growth_policy_type& _GrowthPolicy = growth_policy_type(), const allocator_type& _Allocator = allocator_type());
+    CVector(const self_type& _rVector);                                     // takes over the allocator of _rVector
+    CVector(self_type&& _rVector);                                          // takes over elements and allocator
+    self_type& operator=(const self_type& _rVector);                        // keeps the own allocator
+    self_type& operator=(self_type&& _rVector);                             // takes over elements and allocator
 
     ~CVector();
 
+protected: // inline storage
+
+    CVector(value_pointer_type _pInlineData, size_type _InlineCapacity, const growth_policy_type& _GrowthPolicy, const allocator_type& _Allocator);
+
+    bool IsInline() const;                                                  // data lives in the inline storage
+
 public: // iterator creation
 
     iterator               Begin();
@@ -78,18 +95,54 @@ public: // iterator creation
 public: // operations
 
     void PushBack(value_const_reference_type _rItem);
+    void PushBack(value_type&& _rItem);
     void PopBack();
+
+    template <typename... TArgs>
+    value_reference_type EmplaceBack(TArgs&&... _Args);                     // constructs the element in place
+
+    template <typename... TArgs>
+    iterator Emplace(const_iterator _Pos, TArgs&&... _Args);                // constructs in front of _Pos
+    iterator Insert(const_iterator _Pos, value_const_reference_type _rItem);
+    iterator Insert(const_iterator _Pos, value_type&& _rItem);
+
+    template <typename TIterator>
+    iterator Insert(const_iterator _Pos, TIterator _First, TIterator _Last);   // allocates at most once for forward iterators
+    template <typename TIterator>
+    void Append(TIterator _First, TIterator _Last);
+    template <typename TIterator>
+    void Assign(TIterator _First, TIterator _Last);                         // the range must not point into the vector
+
+    void Resize(size_type _Count);                                          // new elements are value initialized
+    void Resize(size_type _Count, value_const_reference_type _rValue);      // new elements are copies of _rValue
+
     iterator Remove(iterator _Pos);
     iterator Remove(iterator _First, iterator _Last);
+    iterator RemoveUnordered(iterator _Pos);                                // fills the gap with the last element
+    template <typename TPredicate>
+    size_type RemoveIf(TPredicate _Predicate);                              // one pass, keeps the order, returns the removed count
+    template <typename TIterator>
+    size_type RemoveIndices(TIterator _First, TIterator _Last);             // ascending indices, one pass, returns the removed count
 
     value_reference_type       operator[](size_type _Index) throw();
     value_const_reference_type operator[](size_type _Index) const throw();
     value_reference_type       At(size_type _Index);
     value_const_reference_type At(size_type _Index) const;
 
+    void Reserve(size_type _Capacity);                                      // capacity becomes at least _Capacity
+    void ShrinkToFit();                                                     // capacity becomes the element count
+
+    void Swap(self_type& _rVector);                                         // swap elements, allocators and policies
+
 public: // properties
 
-    size_type GetCount() const;
+    size_type          GetCount() const;
+    size_type          GetCapacity() const;
+    allocator_type     GetAllocator() const;
+    growth_policy_type GetGrowthPolicy() const;
+
+    value_pointer_type       GetData();                                     // contiguous data, aligned to s_Alignment
+    value_const_pointer_type GetData() const;
 
 public: // iterator declaration
 
@@ -97,26 +150,27 @@ public: // iterator declaration
     {
     public:
 
-        friend typename CVector<TValue, TAllocator>;
+        friend class CVector<TValue, TAllocator, TGrowthPolicy>;
 
     public:
 
         typedef CConstIterator                              self_type;
         typedef SIterator<SRandomAccessIteratorTag, TValue> base_type;
 
-        typedef typename base_type::iterator_tag_type          iterator_tag_type;
-        typedef typename base_type::value_type                 value_type;
-        typedef typename const base_type::value_reference_type value_reference_type;
-        typedef typename const base_type::value_pointer_type   value_pointer_type;
-        typedef typename base_type::difference_type            difference_type;
+        typedef typename base_type::iterator_tag_type iterator_tag_type;
+        typedef typename base_type::value_type        value_type;
+        typedef const value_type&                     value_reference_type;
+        typedef const value_type*                     value_pointer_type;
+        typedef typename base_type::difference_type   difference_type;
 
     public: // ctor, dtor
 
         CConstIterator(const self_type& _rIterator);
+        self_type& operator=(const self_type& _rIterator);
 
     private: // private ctor
 
-        CConstIterator(value_pointer_type _pValue);
+        CConstIterator(value_type* _pValue);
 
     public: // exposed operations
 
@@ -135,6 +189,7 @@ public: // iterator declaration
         self_type        operator+(difference_type _Off) const;
         const self_type& operator-=(difference_type _Off);
         self_type        operator-(difference_type _Off) const;
+        difference_type  operator-(const self_type& _rRhs) const;
 
     private: // member
 
@@ -150,18 +205,21 @@ public: // iterator declaration
     {
     public:
 
-        friend typename CVector<TValue, TAllocator>;
+        friend class CVector<TValue, TAllocator, TGrowthPolicy>;
 
     public:
 
         typedef CIterator      self_type;
 
-        typedef typename base_type::value_reference_type value_reference_type;
-        typedef typename base_type::value_pointer_type   value_pointer_type;
+        typedef typename CConstIterator::value_type      value_type;
+        typedef typename CConstIterator::difference_type difference_type;
+        typedef value_type&                              value_reference_type;
+        typedef value_type*                              value_pointer_type;
 
     public:
 
         CIterator(const self_type& _rIt);
+        self_type& operator=(const self_type& _rIt);
 
     private:
 
@@ -181,21 +239,62 @@ public: // iterator declaration
         self_type        operator+(difference_type _Off) const;
         const self_type& operator-=(difference_type _Off);
         self_type        operator-(difference_type _Off) const;
+        difference_type  operator-(const CConstIterator& _rRhs) const;
     };
 
+private: // internal typedefs
+
+    typedef std::integral_constant<bool, BASE::TYPET::SIsTriviallyRelocatable<value_type>::Result> relocation_tag;
+
 private: // internal operations
 
-    bool Resize(size_type _minIncrease = 1);
-    void ShiftLeft(iterator _Begin, int _Count);
-    void ShiftRight(iterator _Begin, int _Count);
+    void Grow(size_type _MinCapacity);                                      // capacity as proposed by the growth policy
+
+    template <typename TIterator>
+    void InsertRange(size_type _Index, TIterator _First, TIterator _Last, SInputIteratorTag);     // one pass, element by element
+    template <typename TIterator>
+    void InsertRange(size_type _Index, TIterator _First, TIterator _Last, SForwardIteratorTag);   // counts the range first, grows once
+    template <typename TIterator>
+    void AssignRange(TIterator _First, TIterator _Last, SInputIteratorTag);
+    template <typename TIterator>
+    void AssignRange(TIterator _First, TIterator _Last, SForwardIteratorTag);
+    template <typename TIterator>
+    bool IsElement(TIterator _It, std::true_type) const;                    // whether *_It lives in this vector
+    template <typename TIterator>
+    bool IsElement(TIterator _It, std::false_type) const;
+    void Reallocate(size_type _Capacity);                                   // capacity becomes exactly _Capacity
+    void Relocate(size_type _Capacity, std::true_type);                     // moves the data into a block of _Capacity
+    void Relocate(size_type _Capacity, std::false_type);
+    void RelocateRange(value_pointer_type _pTarget, value_pointer_type _pFirst, value_pointer_type _pLast, std::true_type);    // into raw memory, sources are gone
+    void RelocateRange(value_pointer_type _pTarget, value_pointer_type _pFirst, value_pointer_type _pLast, std::false_type);
+
+    template <typename TIterator>
+    void ConstructRange(value_pointer_type _pTarget, TIterator _First, TIterator _Last);                   // copies into raw memory
+    template <typename TIterator>
+    void ConstructRange(value_pointer_type _pTarget, TIterator _First, TIterator _Last, std::true_type);   // memcpy
+    template <typename TIterator>
+    void ConstructRange(value_pointer_type _pTarget, TIterator _First, TIterator _Last, std::false_type);
+    template <typename... TArgs>
+    void ConstructFill(value_pointer_type _pTarget, size_type _Count, const TArgs&... _Args);
+    void ShiftLeft(iterator _Begin, size_type _Count, std::true_type);      // moves [_Begin, End()) down over _Count removed elements
+    void ShiftLeft(iterator _Begin, size_type _Count, std::false_type);
+    void ShiftRight(iterator _Begin, size_type _Count, std::true_type);     // moves [_Begin, End()) up, leaves raw memory behind
+    void ShiftRight(iterator _Begin, size_type _Count, std::false_type);    // moves [_Begin, End()) up, leaves moved-from elements behind
+    void Fill(value_pointer_type _pSlot, value_type&& _rValue, std::true_type);     // puts _rValue into a slot left by ShiftRight
+    void Fill(value_pointer_type _pSlot, value_type&& _rValue, std::false_type);
+    size_type Truncate(value_pointer_type _pEnd);                           // destroys [_pEnd, End()), returns their count
+    void FreeData();                                                        // releases the block unless it is inline
+    void TakeData(self_type& _rVector);                                     // steals or moves the elements, _rVector is left empty
 
 private: // member
 
     allocator_type     m_Allocator;
+    growth_policy_type m_GrowthPolicy;
     size_type          m_Capacity;
-    size_type          m_Increase;
     size_type          m_ElementCount;
     value_pointer_type m_pData;
+    value_pointer_type m_pInlineData;                                       // storage of a derived CSmallVector, or 0
+    size_type          m_InlineCapacity;
 
 };
 
@@ -203,122 +302,137 @@ private: // member
  * CONST ITERATOR SUBSECTION
  *************************************************************************/
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CConstIterator::CConstIterator(value_pointer_type _pValue)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::CConstIterator(value_type* _pValue)
     : m_pValue(_pValue)
 {
 }
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CConstIterator::CConstIterator(const self_type& _rIt)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::CConstIterator(const self_type& _rIt)
     : m_pValue(_rIt.m_pValue)
 {
 }
 
-template <typename TValue, template <typename> class TAllocator>
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator=(const self_type& _rIt)
+{
+    m_pValue = _rIt.m_pValue;
+    return *this;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
 const bool
-CVector<TValue, TAllocator>::CConstIterator::operator==(const self_type& _rRhs) const
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator==(const self_type& _rRhs) const
 {
     return this->m_pValue == _rRhs.m_pValue;
 }
 
-template <typename TValue, template <typename> class TAllocator>
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
 const bool
-CVector<TValue, TAllocator>::CConstIterator::operator!=(const self_type& _rRhs) const
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator!=(const self_type& _rRhs) const
 {
     return this->m_pValue != _rRhs.m_pValue; // oder: return *this == _rRhs;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CConstIterator::value_reference_type
-CVector<TValue, TAllocator>::CConstIterator::operator*() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::value_reference_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator*() const
 {
     return *m_pValue;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CConstIterator::value_pointer_type
-CVector<TValue, TAllocator>::CConstIterator::operator->() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::value_pointer_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator->() const
 {
     return &(operator*());
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CConstIterator::self_type&
-CVector<TValue, TAllocator>::CConstIterator::operator++()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator++()
 {
     this->Increment();
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CConstIterator::self_type
-CVector<TValue, TAllocator>::CConstIterator::operator++(int)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator++(int)
 {
-    self Temp = *this;
+    self_type Temp = *this;
     this->Increment();
     return Temp;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CConstIterator::self_type&
-CVector<TValue, TAllocator>::CConstIterator::operator--()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator--()
 {
     this->Decrement();
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CConstIterator::self_type
-CVector<TValue, TAllocator>::CConstIterator::operator--(int)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator--(int)
 {
-    self Temp = *this;
+    self_type Temp = *this;
     this->Decrement();
     return Temp;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CConstIterator::self_type&
-CVector<TValue, TAllocator>::CConstIterator::operator+=(difference_type _Off)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator+=(difference_type _Off)
 {
     m_pValue += _Off;
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CConstIterator::self_type
-CVector<TValue, TAllocator>::CConstIterator::operator+(difference_type _Off) const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator+(difference_type _Off) const
 {
     CConstIterator temp(*this);
     return temp += _Off;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CConstIterator::self_type&
-CVector<TValue, TAllocator>::CConstIterator::operator-=(difference_type _Off)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator-=(difference_type _Off)
 {
     m_pValue -= _Off;
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CConstIterator::self_type
-CVector<TValue, TAllocator>::CConstIterator::operator-(difference_type _Off) const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator-(difference_type _Off) const
 {
     CConstIterator temp(*this);
     return temp -= _Off;
 }
 
-template <typename TValue, template <typename> class TAllocator>
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::difference_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::operator-(const self_type& _rRhs) const
+{
+    return m_pValue - _rRhs.m_pValue;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
 void
-CVector<TValue, TAllocator>::CConstIterator::Increment()
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::Increment()
 {
     ++m_pValue;
 }
 
-template <typename TValue, template <typename> class TAllocator>
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
 void
-CVector<TValue, TAllocator>::CConstIterator::Decrement()
+CVector<TValue, TAllocator, TGrowthPolicy>::CConstIterator::Decrement()
 {
     --m_pValue;
 }
@@ -327,341 +441,966 @@ CVector<TValue, TAllocator>::CConstIterator::Decrement()
  * ITERATOR SUBSECTION
  *************************************************************************/
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CIterator::CIterator(value_pointer_type _pValue)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::CIterator(value_pointer_type _pValue)
     : CConstIterator(_pValue)
 {
 }
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CIterator::CIterator(const self_type& _rIt)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::CIterator(const self_type& _rIt)
     : CConstIterator(_rIt)
 {
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CIterator::value_reference_type
-CVector<TValue, TAllocator>::CIterator::operator*() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator=(const self_type& _rIt)
 {
-    return *m_pValue;
+    CConstIterator::operator=(_rIt);
+    return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CIterator::value_pointer_type
-CVector<TValue, TAllocator>::CIterator::operator->() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::value_reference_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator*() const
+{
+    return *this->m_pValue;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::value_pointer_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator->() const
 {
     return &(operator*());
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CIterator::self_type&
-CVector<TValue, TAllocator>::CIterator::operator++()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator++()
 {
-    Increment();
+    this->Increment();
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CIterator::self_type
-CVector<TValue, TAllocator>::CIterator::operator++(int)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator++(int)
 {
-    self Temp = *this;
-    Increment();
+    self_type Temp = *this;
+    this->Increment();
     return Temp;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CIterator::self_type&
-CVector<TValue, TAllocator>::CIterator::operator--()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator--()
 {
-    Decrement();
+    this->Decrement();
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CIterator::self_type
-CVector<TValue, TAllocator>::CIterator::operator--(int)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator--(int)
 {
-    self Temp = *this;
-    Decrement();
+    self_type Temp = *this;
+    this->Decrement();
     return Temp;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CIterator::self_type&
-CVector<TValue, TAllocator>::CIterator::operator+=(difference_type _Off)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator+=(difference_type _Off)
 {
-    m_pValue += _Off;
+    this->m_pValue += _Off;
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CIterator::self_type
-CVector<TValue, TAllocator>::CIterator::operator+(difference_type _Off) const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator+(difference_type _Off) const
 {
     CIterator temp(*this);
     return temp += _Off;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-const typename CVector<TValue, TAllocator>::CIterator::self_type&
-CVector<TValue, TAllocator>::CIterator::operator-=(difference_type _Off)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+const typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type&
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator-=(difference_type _Off)
 {
-    m_pValue -= _Off;
+    this->m_pValue -= _Off;
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::CIterator::self_type
-CVector<TValue, TAllocator>::CIterator::operator-(difference_type _Off) const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::self_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator-(difference_type _Off) const
 {
     CIterator temp(*this);
     return temp -= _Off;
 }
 
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::difference_type
+CVector<TValue, TAllocator, TGrowthPolicy>::CIterator::operator-(const CConstIterator& _rRhs) const
+{
+    return CConstIterator::operator-(_rRhs);
+}
+
 ///////////////////////// VECTOR
 
 
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CVector()
-    : m_Allocator()
-    , m_Capacity(s_DefaultCapacity)
-    , m_Increase(s_DefaultIncrease)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CVector(const allocator_type& _Allocator)
+    : m_Allocator(_Allocator)
+    , m_GrowthPolicy()
+    , m_Capacity(0)
     , m_ElementCount(0)
     , m_pData(0)
+    , m_pInlineData(0)
+    , m_InlineCapacity(0)
 {
-    m_pData = m_Allocator.Allocate(m_Capacity);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CVector(int _Capacity, int _Increase)
-    : m_Allocator()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CVector(size_type _Capacity, const growth_policy_type& _GrowthPolicy, const allocator_type& _Allocator)
+    : m_Allocator(_Allocator)
+    , m_GrowthPolicy(_GrowthPolicy)
     , m_Capacity(_Capacity)
-    , m_Increase(_Increase)
     , m_ElementCount(0)
     , m_pData(0)
+    , m_pInlineData(0)
+    , m_InlineCapacity(0)
 {
-    m_data = m_Allocator.Allocate(m_Capacity);
+    m_pData = m_Allocator.Allocate(m_Capacity);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::CVector(const self_type& _rVector)
-    : m_Allocator()
-    , m_Capacity(_rVector.m_Capacity)
-    , m_Increase(_rVector.m_Increase)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CVector(const self_type& _rVector)
+    : m_Allocator(_rVector.m_Allocator)
+    , m_GrowthPolicy(_rVector.m_GrowthPolicy)
+    , m_Capacity(_rVector.m_ElementCount)
     , m_ElementCount(0)
     , m_pData(0)
+    , m_pInlineData(0)
+    , m_InlineCapacity(0)
 {
-    m_data = m_Allocator.Allocate(m_Capacity);
-    
-    // todo: batch insertion
-    for (auto it = _rVector.Begin(); it != _rVector.End(); ++it)
-        PushBack(*it);
+    m_pData = m_Allocator.Allocate(m_Capacity);
+
+    ConstructRange(m_pData, _rVector.GetData(), _rVector.GetData() + _rVector.m_ElementCount);
+    m_ElementCount = _rVector.m_ElementCount;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CVector(self_type&& _rVector)
+    : m_Allocator(_rVector.m_Allocator)
+    , m_GrowthPolicy(_rVector.m_GrowthPolicy)
+    , m_Capacity(0)
+    , m_ElementCount(0)
+    , m_pData(0)
+    , m_pInlineData(0)
+    , m_InlineCapacity(0)
+{
+    TakeData(_rVector);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-CVector<TValue, TAllocator>::~CVector()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::CVector(value_pointer_type _pInlineData, size_type _InlineCapacity, const growth_policy_type& _GrowthPolicy, const allocator_type& _Allocator)
+    : m_Allocator(_Allocator)
+    , m_GrowthPolicy(_GrowthPolicy)
+    , m_Capacity(_InlineCapacity)
+    , m_ElementCount(0)
+    , m_pData(_pInlineData)
+    , m_pInlineData(_pInlineData)
+    , m_InlineCapacity(_InlineCapacity)
+{
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+CVector<TValue, TAllocator, TGrowthPolicy>::~CVector()
 {
     Remove(Begin(), End());
-    m_Allocator.Deallocate(m_pData, m_Capacity);
+    FreeData();
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+bool CVector<TValue, TAllocator, TGrowthPolicy>::IsInline() const
+{
+    return m_pData == m_pInlineData && m_pInlineData != 0;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::self_type& CVector<TValue, TAllocator, TGrowthPolicy>::operator=(const self_type& _rVector)
+{
+    if (this != &_rVector)
+    {
+        Assign(_rVector.GetData(), _rVector.GetData() + _rVector.m_ElementCount);
+    }
+    return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::self_type& CVector<TValue, TAllocator>::operator=(const self_type& _rVector)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::self_type& CVector<TValue, TAllocator, TGrowthPolicy>::operator=(self_type&& _rVector)
 {
     if (this != &_rVector)
     {
-        // todo: assign
+        Remove(Begin(), End());
+        FreeData();
 
+        m_Allocator    = _rVector.m_Allocator;
+        m_GrowthPolicy = _rVector.m_GrowthPolicy;
+        m_Capacity     = m_InlineCapacity;
+        m_pData        = m_pInlineData;
+
+        TakeData(_rVector);
     }
     return *this;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::iterator CVector<TValue, TAllocator>::Begin()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Begin()
 {
     return m_pData;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::const_iterator CVector<TValue, TAllocator>::Begin() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::const_iterator CVector<TValue, TAllocator, TGrowthPolicy>::Begin() const
 {
     return m_pData;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::reverse_iterator CVector<TValue, TAllocator>::RBegin()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::reverse_iterator CVector<TValue, TAllocator, TGrowthPolicy>::RBegin()
 {
-    return m_pData + m_ElementCount - 1;
+    return reverse_iterator(End() - 1);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::const_reverse_iterator CVector<TValue, TAllocator>::RBegin() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::const_reverse_iterator CVector<TValue, TAllocator, TGrowthPolicy>::RBegin() const
 {
-    return m_pData + m_ElementCount - 1;
+    return const_reverse_iterator(End() - 1);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::iterator CVector<TValue, TAllocator>::End()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::End()
 {
     return m_pData + m_ElementCount;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::const_iterator CVector<TValue, TAllocator>::End() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::const_iterator CVector<TValue, TAllocator, TGrowthPolicy>::End() const
 {
     return m_pData + m_ElementCount;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::reverse_iterator CVector<TValue, TAllocator>::REnd()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::reverse_iterator CVector<TValue, TAllocator, TGrowthPolicy>::REnd()
 {
-    return m_pData - m_ElementCount;
+    return reverse_iterator(Begin() - 1);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::const_reverse_iterator CVector<TValue, TAllocator>::REnd() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::const_reverse_iterator CVector<TValue, TAllocator, TGrowthPolicy>::REnd() const
 {
-    return m_pData - m_ElementCount;
+    return const_reverse_iterator(Begin() - 1);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-void CVector<TValue, TAllocator>::PushBack(value_const_reference_type _rItem)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::PushBack(value_const_reference_type _rItem)
 {
-    if (m_ElementCount == m_Capacity && !Resize())
+    EmplaceBack(_rItem);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::PushBack(value_type&& _rItem)
+{
+    EmplaceBack(std::move(_rItem));
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename... TArgs>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_reference_type CVector<TValue, TAllocator, TGrowthPolicy>::EmplaceBack(TArgs&&... _Args)
+{
+    if (m_ElementCount == m_Capacity)
+    { // the arguments may refer to elements, build the value before they move
+        value_type Temp(std::forward<TArgs>(_Args)...);
+        Grow(m_ElementCount + 1);
+        m_Allocator.Construct(m_pData + m_ElementCount, std::move(Temp));
+    }
+    else
     {
-        return;
+        m_Allocator.Construct(m_pData + m_ElementCount, std::forward<TArgs>(_Args)...);
     }
 
-    m_Allocator.Construct(m_pData + m_ElementCount, _rItem);
+    return *(m_pData + m_ElementCount++);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename... TArgs>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Emplace(const_iterator _Pos, TArgs&&... _Args)
+{
+    size_type Index = _Pos.m_pValue - m_pData;
+
+    if (Index == m_ElementCount)
+    {
+        EmplaceBack(std::forward<TArgs>(_Args)...);
+        return Begin() + Index;
+    }
+
+    value_type Temp(std::forward<TArgs>(_Args)...);
+
+    if (m_ElementCount == m_Capacity)
+    {
+        Grow(m_ElementCount + 1);
+    }
+
+    ShiftRight(Begin() + Index, 1, relocation_tag());
+    Fill(m_pData + Index, std::move(Temp), relocation_tag());
     ++m_ElementCount;
+
+    return Begin() + Index;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Insert(const_iterator _Pos, value_const_reference_type _rItem)
+{
+    return Emplace(_Pos, _rItem);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Insert(const_iterator _Pos, value_type&& _rItem)
+{
+    return Emplace(_Pos, std::move(_rItem));
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Insert(const_iterator _Pos, TIterator _First, TIterator _Last)
+{
+    size_type Index = _Pos.m_pValue - m_pData;
+
+    InsertRange(Index, _First, _Last, typename SIteratorTraits<TIterator>::iterator_tag_type());
+
+    return Begin() + Index;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Append(TIterator _First, TIterator _Last)
+{
+    Insert(End(), _First, _Last);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Assign(TIterator _First, TIterator _Last)
+{
+    AssignRange(_First, _Last, typename SIteratorTraits<TIterator>::iterator_tag_type());
 }
 
-template <typename TValue, template <typename> class TAllocator>
-void CVector<TValue, TAllocator>::PopBack()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Resize(size_type _Count)
+{
+    if (_Count < m_ElementCount)
+    {
+        Remove(Begin() + _Count, End());
+    }
+    else if (_Count > m_ElementCount)
+    {
+        if (_Count > m_Capacity)
+        {
+            Grow(_Count);
+        }
+
+        ConstructFill(m_pData + m_ElementCount, _Count - m_ElementCount);
+        m_ElementCount = _Count;
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Resize(size_type _Count, value_const_reference_type _rValue)
+{
+    if (_Count < m_ElementCount)
+    {
+        Remove(Begin() + _Count, End());
+    }
+    else if (_Count > m_Capacity)
+    { // _rValue may be an element, copy it before the block moves
+        value_type Temp(_rValue);
+        Grow(_Count);
+        ConstructFill(m_pData + m_ElementCount, _Count - m_ElementCount, Temp);
+        m_ElementCount = _Count;
+    }
+    else
+    {
+        ConstructFill(m_pData + m_ElementCount, _Count - m_ElementCount, _rValue);
+        m_ElementCount = _Count;
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::PopBack()
 {
     value_pointer_type pMem = (--End()).m_pValue;
     m_Allocator.Destroy(pMem);
     --m_ElementCount;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::iterator CVector<TValue, TAllocator>::Remove(iterator _Pos)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Remove(iterator _Pos)
 {
-    m_Allocator.Destroy(_Pos.m_pValue);
-    ShiftLeft(++_Pos, 1);
+    ShiftLeft(_Pos + 1, 1, relocation_tag());
     --m_ElementCount;
     return _Pos;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::iterator CVector<TValue, TAllocator>::Remove(iterator _First, iterator _Last)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::Remove(iterator _First, iterator _Last)
+{
+    size_type Distance = _Last.m_pValue - _First.m_pValue;
+    ShiftLeft(_Last, Distance, relocation_tag());
+    m_ElementCount -= Distance;
+
+    return _First;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::iterator CVector<TValue, TAllocator, TGrowthPolicy>::RemoveUnordered(iterator _Pos)
 {
-    for (iterator It = _First; It != _Last; ++It)
+    value_pointer_type pLast = m_pData + m_ElementCount - 1;
+
+    if (_Pos.m_pValue != pLast)
     {
-        m_Allocator.Destroy(It.m_pValue);
+        *_Pos = std::move(*pLast);
     }
-    
-    int distance = (_Last.m_pValue - _First.m_pValue) / sizeof(value_type);
-    ShiftLeft(_Last, distance);
-    m_ElementCount -= distance;
+    m_Allocator.Destroy(pLast);
+    --m_ElementCount;
 
-    return _First;
+    return _Pos;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::value_reference_type CVector<TValue, TAllocator>::operator[](size_type _Index) throw()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TPredicate>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::size_type CVector<TValue, TAllocator, TGrowthPolicy>::RemoveIf(TPredicate _Predicate)
+{
+    value_pointer_type pEnd    = m_pData + m_ElementCount;
+    value_pointer_type pTarget = m_pData;
+
+    // elements in front of the first match stay where they are
+    while (pTarget != pEnd && !_Predicate(*pTarget))
+    {
+        ++pTarget;
+    }
+
+    if (pTarget == pEnd)
+    {
+        return 0;
+    }
+
+    for (value_pointer_type pSource = pTarget + 1; pSource != pEnd; ++pSource)
+    {
+        if (!_Predicate(*pSource))
+        {
+            *pTarget = std::move(*pSource);
+            ++pTarget;
+        }
+    }
+
+    return Truncate(pTarget);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::size_type CVector<TValue, TAllocator, TGrowthPolicy>::RemoveIndices(TIterator _First, TIterator _Last)
+{
+    if (_First == _Last)
+    {
+        return 0;
+    }
+
+    assert(static_cast<size_type>(*_First) < m_ElementCount);
+
+    value_pointer_type pTarget = m_pData + *_First;
+
+    for (size_type Index = *_First; Index < m_ElementCount; ++Index)
+    {
+        if (_First != _Last && static_cast<size_type>(*_First) == Index)
+        {
+            // repeated indices remove the element once
+            do
+            {
+                ++_First;
+            } while (_First != _Last && static_cast<size_type>(*_First) == Index);
+
+            assert(_First == _Last || static_cast<size_type>(*_First) > Index);
+            continue;
+        }
+
+        *pTarget = std::move(m_pData[Index]);
+        ++pTarget;
+    }
+
+    assert(_First == _Last);
+    return Truncate(pTarget);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_reference_type CVector<TValue, TAllocator, TGrowthPolicy>::operator[](size_type _Index) throw()
 {
     return *(m_pData + _Index);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::value_const_reference_type CVector<TValue, TAllocator>::operator[](size_type _Index) const throw()
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_const_reference_type CVector<TValue, TAllocator, TGrowthPolicy>::operator[](size_type _Index) const throw()
 {
     return *(m_pData + _Index);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::value_reference_type CVector<TValue, TAllocator>::At(size_type _Index)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_reference_type CVector<TValue, TAllocator, TGrowthPolicy>::At(size_type _Index)
 {
     if (_Index >= m_ElementCount)
     {
-        throw std::exception("index out of range");
+        throw std::out_of_range("index out of range");
     }
     
     return *(m_pData + _Index);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::value_const_reference_type CVector<TValue, TAllocator>::At(size_type _Index) const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_const_reference_type CVector<TValue, TAllocator, TGrowthPolicy>::At(size_type _Index) const
 {
     if (_Index >= m_ElementCount)
     {
-        throw std::exception("index out of range");
+        throw std::out_of_range("index out of range");
     }
 
     return *(m_pData + _Index);
 }
 
-template <typename TValue, template <typename> class TAllocator>
-typename CVector<TValue, TAllocator>::size_type CVector<TValue, TAllocator>::GetCount() const
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Reserve(size_type _Capacity)
+{
+    if (_Capacity > m_Capacity)
+    {
+        Reallocate(_Capacity);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ShrinkToFit()
+{
+    if (m_ElementCount < m_Capacity)
+    {
+        Reallocate(m_ElementCount);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Swap(self_type& _rVector)
+{
+    if (IsInline() || _rVector.IsInline())
+    { // inline elements cannot change their owner, move them through a temporary
+        self_type Temp(std::move(_rVector));
+        _rVector = std::move(*this);
+        *this    = std::move(Temp);
+        return;
+    }
+
+    allocator_type     TempAllocator    = m_Allocator;
+    growth_policy_type TempGrowthPolicy = m_GrowthPolicy;
+    size_type          TempCapacity     = m_Capacity;
+    size_type          TempCount        = m_ElementCount;
+    value_pointer_type pTempData        = m_pData;
+
+    m_Allocator    = _rVector.m_Allocator;
+    m_GrowthPolicy = _rVector.m_GrowthPolicy;
+    m_Capacity     = _rVector.m_Capacity;
+    m_ElementCount = _rVector.m_ElementCount;
+    m_pData        = _rVector.m_pData;
+
+    _rVector.m_Allocator    = TempAllocator;
+    _rVector.m_GrowthPolicy = TempGrowthPolicy;
+    _rVector.m_Capacity     = TempCapacity;
+    _rVector.m_ElementCount = TempCount;
+    _rVector.m_pData        = pTempData;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::size_type CVector<TValue, TAllocator, TGrowthPolicy>::GetCount() const
 {
     return m_ElementCount;
 }
 
-template <typename TValue, template <typename> class TAllocator>
-bool CVector<TValue, TAllocator>::Resize(size_type _minIncrease = 1)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::size_type CVector<TValue, TAllocator, TGrowthPolicy>::GetCapacity() const
+{
+    return m_Capacity;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::allocator_type CVector<TValue, TAllocator, TGrowthPolicy>::GetAllocator() const
+{
+    return m_Allocator;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::growth_policy_type CVector<TValue, TAllocator, TGrowthPolicy>::GetGrowthPolicy() const
+{
+    return m_GrowthPolicy;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_pointer_type CVector<TValue, TAllocator, TGrowthPolicy>::GetData()
+{
+    return BASE::MEM::AssumeAligned<s_Alignment>(m_pData);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::value_const_pointer_type CVector<TValue, TAllocator, TGrowthPolicy>::GetData() const
+{
+    return BASE::MEM::AssumeAligned<s_Alignment>(static_cast<value_const_pointer_type>(m_pData));
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Grow(size_type _MinCapacity)
+{
+    Reallocate(m_GrowthPolicy.GetNextCapacity(m_Capacity, _MinCapacity));
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::InsertRange(size_type _Index, TIterator _First, TIterator _Last, SInputIteratorTag)
+{
+    // the range can be read only once, its length is unknown up front
+    size_type OldCount = m_ElementCount;
+
+    for (; _First != _Last; ++_First)
+    {
+        EmplaceBack(*_First);
+    }
+
+    std::rotate(m_pData + _Index, m_pData + OldCount, m_pData + m_ElementCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::InsertRange(size_type _Index, TIterator _First, TIterator _Last, SForwardIteratorTag)
+{
+    typedef decltype(*_First) reference;
+    typedef std::integral_constant<bool, std::is_lvalue_reference<reference>::value
+        && std::is_same<typename std::remove_cv<typename std::remove_reference<reference>::type>::type, value_type>::value> element_tag;
+
+    size_type Count = Distance(_First, _Last);
+
+    if (m_ElementCount + Count > m_Capacity)
+    {
+        if (Count > 0 && IsElement(_First, element_tag()))
+        { // the range would go with the old block, insert a copy of it
+            self_type Temp(m_Allocator);
+            Temp.Assign(_First, _Last);
+            InsertRange(_Index, Temp.GetData(), Temp.GetData() + Count, SForwardIteratorTag());
+            return;
+        }
+
+        Grow(m_ElementCount + Count);
+    }
+
+    // append and rotate into place, a range inside the vector stays valid while it is read
+    ConstructRange(m_pData + m_ElementCount, _First, _Last);
+    m_ElementCount += Count;
+
+    std::rotate(m_pData + _Index, m_pData + m_ElementCount - Count, m_pData + m_ElementCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::AssignRange(TIterator _First, TIterator _Last, SInputIteratorTag)
+{
+    Remove(Begin(), End());
+
+    for (; _First != _Last; ++_First)
+    {
+        EmplaceBack(*_First);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::AssignRange(TIterator _First, TIterator _Last, SForwardIteratorTag)
+{
+    size_type Count = Distance(_First, _Last);
+
+    Remove(Begin(), End());
+
+    if (Count > m_Capacity)
+    { // nothing to keep, the exact size saves memory on the usual assign-once vectors
+        Reallocate(Count);
+    }
+
+    ConstructRange(m_pData, _First, _Last);
+    m_ElementCount = Count;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+bool CVector<TValue, TAllocator, TGrowthPolicy>::IsElement(TIterator _It, std::true_type) const
 {
-    size_type targetCapacity = m_Capacity + (_minIncrease > m_Increase ? _minIncrease : m_Increase);
-    value_pointer_type pTempData = m_Allocator.Allocate(targetCapacity);
+    const value_type* pElement = &*_It;
 
-    for (size_type Pos = 0; Pos < m_ElementCount; ++Pos)
+    return !std::less<const value_type*>()(pElement, m_pData) && std::less<const value_type*>()(pElement, m_pData + m_ElementCount);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+bool CVector<TValue, TAllocator, TGrowthPolicy>::IsElement(TIterator, std::false_type) const
+{
+    return false;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Reallocate(size_type _Capacity)
+{
+    if (_Capacity <= m_InlineCapacity && m_pInlineData != 0)
+    { // small enough for the inline storage
+        if (!IsInline())
+        {
+            RelocateRange(m_pInlineData, m_pData, m_pData + m_ElementCount, relocation_tag());
+            FreeData();
+            m_pData = m_pInlineData;
+        }
+        _Capacity = m_InlineCapacity;
+    }
+    else if (_Capacity == 0)
     {
-        m_Allocator.Construct(pTempData + Pos, *(m_pData + Pos));
-        m_Allocator.Destroy(m_pData + Pos);
+        m_Allocator.Deallocate(m_pData, m_Capacity);
+        m_pData = 0;
+    }
+    else if (IsInline())
+    { // the inline storage cannot grow, the elements move out of it
+        value_pointer_type pTempData = m_Allocator.Allocate(_Capacity);
+        RelocateRange(pTempData, m_pData, m_pData + m_ElementCount, relocation_tag());
+        m_pData = pTempData;
     }
+    // grow in place where the allocator can, so nothing moves at all
+    else if (!BASE::MEM::SAllocatorTraits<allocator_type>::TryExpand(m_Allocator, m_pData, m_Capacity, _Capacity))
+    {
+        Relocate(_Capacity, relocation_tag());
+    }
+
+    m_Capacity = _Capacity;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Relocate(size_type _Capacity, std::true_type)
+{
+    // trivially relocatable, the allocator may move the block (realloc, mremap)
+    m_pData = BASE::MEM::SAllocatorTraits<allocator_type>::Reallocate(m_Allocator, m_pData, m_Capacity, _Capacity);
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Relocate(size_type _Capacity, std::false_type)
+{
+    value_pointer_type pTempData = m_Allocator.Allocate(_Capacity);
+
+    RelocateRange(pTempData, m_pData, m_pData + m_ElementCount, std::false_type());
 
     m_Allocator.Deallocate(m_pData, m_Capacity);
     m_pData = pTempData;
-    m_Capacity = targetCapacity;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::RelocateRange(value_pointer_type _pTarget, value_pointer_type _pFirst, value_pointer_type _pLast, std::true_type)
+{
+    if (_pFirst != _pLast)
+    {
+        memcpy(static_cast<void*>(_pTarget), _pFirst, (_pLast - _pFirst) * sizeof(value_type));
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::RelocateRange(value_pointer_type _pTarget, value_pointer_type _pFirst, value_pointer_type _pLast, std::false_type)
+{
+    for (; _pFirst != _pLast; ++_pTarget, ++_pFirst)
+    {
+        m_Allocator.Construct(_pTarget, std::move_if_noexcept(*_pFirst));
+        m_Allocator.Destroy(_pFirst);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ConstructRange(value_pointer_type _pTarget, TIterator _First, TIterator _Last)
+{
+    typedef typename std::remove_cv<typename std::remove_pointer<TIterator>::type>::type source_type;
 
-    return true;
+    // plain copies of our own type can go as one block
+    ConstructRange(_pTarget, _First, _Last, std::integral_constant<bool,
+        std::is_pointer<TIterator>::value && std::is_same<source_type, value_type>::value && BASE::TYPET::SIsTriviallyCopyable<value_type>::Result>());
 }
 
-template <typename TValue, template <typename> class TAllocator>
-void CVector<TValue, TAllocator>::ShiftLeft(iterator _Begin, int _Count)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ConstructRange(value_pointer_type _pTarget, TIterator _First, TIterator _Last, std::true_type)
 {
-    iterator TargetIt(_Begin - _Count);
+    if (_First != _Last)
+    {
+        memcpy(static_cast<void*>(_pTarget), _First, (_Last - _First) * sizeof(value_type));
+    }
+}
 
-    for (; _Begin != End(); ++TargetIt, ++_Begin)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename TIterator>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ConstructRange(value_pointer_type _pTarget, TIterator _First, TIterator _Last, std::false_type)
+{
+    for (; _First != _Last; ++_pTarget, ++_First)
     {
-        *TargetIt = *_Begin;
+        m_Allocator.Construct(_pTarget, *_First);
     }
+}
 
-    for (; TargetIt != End(); ++TargetIt)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+template <typename... TArgs>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ConstructFill(value_pointer_type _pTarget, size_type _Count, const TArgs&... _Args)
+{
+    for (value_pointer_type pEnd = _pTarget + _Count; _pTarget != pEnd; ++_pTarget)
     {
-        m_Allocator.Destroy(TargetIt.m_pValue);
+        m_Allocator.Construct(_pTarget, _Args...);
     }
 }
 
-template <typename TValue, template <typename> class TAllocator>
-void CVector<TValue, TAllocator>::ShiftRight(iterator _Begin, int _Count)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+typename CVector<TValue, TAllocator, TGrowthPolicy>::size_type CVector<TValue, TAllocator, TGrowthPolicy>::Truncate(value_pointer_type _pEnd)
 {
-    iterator targetIt = End() + (_Count - 1);
-    iterator sourceIt = End() - 1;
+    value_pointer_type pEnd    = m_pData + m_ElementCount;
+    size_type          Removed = pEnd - _pEnd;
 
-    for (; targetIt != --End(); --sourceIt, --targetIt)
+    for (; _pEnd != pEnd; ++_pEnd)
     {
-        m_Allocator.Construct(targetIt.m_pValue, *sourceIt);
+        m_Allocator.Destroy(_pEnd);
     }
+    m_ElementCount -= Removed;
+
+    return Removed;
+}
 
-    for (; sourceIt != --_Begin; --sourceIt, --targetIt)
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::FreeData()
+{
+    if (m_pData != m_pInlineData)
     {
-        *targetIt = *sourceIt;
+        m_Allocator.Deallocate(m_pData, m_Capacity);
     }
 }
 
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::TakeData(self_type& _rVector)
+{
+    // expects an empty vector holding its own (inline or null) block
+    if (!_rVector.IsInline())
+    {
+        m_Capacity = _rVector.m_Capacity;
+        m_pData    = _rVector.m_pData;
+    }
+    else if (_rVector.m_ElementCount > m_Capacity)
+    {
+        m_pData    = m_Allocator.Allocate(_rVector.m_ElementCount);
+        m_Capacity = _rVector.m_ElementCount;
+    }
+
+    m_ElementCount = _rVector.m_ElementCount;
+
+    if (_rVector.IsInline())
+    {
+        RelocateRange(m_pData, _rVector.m_pData, _rVector.m_pData + m_ElementCount, relocation_tag());
+    }
+
+    _rVector.m_Capacity     = _rVector.m_InlineCapacity;
+    _rVector.m_ElementCount = 0;
+    _rVector.m_pData        = _rVector.m_pInlineData;
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ShiftLeft(iterator _Begin, size_type _Count, std::true_type)
+{
+    value_pointer_type pTarget = _Begin.m_pValue - _Count;
+    size_type          Tail    = m_pData + m_ElementCount - _Begin.m_pValue;
+
+    for (value_pointer_type pRemoved = pTarget; pRemoved != _Begin.m_pValue; ++pRemoved)
+    {
+        m_Allocator.Destroy(pRemoved);
+    }
+
+    if (Tail > 0)
+    {
+        memmove(static_cast<void*>(pTarget), _Begin.m_pValue, Tail * sizeof(value_type));
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ShiftLeft(iterator _Begin, size_type _Count, std::false_type)
+{
+    value_pointer_type pTarget = _Begin.m_pValue - _Count;
+    value_pointer_type pEnd    = m_pData + m_ElementCount;
+
+    for (value_pointer_type pSource = _Begin.m_pValue; pSource != pEnd; ++pTarget, ++pSource)
+    {
+        *pTarget = std::move(*pSource);
+    }
+
+    for (; pTarget != pEnd; ++pTarget)
+    {
+        m_Allocator.Destroy(pTarget);
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ShiftRight(iterator _Begin, size_type _Count, std::true_type)
+{
+    size_type Tail = m_pData + m_ElementCount - _Begin.m_pValue;
+
+    if (Tail > 0)
+    {
+        memmove(static_cast<void*>(_Begin.m_pValue + _Count), _Begin.m_pValue, Tail * sizeof(value_type));
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::ShiftRight(iterator _Begin, size_type _Count, std::false_type)
+{
+    value_pointer_type pEnd    = m_pData + m_ElementCount;
+    value_pointer_type pSource = pEnd;
+
+    // targets behind the end are raw memory, the others hold live elements
+    while (pSource != _Begin.m_pValue)
+    {
+        --pSource;
+        value_pointer_type pTarget = pSource + _Count;
+
+        if (pTarget >= pEnd)
+        {
+            m_Allocator.Construct(pTarget, std::move(*pSource));
+        }
+        else
+        {
+            *pTarget = std::move(*pSource);
+        }
+    }
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Fill(value_pointer_type _pSlot, value_type&& _rValue, std::true_type)
+{
+    m_Allocator.Construct(_pSlot, std::move(_rValue));
+}
+
+template <typename TValue, template <typename> class TAllocator, typename TGrowthPolicy>
+void CVector<TValue, TAllocator, TGrowthPolicy>::Fill(value_pointer_type _pSlot, value_type&& _rValue, std::false_type)
+{
+    *_pSlot = std::move(_rValue);
+}
 
     } // namespace CNT
 } // namespace BASE
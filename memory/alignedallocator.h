@@ -0,0 +1,148 @@
+#ifndef __INCLUDE_ALIGNED_ALLOCATOR_H_
+#define __INCLUDE_ALIGNED_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include "allocator.h"
+#include "alignment.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Allocator returning memory aligned to Alignment bytes (at least alignof(T)).
+ * The alignment is advertised through s_Alignment, which SAllocatorTraits
+ * picks up and which lets CVector hand out its data for aligned SIMD loads.
+ * As containers take a template with a single parameter, bind the alignment
+ * with an alias template, e.g. CCacheAlignedAllocator below.
+ **/
+template <typename T, size_t Alignment>
+class CAlignedAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CAlignedAllocator<T, Alignment> self;
+
+    static const size_type s_Alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CAlignedAllocator<U, Alignment> other;
+    };
+
+public:
+
+    CAlignedAllocator();
+    CAlignedAllocator(const self&);
+    self& operator=(const self&);
+
+    template <typename U>
+    CAlignedAllocator(const CAlignedAllocator<U, Alignment>&);
+
+    template <typename U>
+    self& operator=(const CAlignedAllocator<U, Alignment>&);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type);
+};
+
+template <typename T>
+using CCacheAlignedAllocator = CAlignedAllocator<T, s_CacheLineSize>;
+
+template <typename T, size_t Alignment>
+CAlignedAllocator<T, Alignment>::CAlignedAllocator()
+{
+}
+
+template <typename T, size_t Alignment>
+CAlignedAllocator<T, Alignment>::CAlignedAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+{
+}
+
+template <typename T, size_t Alignment>
+template <typename U>
+CAlignedAllocator<T, Alignment>::CAlignedAllocator(const CAlignedAllocator<U, Alignment>&)
+{
+}
+
+template <typename T, size_t Alignment>
+typename CAlignedAllocator<T, Alignment>::self&
+CAlignedAllocator<T, Alignment>::operator=(const self&)
+{
+    return (*this);
+}
+
+template <typename T, size_t Alignment>
+template <typename U>
+typename CAlignedAllocator<T, Alignment>::self&
+CAlignedAllocator<T, Alignment>::operator=(const CAlignedAllocator<U, Alignment>&)
+{
+    return (*this);
+}
+
+template <typename T, size_t Alignment>
+typename CAlignedAllocator<T, Alignment>::pointer
+CAlignedAllocator<T, Alignment>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    return static_cast<T*>(AllocateAligned(_Count * sizeof(T), s_Alignment));
+}
+
+template <typename T, size_t Alignment>
+void
+CAlignedAllocator<T, Alignment>::Deallocate(pointer _pMem, size_type)
+{
+    if (_pMem != 0)
+    {
+        DeallocateAligned(_pMem);
+    }
+}
+
+template <typename T1, typename T2, size_t Alignment>
+bool
+operator==(const CAlignedAllocator<T1, Alignment>&, const CAlignedAllocator<T2, Alignment>&)
+{
+    return true;
+}
+
+template <typename T1, typename T2, size_t Alignment>
+bool
+operator!=(const CAlignedAllocator<T1, Alignment>&, const CAlignedAllocator<T2, Alignment>&)
+{
+    return false;
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_ALIGNED_ALLOCATOR_H_
@@ -0,0 +1,112 @@
+#ifndef __INCLUDE_ALIGNMENT_H_
+#define __INCLUDE_ALIGNMENT_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <new>
+
+#ifdef _WIN32
+#   include <malloc.h>
+#endif
+
+namespace BASE {
+    namespace MEM {
+
+
+static const size_t s_CacheLineSize = 64;                               // also the width of an AVX-512 register
+
+/**
+ * Allocates _Size bytes aligned to _Alignment, which has to be a power of two.
+ * Throws std::bad_alloc on failure. Has to be released by DeallocateAligned.
+ **/
+inline void*
+AllocateAligned(size_t _Size, size_t _Alignment)
+{
+    assert((_Alignment & (_Alignment - 1)) == 0 && "alignment has to be a power of two");
+
+    if (_Alignment < sizeof(void*))
+    {
+        _Alignment = sizeof(void*);
+    }
+
+#ifdef _WIN32
+    void* pMem = _aligned_malloc(_Size, _Alignment);
+#else
+    void* pMem = 0;
+    if (posix_memalign(&pMem, _Alignment, _Size) != 0)
+    {
+        pMem = 0;
+    }
+#endif
+
+    if (pMem == 0)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pMem;
+}
+
+inline void
+DeallocateAligned(void* _pMem)
+{
+#ifdef _WIN32
+    _aligned_free(_pMem);
+#else
+    free(_pMem);
+#endif
+}
+
+inline bool
+IsAligned(const void* _pMem, size_t _Alignment)
+{
+    return reinterpret_cast<size_t>(_pMem) % _Alignment == 0;
+}
+
+/**
+ * Tells the compiler that _pMem is aligned to Alignment bytes, so loops
+ * over it are vectorized with aligned loads and without peeling.
+ **/
+template <size_t Alignment, typename T>
+inline T*
+AssumeAligned(T* _pMem)
+{
+    assert(_pMem == 0 || IsAligned(_pMem, Alignment));
+
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(_pMem, Alignment));
+#elif defined(_MSC_VER)
+    __assume(reinterpret_cast<size_t>(_pMem) % Alignment == 0);
+    return _pMem;
+#else
+    return _pMem;
+#endif
+}
+
+/**
+ * Pads and aligns a value to a cache line of its own, so neighbouring
+ * elements written by different threads do not share a line.
+ **/
+template <typename T>
+struct alignas(s_CacheLineSize) SCacheAligned
+{
+    T m_Value;
+};
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_ALIGNMENT_H_
@@ -11,10 +11,26 @@
  * @email   david.dw.wieland@googlemail.com                                         *
  ************************************************************************************/
 
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
 namespace BASE {
     namespace MEM {
 
 
+/**
+ * Default allocator of all containers, stateless wrapper around malloc and free.
+ * Blocks of trivially relocatable content can grow by Reallocate (realloc),
+ * see SAllocatorTraits for this optional part of the interface.
+ * Stateful allocators derive from it, provide their own Allocate/Deallocate,
+ * SRebind, a copy constructor with a matching copy assignment and
+ * operator==, and are passed to the container constructors.
+ * Containers take the allocator along on copy construction, move and swap
+ * (move assignment and Swap copy assign it); copy assignment keeps the
+ * allocator of the assigned-to container.
+ **/
 template <typename T>
 class CAllocator
 {
@@ -41,6 +57,7 @@ public:
 
     CAllocator();
     CAllocator(const self&);
+    self& operator=(const self&);
 
     template <typename U>
     CAllocator(const CAllocator<U>&);
@@ -55,8 +72,10 @@ public:
 
     pointer Allocate(size_type _Count);
     void    Deallocate(pointer _pMem, size_type);
+    pointer Reallocate(pointer _pMem, size_type _Count, size_type _NewCount);
 
-    void Construct(pointer _pMem, const_reference _rValue);
+    template <typename... TArgs>
+    void Construct(pointer _pMem, TArgs&&... _Args);                 // placement new forwarding _Args
     void Destroy(pointer _pMem);
 
     size_type GetMaxSize() const;
@@ -81,6 +100,13 @@ CAllocator<T>::CAllocator(const CAllocator<U>&)
 
 }
 
+template <typename T>
+typename CAllocator<T>::self&
+CAllocator<T>::operator=(const self&)
+{
+    return (*this);
+}
+
 template <typename T>
 template <typename U>
 typename CAllocator<T>::self&
@@ -107,9 +133,14 @@ template <typename T>
 typename CAllocator<T>::pointer
 CAllocator<T>::Allocate(size_type _Count)
 {
-    void* pMem = 0;
-    if (_Count > 0 && _Count <= GetMaxSize())
-        pMem = ::operator new(_Count * sizeof(T));
+    if (_Count == 0)
+        return 0;
+    if (_Count > GetMaxSize())
+        throw std::bad_alloc();
+
+    void* pMem = malloc(_Count * sizeof(T));
+    if (pMem == 0)
+        throw std::bad_alloc();
 
     return static_cast<T*>(pMem);
 }
@@ -118,15 +149,35 @@ template <typename T>
 void
 CAllocator<T>::Deallocate(pointer _pMem, size_type)
 {
-    ::operator delete(_pMem);
+    free(_pMem);
+}
+
+template <typename T>
+typename CAllocator<T>::pointer
+CAllocator<T>::Reallocate(pointer _pMem, size_type, size_type _NewCount)
+{
+    if (_NewCount == 0)
+    {
+        free(_pMem);
+        return 0;
+    }
+    if (_NewCount > GetMaxSize())
+        throw std::bad_alloc(); // the old block stays valid, as with a failing realloc
+
+    void* pMem = realloc(static_cast<void*>(_pMem), _NewCount * sizeof(T));
+    if (pMem == 0)
+        throw std::bad_alloc();
+
+    return static_cast<T*>(pMem);
 }
 
 template <typename T>
+template <typename... TArgs>
 void
-CAllocator<T>::Construct(pointer _pMem, const_reference _rValue)
+CAllocator<T>::Construct(pointer _pMem, TArgs&&... _Args)
 {
     void* pMem = _pMem;
-    ::new (pMem) T(_rValue);
+    ::new (pMem) T(std::forward<TArgs>(_Args)...);
 }
 
 #pragma warning(disable: 4100)
@@ -148,14 +199,14 @@ CAllocator<T>::GetMaxSize() const
 
 template <typename T1, typename T2>
 bool
-operator==(const T1&, const T2&)
+operator==(const CAllocator<T1>&, const CAllocator<T2>&)
 {
-    return true;
+    return true; // stateless, memory of one instance can be freed by any other
 }
 
 template <typename T1, typename T2>
 bool
-operator!=(const T1&, const T2&)
+operator!=(const CAllocator<T1>&, const CAllocator<T2>&)
 {
     return false;
 }
@@ -0,0 +1,167 @@
+#ifndef __INCLUDE_ALLOCATOR_TRAITS_H_
+#define __INCLUDE_ALLOCATOR_TRAITS_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Optional capabilities of an allocator, detected at compile time.
+ * An allocator may declare
+ *     bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+ *     pointer Reallocate(pointer _pMem, size_type _Count, size_type _NewCount);
+ * TryExpand grows a block without moving it and returns false if that is
+ * not possible. Reallocate resizes a block and may move its bytes, so it is
+ * only allowed for trivially relocatable content; it throws std::bad_alloc
+ * and leaves the old block intact on failure. Only members declared by the
+ * allocator itself count, the ones inherited from CAllocator are ignored, as
+ * they would work on the wrong heap. Missing capabilities are emulated here.
+ * An allocator may also state the alignment of its blocks in s_Alignment;
+ * without it alignof(max_align_t) is assumed, which is what malloc gives.
+ **/
+template <typename TAllocator, bool Declared>
+struct SAllocatorAlignment
+{
+    static const size_t value = alignof(std::max_align_t);
+};
+
+template <typename TAllocator>
+struct SAllocatorAlignment<TAllocator, true>
+{
+    static const size_t value = TAllocator::s_Alignment;
+};
+
+template <typename TAllocator>
+struct SAllocatorTraits
+{
+    typedef typename TAllocator::pointer   pointer;
+    typedef typename TAllocator::size_type size_type;
+
+private: // detection
+
+    typedef bool    (TAllocator::*expand_type)(pointer, size_type, size_type);
+    typedef pointer (TAllocator::*reallocate_type)(pointer, size_type, size_type);
+
+    template <typename U>
+    static char HasExpand(typename std::enable_if<std::is_same<decltype(&U::TryExpand), expand_type>::value>::type*);
+    template <typename U>
+    static long HasExpand(...);
+
+    template <typename U>
+    static char HasReallocate(typename std::enable_if<std::is_same<decltype(&U::Reallocate), reallocate_type>::value>::type*);
+    template <typename U>
+    static long HasReallocate(...);
+
+    template <typename U>
+    static char HasAlignment(decltype(U::s_Alignment)*);
+    template <typename U>
+    static long HasAlignment(...);
+
+public:
+
+    enum { CanExpand     = sizeof(HasExpand<TAllocator>(0)) == sizeof(char) };
+    enum { CanReallocate = sizeof(HasReallocate<TAllocator>(0)) == sizeof(char) };
+
+    static const size_type s_Alignment = SAllocatorAlignment<TAllocator, sizeof(HasAlignment<TAllocator>(0)) == sizeof(char)>::value;   // guaranteed alignment of Allocate
+
+public: // operations
+
+    static bool    TryExpand(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount);
+    static pointer Reallocate(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount);
+
+private: // dispatch
+
+    static bool    TryExpand(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::true_type);
+    static bool    TryExpand(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::false_type);
+    static pointer Reallocate(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::true_type);
+    static pointer Reallocate(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::false_type);
+};
+
+template <typename TAllocator>
+bool
+SAllocatorTraits<TAllocator>::TryExpand(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_pMem == 0 || _NewCount < _Count)
+    {
+        return false;
+    }
+
+    return TryExpand(_rAllocator, _pMem, _Count, _NewCount, std::integral_constant<bool, CanExpand>());
+}
+
+template <typename TAllocator>
+typename SAllocatorTraits<TAllocator>::pointer
+SAllocatorTraits<TAllocator>::Reallocate(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_pMem == 0)
+    {
+        return _rAllocator.Allocate(_NewCount);
+    }
+
+    return Reallocate(_rAllocator, _pMem, _Count, _NewCount, std::integral_constant<bool, CanReallocate>());
+}
+
+template <typename TAllocator>
+bool
+SAllocatorTraits<TAllocator>::TryExpand(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::true_type)
+{
+    return _rAllocator.TryExpand(_pMem, _Count, _NewCount);
+}
+
+template <typename TAllocator>
+bool
+SAllocatorTraits<TAllocator>::TryExpand(TAllocator&, pointer, size_type, size_type, std::false_type)
+{
+    return false;
+}
+
+template <typename TAllocator>
+typename SAllocatorTraits<TAllocator>::pointer
+SAllocatorTraits<TAllocator>::Reallocate(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::true_type)
+{
+    return _rAllocator.Reallocate(_pMem, _Count, _NewCount);
+}
+
+template <typename TAllocator>
+typename SAllocatorTraits<TAllocator>::pointer
+SAllocatorTraits<TAllocator>::Reallocate(TAllocator& _rAllocator, pointer _pMem, size_type _Count, size_type _NewCount, std::false_type)
+{
+    if (TryExpand(_rAllocator, _pMem, _Count, _NewCount))
+    {
+        return _pMem;
+    }
+
+    pointer pNewMem = _rAllocator.Allocate(_NewCount);
+    if (pNewMem == 0 && _NewCount != 0)
+    {
+        throw std::bad_alloc();                                         // _pMem is still owned by the caller
+    }
+
+    memcpy(static_cast<void*>(pNewMem), _pMem, (_Count < _NewCount ? _Count : _NewCount) * sizeof(*_pMem));
+    _rAllocator.Deallocate(_pMem, _Count);
+
+    return pNewMem;
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_ALLOCATOR_TRAITS_H_
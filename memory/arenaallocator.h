@@ -0,0 +1,511 @@
+#ifndef __INCLUDE_ARENA_ALLOCATOR_H_
+#define __INCLUDE_ARENA_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <new>
+#include "allocator.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Monotonic memory arena.
+ * Memory is handed out by bumping a pointer through chunks, which grow
+ * geometrically. Single blocks are never freed, instead everything is
+ * released at once by Reset() or by leaving a CArenaScope. Not thread-safe.
+ **/
+class CArena
+{
+public: // static constants
+
+    static const size_t s_DefaultChunkSize = 64 * 1024;
+    static const size_t s_MaxChunkSize     = 64 * 1024 * 1024;
+
+private: // private forward declarations
+
+    struct SChunk;
+
+public: // position inside the arena, used for scoped release
+
+    struct SMark
+    {
+        SChunk* m_pChunk;
+        char*   m_pCursor;
+    };
+
+public: // ctor, dtor
+
+    explicit CArena(size_t _InitialChunkSize = s_DefaultChunkSize);
+    ~CArena();
+
+public: // operations
+
+    void* Allocate(size_t _Size, size_t _Alignment);                    // bump allocation, throws std::bad_alloc
+    bool  TryExpand(void* _pMem, size_t _Size, size_t _NewSize);        // grows the newest block in place
+
+    SMark GetMark() const;                                              // current fill position
+    void  Rewind(const SMark& _rMark);                                  // release everything allocated after _rMark
+    void  Reset();                                                      // release everything, keeps one chunk for reuse,
+                                                                        // not allowed while a CArenaScope is active
+
+public: // properties
+
+    size_t GetUsedSize() const;                                         // bytes handed out since the last reset
+    size_t GetReservedSize() const;                                     // bytes held in chunks
+
+    static CArena* GetCurrent();                                        // innermost arena bound by a CArenaScope
+    static void    SetCurrent(CArena* _pArena);
+
+private: // non-copyable
+
+    CArena(const CArena&);
+    CArena& operator=(const CArena&);
+
+private: // chunk declaration
+
+    struct SChunk
+    {
+        SChunk* m_pPrev;                                                // chunks form a stack, newest first
+        size_t  m_Size;                                                 // including this header
+        char*   m_pLeftCursor;                                          // cursor when a newer chunk was pushed
+    };
+
+    static const size_t s_ChunkHeaderSize = (sizeof(SChunk) + 15) / 16 * 16;
+
+private: // internal methods
+
+    void  PushChunk(size_t _MinPayload);
+    void  PopChunk();
+    char* GetPayload(SChunk* _pChunk) const;
+
+    static CArena*& GetCurrentSlot();
+
+private: // member
+
+    SChunk* m_pChunk;                                                   // chunk the cursor points into
+    char*   m_pCursor;
+    char*   m_pEnd;
+    size_t  m_NextChunkSize;
+    size_t  m_UsedSize;
+    size_t  m_ReservedSize;
+};
+
+/**
+ * Binds an arena to the current thread for the lifetime of the scope.
+ * Default constructed CArenaAllocators created inside the scope allocate
+ * from this arena. On destruction everything allocated inside the scope is
+ * released in one go, so all containers using it have to be gone by then.
+ **/
+class CArenaScope
+{
+public: // ctor, dtor
+
+    explicit CArenaScope(CArena& _rArena);
+    ~CArenaScope();
+
+private: // non-copyable
+
+    CArenaScope(const CArenaScope&);
+    CArenaScope& operator=(const CArenaScope&);
+
+private: // member
+
+    CArena*       m_pArena;
+    CArena*       m_pPrevious;
+    CArena::SMark m_Mark;
+};
+
+/**
+ * Allocator handing out memory from a CArena.
+ * Deallocate is a no-op, so tearing down a container only runs destructors.
+ * A default constructed instance binds to CArena::GetCurrent() and falls
+ * back to the global heap when no arena is bound. Rebinding keeps the arena.
+ **/
+template <typename T>
+class CArenaAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CArenaAllocator<T> self;
+
+    static const size_type s_Alignment = alignof(T);
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CArenaAllocator<U> other;
+    };
+
+public:
+
+    CArenaAllocator();
+    explicit CArenaAllocator(CArena& _rArena);
+    CArenaAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CArenaAllocator(const CArenaAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CArenaAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+    bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+
+    CArena* GetArena() const;                                           // 0 if serving from the global heap
+
+private:
+
+    CArena* m_pArena;
+};
+
+/*************************************************************************
+ * ARENA SUBSECTION
+ *************************************************************************/
+
+inline
+CArena::CArena(size_t _InitialChunkSize)
+    : m_pChunk(0)
+    , m_pCursor(0)
+    , m_pEnd(0)
+    , m_NextChunkSize(_InitialChunkSize > s_ChunkHeaderSize ? _InitialChunkSize : s_DefaultChunkSize)
+    , m_UsedSize(0)
+    , m_ReservedSize(0)
+{
+}
+
+inline
+CArena::~CArena()
+{
+    while (m_pChunk != 0)
+    {
+        PopChunk();
+    }
+}
+
+inline void*
+CArena::Allocate(size_t _Size, size_t _Alignment)
+{
+    assert((_Alignment & (_Alignment - 1)) == 0 && "alignment has to be a power of two");
+
+    size_t Padding = (_Alignment - reinterpret_cast<size_t>(m_pCursor) % _Alignment) % _Alignment;
+
+    if (m_pChunk == 0 || static_cast<size_t>(m_pEnd - m_pCursor) < _Size + Padding)
+    {
+        PushChunk(_Size + _Alignment);
+        Padding = (_Alignment - reinterpret_cast<size_t>(m_pCursor) % _Alignment) % _Alignment;
+    }
+
+    void* pMem = m_pCursor + Padding;
+    m_pCursor += Padding + _Size;
+    m_UsedSize += Padding + _Size;
+
+    return pMem;
+}
+
+inline bool
+CArena::TryExpand(void* _pMem, size_t _Size, size_t _NewSize)
+{
+    // only the block right below the cursor can grow
+    if (static_cast<char*>(_pMem) + _Size != m_pCursor || static_cast<size_t>(m_pEnd - m_pCursor) < _NewSize - _Size)
+    {
+        return false;
+    }
+
+    m_pCursor  += _NewSize - _Size;
+    m_UsedSize += _NewSize - _Size;
+
+    return true;
+}
+
+inline CArena::SMark
+CArena::GetMark() const
+{
+    SMark Mark;
+    Mark.m_pChunk  = m_pChunk;
+    Mark.m_pCursor = m_pCursor;
+    return Mark;
+}
+
+inline void
+CArena::Rewind(const SMark& _rMark)
+{
+    // a mark taken on an empty arena rewinds to the bottom chunk, which is kept
+    while (m_pChunk != _rMark.m_pChunk && !(_rMark.m_pChunk == 0 && m_pChunk->m_pPrev == 0))
+    {
+        assert(m_pChunk != 0 && "mark does not belong to this arena");
+        PopChunk();
+    }
+
+    if (m_pChunk != 0)
+    {
+        char* pCursor = (_rMark.m_pChunk != 0) ? _rMark.m_pCursor : GetPayload(m_pChunk);
+        m_UsedSize -= m_pCursor - pCursor;
+        m_pCursor = pCursor;
+    }
+}
+
+inline void
+CArena::Reset()
+{
+    if (m_pChunk == 0)
+    {
+        return;
+    }
+
+    // the newest chunk is the biggest one and worth keeping
+    SChunk* pChunk = m_pChunk->m_pPrev;
+    while (pChunk != 0)
+    {
+        SChunk* pTemp = pChunk;
+        pChunk = pChunk->m_pPrev;
+        m_ReservedSize -= pTemp->m_Size;
+        ::operator delete(pTemp);
+    }
+
+    m_pChunk->m_pPrev = 0;
+    m_pCursor = GetPayload(m_pChunk);
+    m_UsedSize = 0;
+}
+
+inline size_t
+CArena::GetUsedSize() const
+{
+    return m_UsedSize;
+}
+
+inline size_t
+CArena::GetReservedSize() const
+{
+    return m_ReservedSize;
+}
+
+inline CArena*
+CArena::GetCurrent()
+{
+    return GetCurrentSlot();
+}
+
+inline void
+CArena::SetCurrent(CArena* _pArena)
+{
+    GetCurrentSlot() = _pArena;
+}
+
+inline void
+CArena::PushChunk(size_t _MinPayload)
+{
+    size_t ChunkSize = m_NextChunkSize;
+    while (ChunkSize - s_ChunkHeaderSize < _MinPayload)
+    {
+        ChunkSize *= 2;
+    }
+
+    SChunk* pChunk = static_cast<SChunk*>(::operator new(ChunkSize));
+    pChunk->m_pPrev       = m_pChunk;
+    pChunk->m_Size        = ChunkSize;
+    pChunk->m_pLeftCursor = 0;
+
+    if (m_pChunk != 0)
+    {
+        m_pChunk->m_pLeftCursor = m_pCursor;
+    }
+
+    m_pChunk  = pChunk;
+    m_pCursor = GetPayload(pChunk);
+    m_pEnd    = reinterpret_cast<char*>(pChunk) + ChunkSize;
+
+    m_ReservedSize += ChunkSize;
+    if (m_NextChunkSize < s_MaxChunkSize)
+    {
+        m_NextChunkSize *= 2;
+    }
+}
+
+inline void
+CArena::PopChunk()
+{
+    SChunk* pChunk = m_pChunk;
+    m_UsedSize     -= m_pCursor - GetPayload(pChunk);
+    m_ReservedSize -= pChunk->m_Size;
+    m_pChunk = pChunk->m_pPrev;
+    ::operator delete(pChunk);
+
+    m_pCursor = (m_pChunk != 0) ? m_pChunk->m_pLeftCursor : 0;
+    m_pEnd    = (m_pChunk != 0) ? reinterpret_cast<char*>(m_pChunk) + m_pChunk->m_Size : 0;
+}
+
+inline char*
+CArena::GetPayload(SChunk* _pChunk) const
+{
+    return reinterpret_cast<char*>(_pChunk) + s_ChunkHeaderSize;
+}
+
+inline CArena*&
+CArena::GetCurrentSlot()
+{
+    static thread_local CArena* s_pCurrent = 0;
+    return s_pCurrent;
+}
+
+/*************************************************************************
+ * ARENA SCOPE SUBSECTION
+ *************************************************************************/
+
+inline
+CArenaScope::CArenaScope(CArena& _rArena)
+    : m_pArena(&_rArena)
+    , m_pPrevious(CArena::GetCurrent())
+    , m_Mark(_rArena.GetMark())
+{
+    CArena::SetCurrent(m_pArena);
+}
+
+inline
+CArenaScope::~CArenaScope()
+{
+    m_pArena->Rewind(m_Mark);
+    CArena::SetCurrent(m_pPrevious);
+}
+
+/*************************************************************************
+ * ARENA ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CArenaAllocator<T>::CArenaAllocator()
+    : m_pArena(CArena::GetCurrent())
+{
+}
+
+template <typename T>
+CArenaAllocator<T>::CArenaAllocator(CArena& _rArena)
+    : m_pArena(&_rArena)
+{
+}
+
+template <typename T>
+CArenaAllocator<T>::CArenaAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pArena(_rAllocator.GetArena())
+{
+}
+
+template <typename T>
+template <typename U>
+CArenaAllocator<T>::CArenaAllocator(const CArenaAllocator<U>& _rAllocator)
+    : m_pArena(_rAllocator.GetArena())
+{
+}
+
+template <typename T>
+typename CArenaAllocator<T>::self&
+CArenaAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_pArena = _rAllocator.GetArena();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CArenaAllocator<T>::self&
+CArenaAllocator<T>::operator=(const CArenaAllocator<U>& _rAllocator)
+{
+    m_pArena = _rAllocator.GetArena();
+    return (*this);
+}
+
+template <typename T>
+typename CArenaAllocator<T>::pointer
+CArenaAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    if (m_pArena == 0)
+    {
+        return base_type::Allocate(_Count);
+    }
+
+    return static_cast<T*>(m_pArena->Allocate(_Count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void
+CArenaAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (m_pArena == 0)
+    {
+        base_type::Deallocate(_pMem, _Count);
+    }
+
+    // arena memory is released as a whole
+}
+
+template <typename T>
+bool
+CArenaAllocator<T>::TryExpand(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (m_pArena == 0 || _NewCount > this->GetMaxSize())
+    {
+        return false;
+    }
+
+    return m_pArena->TryExpand(_pMem, _Count * sizeof(T), _NewCount * sizeof(T));
+}
+
+template <typename T>
+CArena*
+CArenaAllocator<T>::GetArena() const
+{
+    return m_pArena;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CArenaAllocator<T1>& _rLhs, const CArenaAllocator<T2>& _rRhs)
+{
+    return _rLhs.GetArena() == _rRhs.GetArena();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CArenaAllocator<T1>& _rLhs, const CArenaAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_ARENA_ALLOCATOR_H_
@@ -0,0 +1,808 @@
+#ifndef __INCLUDE_CONCURRENT_POOL_ALLOCATOR_H_
+#define __INCLUDE_CONCURRENT_POOL_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include "allocator.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Lock-free pool of fixed size slots, shared by many threads.
+ * Every thread keeps a private free list per size class and exchanges
+ * whole batches with one lock-free stack per size class, so a block freed
+ * on a consumer thread returns to the producers without any lock. Stack
+ * entries are addressed by a 32 bit slot index, which is packed with a
+ * 32 bit version tag into one 64 bit word to rule out ABA. Slots live in
+ * chunks of geometrically growing size, which are kept until the pool is
+ * destroyed. Live pools are listed in a registry, so a thread that exits
+ * after a pool it used was destroyed drops its cache for that pool instead
+ * of flushing into freed memory; long lived threads (a CThreadPool worker)
+ * need not call Flush(). The registry lock is only taken when a pool is
+ * created or destroyed, when a thread exits and when a thread runs out of
+ * cache entries.
+ **/
+class CConcurrentNodePool
+{
+public: // static constants
+
+    static const size_t s_Granularity     = 16;                         // slot sizes are multiples of this
+    static const size_t s_MaxSlotSize     = 256;                        // bigger requests bypass the pool
+    static const size_t s_ClassCount      = s_MaxSlotSize / s_Granularity;
+    static const size_t s_BatchBytes      = 4 * 1024;                   // bytes moved between thread and stack at once
+    static const size_t s_FirstChunkBytes = 64 * 1024;                  // chunk k holds twice the slots of chunk k - 1
+    static const size_t s_MaxChunkCount   = 32;
+    static const size_t s_CachedPoolCount = 8;                          // pools a thread caches for at the same time
+
+public: // ctor, dtor
+
+    CConcurrentNodePool();
+    ~CConcurrentNodePool();
+
+public: // operations
+
+    void* Allocate(size_t _Size);                                       // returns slot of at least _Size bytes
+    void  Deallocate(void* _pMem, size_t _Size);                        // _Size has to match Allocate, any thread
+    void  Flush();                                                      // returns the cache of the calling thread
+
+    static bool                 IsPooled(size_t _Size, size_t _Alignment);
+    static CConcurrentNodePool& GetDefault();                           // process wide pool, never destroyed
+
+private: // non-copyable
+
+    CConcurrentNodePool(const CConcurrentNodePool&);
+    CConcurrentNodePool& operator=(const CConcurrentNodePool&);
+
+private: // block and cache declaration
+
+    struct SBlock                                                       // overlays a free slot
+    {
+        SBlock*  m_pNext;                                               // next block of the same batch
+        uint32_t m_NextBatch;                                           // index + 1 of the next batch on the stack
+        uint32_t m_Count;                                               // blocks in the batch, valid on the stack only
+    };
+
+    struct SSizeClass
+    {
+        std::atomic<uint64_t> m_Head;                                   // version << 32 | index + 1 of the top batch
+        std::atomic<uint32_t> m_Unused;                                 // first index never handed out
+        std::atomic<char*>    m_pChunks[s_MaxChunkCount];
+    };
+
+    struct SFreeList
+    {
+        SBlock* m_pFirst;
+        size_t  m_Count;
+    };
+
+    struct SRegistry                                                    // all live pools
+    {
+        std::mutex           m_Mutex;
+        CConcurrentNodePool* m_pFirst;
+    };
+
+    struct SThreadCache
+    {
+        struct SEntry
+        {
+            CConcurrentNodePool* m_pPool;
+            uint64_t             m_PoolId;
+            SFreeList            m_Lists[s_ClassCount];
+        };
+
+        SThreadCache();
+        ~SThreadCache();
+
+        SEntry m_Entries[s_CachedPoolCount];
+    };
+
+private: // internal methods
+
+    SFreeList* GetCachedLists();                                        // 0 if the thread caches too many pools already
+    void       FlushLists(SFreeList* _pLists);
+
+    SBlock* Fetch(size_t _Class, size_t& _rCount);
+    void    Release(size_t _Class, SBlock* _pFirst, size_t _Count);    // splits the chain into batches
+    SBlock* PopBatch(size_t _Class, size_t& _rCount);
+    void    PushBatch(size_t _Class, SBlock* _pFirst, size_t _Count);
+    SBlock* Carve(size_t _Class, size_t _Count);
+
+    SBlock*  GetBlock(size_t _Class, uint32_t _Index);
+    uint32_t GetIndex(size_t _Class, SBlock* _pBlock);
+    char*    GetChunk(size_t _Class, size_t _Chunk);                    // allocates the chunk on first use
+
+    static size_t GetClass(size_t _Size);
+    static size_t GetClassSize(size_t _Class);
+    static size_t GetBatchCount(size_t _Class);
+    static size_t GetChunkSlotCount(size_t _Class, size_t _Chunk);
+    static size_t GetChunkOf(size_t _Class, uint32_t _Index);
+
+    static SThreadCache& GetThreadCache();
+    static SRegistry&    GetRegistry();
+    static bool          IsLive(CConcurrentNodePool* _pPool, uint64_t _PoolId);   // registry mutex has to be held
+
+private: // member
+
+    SSizeClass           m_Classes[s_ClassCount];
+    uint64_t             m_Id;                                          // unique, pools may reuse an address
+    CConcurrentNodePool* m_pPrevLive;                                   // registry links
+    CConcurrentNodePool* m_pNextLive;
+};
+
+/**
+ * Allocator handing out memory from a CConcurrentNodePool.
+ * Memory may be freed by any instance sharing the pool on any thread,
+ * so node based containers can be filled on one thread and torn down on
+ * another. Requests bigger than CConcurrentNodePool::s_MaxSlotSize go to
+ * the global heap. The containers themselves are not made thread-safe.
+ **/
+template <typename T>
+class CConcurrentPoolAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CConcurrentPoolAllocator<T> self;
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CConcurrentPoolAllocator<U> other;
+    };
+
+public:
+
+    CConcurrentPoolAllocator();
+    explicit CConcurrentPoolAllocator(CConcurrentNodePool& _rPool);
+    CConcurrentPoolAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CConcurrentPoolAllocator(const CConcurrentPoolAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CConcurrentPoolAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+
+    CConcurrentNodePool& GetPool() const;
+
+private:
+
+    CConcurrentNodePool* m_pPool;
+};
+
+/*************************************************************************
+ * CONCURRENT NODE POOL SUBSECTION
+ *************************************************************************/
+
+inline
+CConcurrentNodePool::CConcurrentNodePool()
+{
+    static std::atomic<uint64_t> s_NextId(1);
+    m_Id = s_NextId.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t Class = 0; Class < s_ClassCount; ++Class)
+    {
+        m_Classes[Class].m_Head.store(0, std::memory_order_relaxed);
+        m_Classes[Class].m_Unused.store(0, std::memory_order_relaxed);
+
+        for (size_t Chunk = 0; Chunk < s_MaxChunkCount; ++Chunk)
+        {
+            m_Classes[Class].m_pChunks[Chunk].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    SRegistry& rRegistry = GetRegistry();
+    std::lock_guard<std::mutex> Lock(rRegistry.m_Mutex);
+
+    m_pPrevLive = 0;
+    m_pNextLive = rRegistry.m_pFirst;
+    if (rRegistry.m_pFirst != 0)
+    {
+        rRegistry.m_pFirst->m_pPrevLive = this;
+    }
+    rRegistry.m_pFirst = this;
+}
+
+inline
+CConcurrentNodePool::~CConcurrentNodePool()
+{
+    Flush();
+
+    {
+        // from here on no exiting thread flushes into this pool
+        SRegistry& rRegistry = GetRegistry();
+        std::lock_guard<std::mutex> Lock(rRegistry.m_Mutex);
+
+        if (m_pPrevLive != 0)
+        {
+            m_pPrevLive->m_pNextLive = m_pNextLive;
+        }
+        else
+        {
+            rRegistry.m_pFirst = m_pNextLive;
+        }
+        if (m_pNextLive != 0)
+        {
+            m_pNextLive->m_pPrevLive = m_pPrevLive;
+        }
+    }
+
+    for (size_t Class = 0; Class < s_ClassCount; ++Class)
+    {
+        for (size_t Chunk = 0; Chunk < s_MaxChunkCount; ++Chunk)
+        {
+            ::operator delete(m_Classes[Class].m_pChunks[Chunk].load(std::memory_order_relaxed));
+        }
+    }
+}
+
+inline void*
+CConcurrentNodePool::Allocate(size_t _Size)
+{
+    size_t     Class  = GetClass(_Size);
+    SFreeList* pLists = GetCachedLists();
+
+    if (pLists == 0)
+    { // no cache for this pool, take one block and give the rest back
+        size_t  Count  = 0;
+        SBlock* pBlock = PopBatch(Class, Count);
+
+        if (pBlock == 0)
+        {
+            return Carve(Class, 1);
+        }
+        if (Count > 1)
+        {
+            PushBatch(Class, pBlock->m_pNext, Count - 1);
+        }
+        return pBlock;
+    }
+
+    SFreeList& rList = pLists[Class];
+
+    if (rList.m_pFirst == 0)
+    {
+        rList.m_pFirst = Fetch(Class, rList.m_Count);
+    }
+
+    SBlock* pBlock = rList.m_pFirst;
+    rList.m_pFirst = pBlock->m_pNext;
+    --rList.m_Count;
+
+    return pBlock;
+}
+
+inline void
+CConcurrentNodePool::Deallocate(void* _pMem, size_t _Size)
+{
+    size_t     Class  = GetClass(_Size);
+    SFreeList* pLists = GetCachedLists();
+    SBlock*    pBlock = static_cast<SBlock*>(_pMem);
+
+    if (pLists == 0)
+    {
+        pBlock->m_pNext = 0;
+        PushBatch(Class, pBlock, 1);
+        return;
+    }
+
+    SFreeList& rList      = pLists[Class];
+    size_t     BatchCount = GetBatchCount(Class);
+
+    pBlock->m_pNext = rList.m_pFirst;
+    rList.m_pFirst = pBlock;
+    ++rList.m_Count;
+
+    if (rList.m_Count >= 2 * BatchCount)
+    { // keep one batch for upcoming allocations, hand the other one back
+        SBlock* pFirst = rList.m_pFirst;
+        SBlock* pLast  = pFirst;
+        for (size_t Block = 1; Block < BatchCount; ++Block)
+        {
+            pLast = pLast->m_pNext;
+        }
+
+        rList.m_pFirst = pLast->m_pNext;
+        rList.m_Count -= BatchCount;
+        pLast->m_pNext = 0;
+
+        PushBatch(Class, pFirst, BatchCount);
+    }
+}
+
+inline void
+CConcurrentNodePool::Flush()
+{
+    SThreadCache& rCache = GetThreadCache();
+
+    for (size_t Entry = 0; Entry < s_CachedPoolCount; ++Entry)
+    {
+        if (rCache.m_Entries[Entry].m_pPool == this && rCache.m_Entries[Entry].m_PoolId == m_Id)
+        {
+            FlushLists(rCache.m_Entries[Entry].m_Lists);
+            rCache.m_Entries[Entry].m_pPool = 0;
+        }
+    }
+}
+
+inline bool
+CConcurrentNodePool::IsPooled(size_t _Size, size_t _Alignment)
+{
+    return _Size > 0 && _Size <= s_MaxSlotSize && _Alignment <= s_Granularity;
+}
+
+inline CConcurrentNodePool&
+CConcurrentNodePool::GetDefault()
+{
+    // intentionally leaked, thread caches flush into it during termination
+    static CConcurrentNodePool* s_pPool = new CConcurrentNodePool();
+    return *s_pPool;
+}
+
+inline CConcurrentNodePool::SFreeList*
+CConcurrentNodePool::GetCachedLists()
+{
+    SThreadCache& rCache = GetThreadCache();
+    SThreadCache::SEntry* pFree = 0;
+
+    for (size_t Entry = 0; Entry < s_CachedPoolCount; ++Entry)
+    {
+        SThreadCache::SEntry& rEntry = rCache.m_Entries[Entry];
+
+        if (rEntry.m_pPool == this)
+        {
+            if (rEntry.m_PoolId == m_Id)
+            {
+                return rEntry.m_Lists;
+            }
+
+            // a destroyed pool lived at the same address, its blocks are gone
+            rEntry.m_pPool = 0;
+        }
+
+        if (rEntry.m_pPool == 0 && pFree == 0)
+        {
+            pFree = &rEntry;
+        }
+    }
+
+    if (pFree == 0)
+    { // entries of pools destroyed in the meantime can be taken over
+        SRegistry& rRegistry = GetRegistry();
+        std::lock_guard<std::mutex> Lock(rRegistry.m_Mutex);
+
+        for (size_t Entry = 0; Entry < s_CachedPoolCount && pFree == 0; ++Entry)
+        {
+            if (!IsLive(rCache.m_Entries[Entry].m_pPool, rCache.m_Entries[Entry].m_PoolId))
+            {
+                pFree = &rCache.m_Entries[Entry];
+            }
+        }
+
+        if (pFree == 0)
+        {
+            return 0;
+        }
+    }
+
+    pFree->m_pPool  = this;
+    pFree->m_PoolId = m_Id;
+
+    for (size_t Class = 0; Class < s_ClassCount; ++Class)
+    {
+        pFree->m_Lists[Class].m_pFirst = 0;
+        pFree->m_Lists[Class].m_Count  = 0;
+    }
+
+    return pFree->m_Lists;
+}
+
+inline void
+CConcurrentNodePool::FlushLists(SFreeList* _pLists)
+{
+    for (size_t Class = 0; Class < s_ClassCount; ++Class)
+    {
+        if (_pLists[Class].m_pFirst != 0)
+        {
+            Release(Class, _pLists[Class].m_pFirst, _pLists[Class].m_Count);
+        }
+
+        _pLists[Class].m_pFirst = 0;
+        _pLists[Class].m_Count  = 0;
+    }
+}
+
+inline CConcurrentNodePool::SBlock*
+CConcurrentNodePool::Fetch(size_t _Class, size_t& _rCount)
+{
+    SBlock* pFirst = PopBatch(_Class, _rCount);
+
+    if (pFirst == 0)
+    {
+        _rCount = GetBatchCount(_Class);
+        pFirst  = Carve(_Class, _rCount);
+    }
+
+    return pFirst;
+}
+
+inline void
+CConcurrentNodePool::Release(size_t _Class, SBlock* _pFirst, size_t _Count)
+{
+    size_t BatchCount = GetBatchCount(_Class);
+
+    while (_Count > 0)
+    {
+        size_t  Count = _Count < BatchCount ? _Count : BatchCount;
+        SBlock* pLast = _pFirst;
+        for (size_t Block = 1; Block < Count; ++Block)
+        {
+            pLast = pLast->m_pNext;
+        }
+
+        SBlock* pRest = pLast->m_pNext;
+        pLast->m_pNext = 0;
+        PushBatch(_Class, _pFirst, Count);
+
+        _pFirst = pRest;
+        _Count -= Count;
+    }
+}
+
+inline CConcurrentNodePool::SBlock*
+CConcurrentNodePool::PopBatch(size_t _Class, size_t& _rCount)
+{
+    std::atomic<uint64_t>& rHead = m_Classes[_Class].m_Head;
+    uint64_t Head = rHead.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        uint32_t Top = static_cast<uint32_t>(Head);
+        if (Top == 0)
+        {
+            return 0;
+        }
+
+        // the batch may be popped and reused by another thread meanwhile,
+        // then the link read here is garbage, but the version check fails
+        SBlock*  pBatch  = GetBlock(_Class, Top - 1);
+        uint64_t NewHead = ((Head >> 32) + 1) << 32 | pBatch->m_NextBatch;
+
+        if (rHead.compare_exchange_weak(Head, NewHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            _rCount = pBatch->m_Count;
+            return pBatch;
+        }
+    }
+}
+
+inline void
+CConcurrentNodePool::PushBatch(size_t _Class, SBlock* _pFirst, size_t _Count)
+{
+    std::atomic<uint64_t>& rHead = m_Classes[_Class].m_Head;
+    uint64_t Top  = GetIndex(_Class, _pFirst) + 1;
+    uint64_t Head = rHead.load(std::memory_order_relaxed);
+
+    _pFirst->m_Count = static_cast<uint32_t>(_Count);
+
+    do
+    {
+        _pFirst->m_NextBatch = static_cast<uint32_t>(Head);
+    }
+    while (!rHead.compare_exchange_weak(Head, ((Head >> 32) + 1) << 32 | Top, std::memory_order_release, std::memory_order_relaxed));
+}
+
+inline CConcurrentNodePool::SBlock*
+CConcurrentNodePool::Carve(size_t _Class, size_t _Count)
+{
+    uint32_t First = m_Classes[_Class].m_Unused.fetch_add(static_cast<uint32_t>(_Count), std::memory_order_relaxed);
+
+    if (First > UINT32_MAX - 1 - _Count || GetChunkOf(_Class, First + static_cast<uint32_t>(_Count) - 1) >= s_MaxChunkCount)
+    {
+        throw std::bad_alloc();
+    }
+
+    SBlock* pFirst = GetBlock(_Class, First);
+    SBlock* pLast  = pFirst;
+
+    for (uint32_t Index = First + 1; Index < First + _Count; ++Index)
+    {
+        pLast->m_pNext = GetBlock(_Class, Index);
+        pLast = pLast->m_pNext;
+    }
+    pLast->m_pNext = 0;
+
+    return pFirst;
+}
+
+inline CConcurrentNodePool::SBlock*
+CConcurrentNodePool::GetBlock(size_t _Class, uint32_t _Index)
+{
+    size_t Chunk  = GetChunkOf(_Class, _Index);
+    size_t Offset = _Index - GetChunkSlotCount(_Class, 0) * ((static_cast<size_t>(1) << Chunk) - 1);
+
+    return reinterpret_cast<SBlock*>(GetChunk(_Class, Chunk) + Offset * GetClassSize(_Class));
+}
+
+inline uint32_t
+CConcurrentNodePool::GetIndex(size_t _Class, SBlock* _pBlock)
+{
+    char* pBlock = reinterpret_cast<char*>(_pBlock);
+
+    for (size_t Chunk = 0; Chunk < s_MaxChunkCount; ++Chunk)
+    {
+        char*  pChunk = m_Classes[_Class].m_pChunks[Chunk].load(std::memory_order_acquire);
+        size_t Bytes  = GetChunkSlotCount(_Class, Chunk) * GetClassSize(_Class);
+
+        if (pChunk != 0 && pBlock >= pChunk && pBlock < pChunk + Bytes)
+        {
+            size_t First = GetChunkSlotCount(_Class, 0) * ((static_cast<size_t>(1) << Chunk) - 1);
+            return static_cast<uint32_t>(First + (pBlock - pChunk) / GetClassSize(_Class));
+        }
+    }
+
+    assert(false && "block does not belong to this pool");
+    return 0;
+}
+
+inline char*
+CConcurrentNodePool::GetChunk(size_t _Class, size_t _Chunk)
+{
+    std::atomic<char*>& rChunk = m_Classes[_Class].m_pChunks[_Chunk];
+    char* pChunk = rChunk.load(std::memory_order_acquire);
+
+    if (pChunk == 0)
+    { // several threads may race for the first use, one of them wins
+        char* pNewChunk = static_cast<char*>(::operator new(GetChunkSlotCount(_Class, _Chunk) * GetClassSize(_Class)));
+
+        if (rChunk.compare_exchange_strong(pChunk, pNewChunk, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            pChunk = pNewChunk;
+        }
+        else
+        {
+            ::operator delete(pNewChunk);
+        }
+    }
+
+    return pChunk;
+}
+
+inline size_t
+CConcurrentNodePool::GetClass(size_t _Size)
+{
+    assert(_Size > 0 && _Size <= s_MaxSlotSize && "size not served by concurrent node pool");
+    return (_Size - 1) / s_Granularity;
+}
+
+inline size_t
+CConcurrentNodePool::GetClassSize(size_t _Class)
+{
+    return (_Class + 1) * s_Granularity;
+}
+
+inline size_t
+CConcurrentNodePool::GetBatchCount(size_t _Class)
+{
+    size_t Count = s_BatchBytes / GetClassSize(_Class);
+    return Count < 16 ? 16 : Count;
+}
+
+inline size_t
+CConcurrentNodePool::GetChunkSlotCount(size_t _Class, size_t _Chunk)
+{
+    return (s_FirstChunkBytes / GetClassSize(_Class)) << _Chunk;
+}
+
+inline size_t
+CConcurrentNodePool::GetChunkOf(size_t _Class, uint32_t _Index)
+{
+    // chunk k starts at index FirstCount * (2^k - 1)
+    size_t Scaled = _Index / GetChunkSlotCount(_Class, 0) + 1;
+    size_t Chunk  = 0;
+
+    while (Scaled > 1)
+    {
+        Scaled >>= 1;
+        ++Chunk;
+    }
+
+    return Chunk;
+}
+
+inline CConcurrentNodePool::SThreadCache&
+CConcurrentNodePool::GetThreadCache()
+{
+    static thread_local SThreadCache s_Cache;
+    return s_Cache;
+}
+
+inline CConcurrentNodePool::SRegistry&
+CConcurrentNodePool::GetRegistry()
+{
+    // intentionally leaked, threads may exit after static destruction began
+    static SRegistry* s_pRegistry = new SRegistry();
+    return *s_pRegistry;
+}
+
+inline bool
+CConcurrentNodePool::IsLive(CConcurrentNodePool* _pPool, uint64_t _PoolId)
+{
+    for (CConcurrentNodePool* pPool = GetRegistry().m_pFirst; pPool != 0; pPool = pPool->m_pNextLive)
+    {
+        if (pPool == _pPool && pPool->m_Id == _PoolId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline
+CConcurrentNodePool::SThreadCache::SThreadCache()
+{
+    for (size_t Entry = 0; Entry < s_CachedPoolCount; ++Entry)
+    {
+        m_Entries[Entry].m_pPool  = 0;
+        m_Entries[Entry].m_PoolId = 0;
+    }
+}
+
+inline
+CConcurrentNodePool::SThreadCache::~SThreadCache()
+{
+    // the lock keeps the pools found alive until their lists are flushed
+    SRegistry& rRegistry = GetRegistry();
+    std::lock_guard<std::mutex> Lock(rRegistry.m_Mutex);
+
+    for (size_t Entry = 0; Entry < s_CachedPoolCount; ++Entry)
+    {
+        if (m_Entries[Entry].m_pPool != 0 && IsLive(m_Entries[Entry].m_pPool, m_Entries[Entry].m_PoolId))
+        {
+            m_Entries[Entry].m_pPool->FlushLists(m_Entries[Entry].m_Lists);
+        }
+        m_Entries[Entry].m_pPool = 0;
+    }
+}
+
+/*************************************************************************
+ * CONCURRENT POOL ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CConcurrentPoolAllocator<T>::CConcurrentPoolAllocator()
+    : m_pPool(&CConcurrentNodePool::GetDefault())
+{
+}
+
+template <typename T>
+CConcurrentPoolAllocator<T>::CConcurrentPoolAllocator(CConcurrentNodePool& _rPool)
+    : m_pPool(&_rPool)
+{
+}
+
+template <typename T>
+CConcurrentPoolAllocator<T>::CConcurrentPoolAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pPool(&_rAllocator.GetPool())
+{
+}
+
+template <typename T>
+template <typename U>
+CConcurrentPoolAllocator<T>::CConcurrentPoolAllocator(const CConcurrentPoolAllocator<U>& _rAllocator)
+    : m_pPool(&_rAllocator.GetPool())
+{
+}
+
+template <typename T>
+typename CConcurrentPoolAllocator<T>::self&
+CConcurrentPoolAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_pPool = &_rAllocator.GetPool();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CConcurrentPoolAllocator<T>::self&
+CConcurrentPoolAllocator<T>::operator=(const CConcurrentPoolAllocator<U>& _rAllocator)
+{
+    m_pPool = &_rAllocator.GetPool();
+    return (*this);
+}
+
+template <typename T>
+typename CConcurrentPoolAllocator<T>::pointer
+CConcurrentPoolAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    size_t Size = _Count * sizeof(T);
+    void*  pMem = CConcurrentNodePool::IsPooled(Size, alignof(T)) ? m_pPool->Allocate(Size) : ::operator new(Size);
+
+    return static_cast<T*>(pMem);
+}
+
+template <typename T>
+void
+CConcurrentPoolAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem == 0)
+    {
+        return;
+    }
+
+    size_t Size = _Count * sizeof(T);
+
+    if (CConcurrentNodePool::IsPooled(Size, alignof(T)))
+    {
+        m_pPool->Deallocate(_pMem, Size);
+    }
+    else
+    {
+        ::operator delete(_pMem);
+    }
+}
+
+template <typename T>
+CConcurrentNodePool&
+CConcurrentPoolAllocator<T>::GetPool() const
+{
+    return *m_pPool;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CConcurrentPoolAllocator<T1>& _rLhs, const CConcurrentPoolAllocator<T2>& _rRhs)
+{
+    return &_rLhs.GetPool() == &_rRhs.GetPool();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CConcurrentPoolAllocator<T1>& _rLhs, const CConcurrentPoolAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_CONCURRENT_POOL_ALLOCATOR_H_
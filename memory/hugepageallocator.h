@@ -0,0 +1,299 @@
+#ifndef __INCLUDE_HUGE_PAGE_ALLOCATOR_H_
+#define __INCLUDE_HUGE_PAGE_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <string.h>
+#include <new>
+#include "allocator.h"
+#include "pagememory.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Allocator for very large buffers.
+ * Requests of at least s_MinMappedSize bytes get an anonymous mapping of
+ * their own, backed by huge pages according to the mode (transparent by
+ * default), which cuts TLB misses when scanning them. Smaller requests go
+ * to the global heap. Discard() hands the physical pages of a range back
+ * to the system while keeping it mapped. Where mremap is available mapped
+ * blocks grow without copying by TryExpand and Reallocate.
+ **/
+template <typename T>
+class CHugePageAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CHugePageAllocator<T> self;
+
+    static const size_type s_MinMappedSize = s_HugePageSize;
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CHugePageAllocator<U> other;
+    };
+
+public:
+
+    CHugePageAllocator();
+    explicit CHugePageAllocator(EHugePageMode _Mode);
+    CHugePageAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CHugePageAllocator(const CHugePageAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CHugePageAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+    bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+    pointer Reallocate(pointer _pMem, size_type _Count, size_type _NewCount);
+
+    void Discard(pointer _pMem, size_type _Count);                      // drops whole pages inside the range, content is lost
+
+    EHugePageMode GetMode() const;
+
+private:
+
+    size_t GetMappedSize(size_type _Count) const;                       // 0 if served from the heap
+
+private:
+
+    EHugePageMode m_Mode;
+};
+
+template <typename T>
+CHugePageAllocator<T>::CHugePageAllocator()
+    : m_Mode(HugePagesTransparent)
+{
+}
+
+template <typename T>
+CHugePageAllocator<T>::CHugePageAllocator(EHugePageMode _Mode)
+    : m_Mode(_Mode)
+{
+}
+
+template <typename T>
+CHugePageAllocator<T>::CHugePageAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_Mode(_rAllocator.GetMode())
+{
+}
+
+template <typename T>
+template <typename U>
+CHugePageAllocator<T>::CHugePageAllocator(const CHugePageAllocator<U>& _rAllocator)
+    : m_Mode(_rAllocator.GetMode())
+{
+}
+
+template <typename T>
+typename CHugePageAllocator<T>::self&
+CHugePageAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_Mode = _rAllocator.GetMode();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CHugePageAllocator<T>::self&
+CHugePageAllocator<T>::operator=(const CHugePageAllocator<U>& _rAllocator)
+{
+    m_Mode = _rAllocator.GetMode();
+    return (*this);
+}
+
+template <typename T>
+typename CHugePageAllocator<T>::pointer
+CHugePageAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0)
+    {
+        return 0;
+    }
+    if (_Count > this->GetMaxSize())
+    {
+        throw std::bad_alloc();
+    }
+
+    size_t MappedSize = GetMappedSize(_Count);
+    if (MappedSize == 0)
+    {
+        return base_type::Allocate(_Count);
+    }
+
+    return static_cast<T*>(AllocateHugePages(MappedSize, m_Mode));
+}
+
+template <typename T>
+void
+CHugePageAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem == 0)
+    {
+        return;
+    }
+
+    size_t MappedSize = GetMappedSize(_Count);
+    if (MappedSize == 0)
+    {
+        base_type::Deallocate(_pMem, _Count);
+    }
+    else
+    {
+        FreePages(_pMem, MappedSize);
+    }
+}
+
+template <typename T>
+bool
+CHugePageAllocator<T>::TryExpand(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_NewCount > this->GetMaxSize())
+    {
+        return false;
+    }
+
+    size_t MappedSize    = GetMappedSize(_Count);
+    size_t NewMappedSize = GetMappedSize(_NewCount);
+
+    if (MappedSize == 0 || NewMappedSize == 0)
+    {
+        return false;
+    }
+    if (MappedSize >= NewMappedSize)
+    {
+        return true;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    return mremap(_pMem, MappedSize, NewMappedSize, 0) != MAP_FAILED;
+#else
+    return false;
+#endif
+}
+
+template <typename T>
+typename CHugePageAllocator<T>::pointer
+CHugePageAllocator<T>::Reallocate(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_NewCount > this->GetMaxSize())
+    {
+        throw std::bad_alloc();                                         // before anything is given back
+    }
+
+    size_t MappedSize    = GetMappedSize(_Count);
+    size_t NewMappedSize = GetMappedSize(_NewCount);
+
+    if (MappedSize == 0 && NewMappedSize == 0)
+    {
+        return base_type::Reallocate(_pMem, _Count, _NewCount);
+    }
+
+#ifdef MREMAP_MAYMOVE
+    if (MappedSize != 0 && NewMappedSize != 0)
+    { // the kernel moves the page table entries, no byte is copied
+        void* pMap = mremap(_pMem, MappedSize, NewMappedSize, MREMAP_MAYMOVE);
+        if (pMap != MAP_FAILED)
+        {
+            return static_cast<T*>(pMap);
+        }
+    }
+#endif
+
+    pointer pNewMem = Allocate(_NewCount);
+    if (pNewMem != 0)
+    {
+        memcpy(static_cast<void*>(pNewMem), _pMem, (_Count < _NewCount ? _Count : _NewCount) * sizeof(T));
+    }
+    Deallocate(_pMem, _Count);
+
+    return pNewMem;
+}
+
+template <typename T>
+void
+CHugePageAllocator<T>::Discard(pointer _pMem, size_type _Count)
+{
+    size_t PageSize = (m_Mode == HugePagesExplicit) ? s_HugePageSize : GetPageSize();
+    size_t Begin    = reinterpret_cast<size_t>(_pMem);
+    size_t End      = Begin + _Count * sizeof(T);
+
+    Begin = (Begin + PageSize - 1) / PageSize * PageSize;
+    End   = End / PageSize * PageSize;
+
+    if (GetMappedSize(_Count) != 0 && Begin < End)
+    {
+        DiscardPages(reinterpret_cast<void*>(Begin), End - Begin);
+    }
+}
+
+template <typename T>
+EHugePageMode
+CHugePageAllocator<T>::GetMode() const
+{
+    return m_Mode;
+}
+
+template <typename T>
+size_t
+CHugePageAllocator<T>::GetMappedSize(size_type _Count) const
+{
+    size_t Size = _Count * sizeof(T);
+
+    if (Size < s_MinMappedSize)
+    {
+        return 0;
+    }
+
+    return (m_Mode == HugePagesExplicit) ? RoundToHugePageSize(Size) : RoundToPageSize(Size);
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CHugePageAllocator<T1>& _rLhs, const CHugePageAllocator<T2>& _rRhs)
+{
+    return _rLhs.GetMode() == _rRhs.GetMode();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CHugePageAllocator<T1>& _rLhs, const CHugePageAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_HUGE_PAGE_ALLOCATOR_H_
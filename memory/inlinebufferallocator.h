@@ -0,0 +1,331 @@
+#ifndef __INCLUDE_INLINE_BUFFER_ALLOCATOR_H_
+#define __INCLUDE_INLINE_BUFFER_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include "allocator.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Fixed buffer handing out memory by bumping a cursor.
+ * Works on caller provided memory, CInlineBuffer below embeds the memory
+ * instead. Freeing the newest block moves the cursor back, so stack like
+ * usage (a vector growing, a list pushing and popping at the back) keeps
+ * reusing the buffer. Allocate returns 0 when the buffer is exhausted.
+ * Not thread-safe, the buffer has to outlive every container using it.
+ **/
+class CInlineBufferBase
+{
+public: // ctor
+
+    CInlineBufferBase(void* _pMem, size_t _Size);
+
+public: // operations
+
+    void* Allocate(size_t _Size, size_t _Alignment);                    // 0 if the rest of the buffer is too small
+    void  Deallocate(void* _pMem, size_t _Size);                        // only the newest block is reclaimed
+    bool  TryExpand(void* _pMem, size_t _Size, size_t _NewSize);        // grows the newest block in place
+    void  Reset();                                                      // forgets all blocks
+
+    bool Owns(const void* _pMem) const;
+
+public: // properties
+
+    size_t GetUsedSize() const;
+    size_t GetCapacity() const;
+
+private: // non-copyable
+
+    CInlineBufferBase(const CInlineBufferBase&);
+    CInlineBufferBase& operator=(const CInlineBufferBase&);
+
+private: // member
+
+    char* m_pBegin;
+    char* m_pCursor;
+    char* m_pEnd;
+};
+
+/**
+ * CInlineBufferBase with Bytes of embedded storage, meant for the stack:
+ *     CInlineBuffer<1024> Buffer;
+ *     CVector<int, CInlineBufferAllocator> Vector((CInlineBufferAllocator<int>(Buffer)));
+ **/
+template <size_t Bytes>
+class CInlineBuffer : public CInlineBufferBase
+{
+public: // ctor
+
+    CInlineBuffer();
+
+private: // member
+
+    alignas(std::max_align_t) char m_Storage[Bytes];
+};
+
+/**
+ * Allocator serving from a CInlineBufferBase and falling back to the heap.
+ * Rebinding keeps the buffer, so a list and its nodes share it. Blocks are
+ * told apart by their address, which lets a container grow from the buffer
+ * onto the heap. A default constructed instance only uses the heap.
+ **/
+template <typename T>
+class CInlineBufferAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CInlineBufferAllocator<T> self;
+
+    static const size_type s_Alignment = alignof(T);
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CInlineBufferAllocator<U> other;
+    };
+
+public:
+
+    CInlineBufferAllocator();
+    explicit CInlineBufferAllocator(CInlineBufferBase& _rBuffer);
+    CInlineBufferAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CInlineBufferAllocator(const CInlineBufferAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CInlineBufferAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+    bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+
+    CInlineBufferBase* GetBuffer() const;                               // 0 if serving from the global heap
+
+private:
+
+    CInlineBufferBase* m_pBuffer;
+};
+
+/*************************************************************************
+ * INLINE BUFFER SUBSECTION
+ *************************************************************************/
+
+inline
+CInlineBufferBase::CInlineBufferBase(void* _pMem, size_t _Size)
+    : m_pBegin(static_cast<char*>(_pMem))
+    , m_pCursor(static_cast<char*>(_pMem))
+    , m_pEnd(static_cast<char*>(_pMem) + _Size)
+{
+}
+
+inline void*
+CInlineBufferBase::Allocate(size_t _Size, size_t _Alignment)
+{
+    assert((_Alignment & (_Alignment - 1)) == 0 && "alignment has to be a power of two");
+
+    size_t Padding = (_Alignment - reinterpret_cast<size_t>(m_pCursor) % _Alignment) % _Alignment;
+
+    if (static_cast<size_t>(m_pEnd - m_pCursor) < Padding || static_cast<size_t>(m_pEnd - m_pCursor) - Padding < _Size)
+    {
+        return 0;
+    }
+
+    void* pMem = m_pCursor + Padding;
+    m_pCursor += Padding + _Size;
+
+    return pMem;
+}
+
+inline void
+CInlineBufferBase::Deallocate(void* _pMem, size_t _Size)
+{
+    if (static_cast<char*>(_pMem) + _Size == m_pCursor)
+    { // padding in front of the block is lost until Reset
+        m_pCursor = static_cast<char*>(_pMem);
+    }
+}
+
+inline bool
+CInlineBufferBase::TryExpand(void* _pMem, size_t _Size, size_t _NewSize)
+{
+    if (static_cast<char*>(_pMem) + _Size != m_pCursor || static_cast<size_t>(m_pEnd - m_pCursor) < _NewSize - _Size)
+    {
+        return false;
+    }
+
+    m_pCursor += _NewSize - _Size;
+    return true;
+}
+
+inline void
+CInlineBufferBase::Reset()
+{
+    m_pCursor = m_pBegin;
+}
+
+inline bool
+CInlineBufferBase::Owns(const void* _pMem) const
+{
+    return _pMem >= m_pBegin && _pMem < m_pEnd;
+}
+
+inline size_t
+CInlineBufferBase::GetUsedSize() const
+{
+    return m_pCursor - m_pBegin;
+}
+
+inline size_t
+CInlineBufferBase::GetCapacity() const
+{
+    return m_pEnd - m_pBegin;
+}
+
+template <size_t Bytes>
+CInlineBuffer<Bytes>::CInlineBuffer()
+    : CInlineBufferBase(m_Storage, Bytes)
+{
+}
+
+/*************************************************************************
+ * INLINE BUFFER ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CInlineBufferAllocator<T>::CInlineBufferAllocator()
+    : m_pBuffer(0)
+{
+}
+
+template <typename T>
+CInlineBufferAllocator<T>::CInlineBufferAllocator(CInlineBufferBase& _rBuffer)
+    : m_pBuffer(&_rBuffer)
+{
+}
+
+template <typename T>
+CInlineBufferAllocator<T>::CInlineBufferAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pBuffer(_rAllocator.GetBuffer())
+{
+}
+
+template <typename T>
+template <typename U>
+CInlineBufferAllocator<T>::CInlineBufferAllocator(const CInlineBufferAllocator<U>& _rAllocator)
+    : m_pBuffer(_rAllocator.GetBuffer())
+{
+}
+
+template <typename T>
+typename CInlineBufferAllocator<T>::self&
+CInlineBufferAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_pBuffer = _rAllocator.GetBuffer();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CInlineBufferAllocator<T>::self&
+CInlineBufferAllocator<T>::operator=(const CInlineBufferAllocator<U>& _rAllocator)
+{
+    m_pBuffer = _rAllocator.GetBuffer();
+    return (*this);
+}
+
+template <typename T>
+typename CInlineBufferAllocator<T>::pointer
+CInlineBufferAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    void* pMem = (m_pBuffer != 0) ? m_pBuffer->Allocate(_Count * sizeof(T), alignof(T)) : 0;
+
+    return (pMem != 0) ? static_cast<T*>(pMem) : base_type::Allocate(_Count);
+}
+
+template <typename T>
+void
+CInlineBufferAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (m_pBuffer != 0 && m_pBuffer->Owns(_pMem))
+    {
+        m_pBuffer->Deallocate(_pMem, _Count * sizeof(T));
+    }
+    else
+    {
+        base_type::Deallocate(_pMem, _Count);
+    }
+}
+
+template <typename T>
+bool
+CInlineBufferAllocator<T>::TryExpand(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (m_pBuffer == 0 || !m_pBuffer->Owns(_pMem) || _NewCount > this->GetMaxSize())
+    {
+        return false;
+    }
+
+    return m_pBuffer->TryExpand(_pMem, _Count * sizeof(T), _NewCount * sizeof(T));
+}
+
+template <typename T>
+CInlineBufferBase*
+CInlineBufferAllocator<T>::GetBuffer() const
+{
+    return m_pBuffer;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CInlineBufferAllocator<T1>& _rLhs, const CInlineBufferAllocator<T2>& _rRhs)
+{
+    return _rLhs.GetBuffer() == _rRhs.GetBuffer();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CInlineBufferAllocator<T1>& _rLhs, const CInlineBufferAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_INLINE_BUFFER_ALLOCATOR_H_
@@ -0,0 +1,203 @@
+#ifndef __INCLUDE_PAGE_MEMORY_H_
+#define __INCLUDE_PAGE_MEMORY_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <new>
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+namespace BASE {
+    namespace MEM {
+
+
+static const size_t s_HugePageSize = 2 * 1024 * 1024;                   // default huge page size on x86-64
+
+enum EHugePageMode
+{
+    HugePagesOff,                                                       // regular pages only
+    HugePagesTransparent,                                               // aligned mapping, advised for transparent huge pages
+    HugePagesExplicit                                                   // reserved huge pages (MAP_HUGETLB, MEM_LARGE_PAGES)
+};
+
+/**
+ * Thin layer over the virtual memory functions of the operating system.
+ * Sizes passed in have to be multiples of GetPageSize(), alignments have
+ * to be powers of two. Allocation failures throw std::bad_alloc.
+ **/
+
+inline size_t
+GetPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO Info;
+    GetSystemInfo(&Info);
+    return static_cast<size_t>(Info.dwPageSize);
+#else
+    static const size_t s_PageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return s_PageSize;
+#endif
+}
+
+inline size_t
+RoundToPageSize(size_t _Size)
+{
+    size_t PageSize = GetPageSize();
+    return (_Size + PageSize - 1) / PageSize * PageSize;
+}
+
+inline size_t
+RoundToHugePageSize(size_t _Size)
+{
+    return (_Size + s_HugePageSize - 1) / s_HugePageSize * s_HugePageSize;
+}
+
+inline void*
+AllocatePages(size_t _Size, size_t _Alignment = 0)
+{
+    assert(_Size % GetPageSize() == 0 && "size has to be a multiple of the page size");
+
+    size_t Alignment = _Alignment > GetPageSize() ? _Alignment : 0;
+
+#ifdef _WIN32
+    for (;;)
+    { // reserve more than needed to find an aligned address, then map exactly there
+        char* pProbe = static_cast<char*>(VirtualAlloc(0, _Size + Alignment, MEM_RESERVE, PAGE_NOACCESS));
+        if (pProbe == 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        size_t Offset = Alignment != 0 ? (Alignment - reinterpret_cast<size_t>(pProbe) % Alignment) % Alignment : 0;
+        VirtualFree(pProbe, 0, MEM_RELEASE);
+
+        void* pMem = VirtualAlloc(pProbe + Offset, _Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (pMem != 0)
+        {
+            return pMem;
+        }
+        // somebody else took the range in the meantime
+    }
+#else
+    void* pMap = mmap(0, _Size + Alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pMap == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+
+    if (Alignment == 0)
+    {
+        return pMap;
+    }
+
+    // give back the unaligned head and the unused tail
+    char*  pBegin = static_cast<char*>(pMap);
+    size_t Head   = (Alignment - reinterpret_cast<size_t>(pBegin) % Alignment) % Alignment;
+    size_t Tail   = Alignment - Head;
+
+    if (Head != 0)
+    {
+        munmap(pBegin, Head);
+    }
+    if (Tail != 0)
+    {
+        munmap(pBegin + Head + _Size, Tail);
+    }
+
+    return pBegin + Head;
+#endif
+}
+
+/**
+ * Maps _Size bytes backed by huge pages where the system allows it and
+ * silently falls back to the next weaker mode otherwise. For explicit huge
+ * pages _Size has to be a multiple of s_HugePageSize. Release by FreePages.
+ **/
+inline void*
+AllocateHugePages(size_t _Size, EHugePageMode _Mode)
+{
+#ifdef _WIN32
+    if (_Mode == HugePagesExplicit && GetLargePageMinimum() != 0 && _Size % GetLargePageMinimum() == 0)
+    { // needs SeLockMemoryPrivilege, fails without it
+        void* pMem = VirtualAlloc(0, _Size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (pMem != 0)
+        {
+            return pMem;
+        }
+    }
+
+    // there are no transparent huge pages on windows
+    return AllocatePages(_Size, _Mode != HugePagesOff && _Size >= s_HugePageSize ? s_HugePageSize : 0);
+#else
+#   ifdef MAP_HUGETLB
+    if (_Mode == HugePagesExplicit)
+    { // fails if no huge pages are reserved (vm.nr_hugepages)
+        void* pMap = mmap(0, _Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pMap != MAP_FAILED)
+        {
+            return pMap;
+        }
+    }
+#   endif
+
+    bool  IsHuge = _Mode != HugePagesOff && _Size >= s_HugePageSize;
+    void* pMem   = AllocatePages(_Size, IsHuge ? s_HugePageSize : 0);
+
+#   ifdef MADV_HUGEPAGE
+    if (IsHuge)
+    { // a hint only, fails if transparent huge pages are disabled
+        madvise(pMem, _Size, MADV_HUGEPAGE);
+    }
+#   endif
+
+    return pMem;
+#endif
+}
+
+inline void
+FreePages(void* _pMem, size_t _Size)
+{
+#ifdef _WIN32
+    (void)_Size;
+    VirtualFree(_pMem, 0, MEM_RELEASE);
+#else
+    munmap(_pMem, _Size);
+#endif
+}
+
+inline void
+DiscardPages(void* _pMem, size_t _Size)
+{
+    // the range stays mapped, but its physical pages may be reclaimed;
+    // content is undefined (zero on posix) after the next access
+#ifdef _WIN32
+    VirtualAlloc(_pMem, _Size, MEM_RESET, PAGE_READWRITE);
+#else
+    madvise(_pMem, _Size, MADV_DONTNEED);
+#endif
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_PAGE_MEMORY_H_
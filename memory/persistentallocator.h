@@ -0,0 +1,688 @@
+#ifndef __INCLUDE_PERSISTENT_ALLOCATOR_H_
+#define __INCLUDE_PERSISTENT_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <stdexcept>
+#include "allocator.h"
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Self relative pointer, stays valid wherever the memory holding it is mapped.
+ * Stores the distance between itself and the target, 1 encodes null (an
+ * object can't sensibly point one byte past its own start).
+ **/
+template <typename T>
+class COffsetPtr
+{
+public: // ctor
+
+    COffsetPtr(T* _pTarget = 0);
+    COffsetPtr(const COffsetPtr& _rPtr);
+
+    COffsetPtr& operator=(T* _pTarget);
+    COffsetPtr& operator=(const COffsetPtr& _rPtr);
+
+public: // access
+
+    T* Get() const;
+
+    T& operator*() const;
+    T* operator->() const;
+
+    operator bool() const;
+
+private: // member
+
+    ptrdiff_t m_Offset;
+};
+
+/**
+ * Bump heap living at the start of a CPersistentArena mapping.
+ * All of its state lies inside the mapped file, so allocators pointing to
+ * it remain valid after the file is reopened at the same address. Blocks
+ * are only reclaimed when freed in reverse order, otherwise they stay in
+ * the file. Roots are offsets of the entry objects, which have to be
+ * found again after reopening.
+ * Not thread-safe.
+ **/
+class CPersistentHeap
+{
+public: // static constants
+
+    static const uint64_t s_Magic     = 0x50455253484541ULL;            // "PERSHEA"
+    static const uint32_t s_Version   = 1;
+    static const size_t   s_RootCount = 16;
+
+public: // operations
+
+    void* Allocate(size_t _Size, size_t _Alignment);                    // throws std::bad_alloc when the file is full
+    void  Deallocate(void* _pMem, size_t _Size);                        // only the newest block is reclaimed
+    bool  TryExpand(void* _pMem, size_t _Size, size_t _NewSize);        // grows the newest block in place
+
+    void* GetRoot(size_t _Index) const;                                 // 0 if never set
+    void  SetRoot(size_t _Index, void* _pObject);
+
+public: // properties
+
+    size_t GetUsedSize() const;
+    size_t GetCapacity() const;
+
+private: // created by CPersistentArena only
+
+    friend class CPersistentArena;
+
+    CPersistentHeap();
+    CPersistentHeap(const CPersistentHeap&);
+    CPersistentHeap& operator=(const CPersistentHeap&);
+
+    void  Format(size_t _Capacity);
+    char* GetBase() const;
+
+private: // member, this is the file format
+
+    uint64_t m_Magic;
+    uint32_t m_Version;
+    uint32_t m_HeaderSize;
+    uint64_t m_Capacity;                                                // bytes of the file
+    uint64_t m_Top;                                                     // offset of the first free byte
+    uint64_t m_Base;                                                    // address the file has to be mapped at
+    uint64_t m_Roots[s_RootCount];                                      // offsets, 0 for unset
+};
+
+/**
+ * File mapping holding a CPersistentHeap.
+ * A new file is sized to _Capacity and mapped at _pPreferredBase if that
+ * range is free. An existing file is mapped at the address recorded in it,
+ * since the containers of this library keep raw pointers into their memory;
+ * std::runtime_error is thrown if that range is taken. Pages are loaded on
+ * first access, so reopening costs next to nothing.
+ **/
+class CPersistentArena
+{
+public: // ctor, dtor
+
+    CPersistentArena(const char* _pPath, size_t _Capacity, void* _pPreferredBase = GetDefaultBase());
+    ~CPersistentArena();
+
+public: // operations
+
+    void Sync();                                                        // writes dirty pages back to the file
+
+public: // properties
+
+    CPersistentHeap& GetHeap() const;
+    bool             IsCreated() const;                                 // whether the file was created by this instance
+
+    static void* GetDefaultBase();                                      // far away from heap and stacks on 64 bit
+
+private: // non-copyable
+
+    CPersistentArena(const CPersistentArena&);
+    CPersistentArena& operator=(const CPersistentArena&);
+
+private: // internal methods
+
+    void* Map(size_t _Size, void* _pBase, bool _IsFixed);
+    void  Close();
+
+private: // member
+
+    CPersistentHeap* m_pHeap;
+    size_t           m_Size;
+    bool             m_IsCreated;
+#ifdef _WIN32
+    HANDLE           m_File;
+    HANDLE           m_Mapping;
+#else
+    int              m_File;
+#endif
+};
+
+/**
+ * Allocator placing container memory in a CPersistentHeap.
+ * Holds a pointer into the mapping, so a container built in the heap can
+ * be used right away after the file is reopened.
+ **/
+template <typename T>
+class CPersistentAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CPersistentAllocator<T> self;
+
+    static const size_type s_Alignment = alignof(T);
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CPersistentAllocator<U> other;
+    };
+
+public:
+
+    explicit CPersistentAllocator(CPersistentHeap& _rHeap);
+    CPersistentAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CPersistentAllocator(const CPersistentAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CPersistentAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+    bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+
+    CPersistentHeap& GetHeap() const;
+
+private:
+
+    CPersistentHeap* m_pHeap;
+};
+
+/*************************************************************************
+ * OFFSET POINTER SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+COffsetPtr<T>::COffsetPtr(T* _pTarget)
+{
+    operator=(_pTarget);
+}
+
+template <typename T>
+COffsetPtr<T>::COffsetPtr(const COffsetPtr& _rPtr)
+{
+    operator=(_rPtr.Get());
+}
+
+template <typename T>
+COffsetPtr<T>&
+COffsetPtr<T>::operator=(T* _pTarget)
+{
+    m_Offset = (_pTarget != 0) ? reinterpret_cast<const char*>(_pTarget) - reinterpret_cast<const char*>(this) : 1;
+    return (*this);
+}
+
+template <typename T>
+COffsetPtr<T>&
+COffsetPtr<T>::operator=(const COffsetPtr& _rPtr)
+{
+    return operator=(_rPtr.Get());
+}
+
+template <typename T>
+T*
+COffsetPtr<T>::Get() const
+{
+    if (m_Offset == 1)
+    {
+        return 0;
+    }
+
+    return reinterpret_cast<T*>(const_cast<char*>(reinterpret_cast<const char*>(this)) + m_Offset);
+}
+
+template <typename T>
+T&
+COffsetPtr<T>::operator*() const
+{
+    return *Get();
+}
+
+template <typename T>
+T*
+COffsetPtr<T>::operator->() const
+{
+    return Get();
+}
+
+template <typename T>
+COffsetPtr<T>::operator bool() const
+{
+    return m_Offset != 1;
+}
+
+/*************************************************************************
+ * PERSISTENT HEAP SUBSECTION
+ *************************************************************************/
+
+inline void*
+CPersistentHeap::Allocate(size_t _Size, size_t _Alignment)
+{
+    assert((_Alignment & (_Alignment - 1)) == 0 && "alignment has to be a power of two");
+
+    uint64_t Begin = (m_Top + _Alignment - 1) / _Alignment * _Alignment;
+
+    if (Begin > m_Capacity || m_Capacity - Begin < _Size)
+    {
+        throw std::bad_alloc();
+    }
+
+    m_Top = Begin + _Size;
+    return GetBase() + Begin;
+}
+
+inline void
+CPersistentHeap::Deallocate(void* _pMem, size_t _Size)
+{
+    if (static_cast<char*>(_pMem) + _Size == GetBase() + m_Top)
+    {
+        m_Top = static_cast<char*>(_pMem) - GetBase();
+    }
+}
+
+inline bool
+CPersistentHeap::TryExpand(void* _pMem, size_t _Size, size_t _NewSize)
+{
+    if (static_cast<char*>(_pMem) + _Size != GetBase() + m_Top || m_Capacity - m_Top < _NewSize - _Size)
+    {
+        return false;
+    }
+
+    m_Top += _NewSize - _Size;
+    return true;
+}
+
+inline void*
+CPersistentHeap::GetRoot(size_t _Index) const
+{
+    assert(_Index < s_RootCount && "root index out of range");
+    return (m_Roots[_Index] != 0) ? GetBase() + m_Roots[_Index] : 0;
+}
+
+inline void
+CPersistentHeap::SetRoot(size_t _Index, void* _pObject)
+{
+    assert(_Index < s_RootCount && "root index out of range");
+    m_Roots[_Index] = (_pObject != 0) ? static_cast<char*>(_pObject) - GetBase() : 0;
+}
+
+inline size_t
+CPersistentHeap::GetUsedSize() const
+{
+    return static_cast<size_t>(m_Top);
+}
+
+inline size_t
+CPersistentHeap::GetCapacity() const
+{
+    return static_cast<size_t>(m_Capacity);
+}
+
+inline
+CPersistentHeap::CPersistentHeap()
+{
+}
+
+inline void
+CPersistentHeap::Format(size_t _Capacity)
+{
+    m_Magic      = s_Magic;
+    m_Version    = s_Version;
+    m_HeaderSize = sizeof(CPersistentHeap);
+    m_Capacity   = _Capacity;
+    m_Top        = (sizeof(CPersistentHeap) + 63) / 64 * 64;
+    m_Base       = reinterpret_cast<uint64_t>(this);
+
+    for (size_t Root = 0; Root < s_RootCount; ++Root)
+    {
+        m_Roots[Root] = 0;
+    }
+}
+
+inline char*
+CPersistentHeap::GetBase() const
+{
+    return reinterpret_cast<char*>(const_cast<CPersistentHeap*>(this));
+}
+
+/*************************************************************************
+ * PERSISTENT ARENA SUBSECTION
+ *************************************************************************/
+
+inline
+CPersistentArena::CPersistentArena(const char* _pPath, size_t _Capacity, void* _pPreferredBase)
+    : m_pHeap(0)
+    , m_Size(0)
+    , m_IsCreated(false)
+{
+    CPersistentHeap Header;
+    uint64_t        FileSize = 0;
+
+#ifdef _WIN32
+    m_Mapping = 0;
+    m_File    = CreateFileA(_pPath, GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+    if (m_File == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("cannot open persistent arena file");
+    }
+
+    m_IsCreated = GetLastError() != ERROR_ALREADY_EXISTS;
+
+    LARGE_INTEGER Size;
+    if (!GetFileSizeEx(m_File, &Size))
+    {
+        Close();
+        throw std::runtime_error("cannot stat persistent arena file");
+    }
+    FileSize = static_cast<uint64_t>(Size.QuadPart);
+
+    DWORD Read = 0;
+    if (!m_IsCreated && (!ReadFile(m_File, &Header, sizeof(Header), &Read, 0) || Read != sizeof(Header)))
+    {
+        Close();
+        throw std::runtime_error("persistent arena file is truncated");
+    }
+#else
+    m_File = open(_pPath, O_RDWR | O_CREAT, 0644);
+    if (m_File < 0)
+    {
+        throw std::runtime_error("cannot open persistent arena file");
+    }
+
+    struct stat Status;
+    if (fstat(m_File, &Status) != 0)
+    {
+        Close();
+        throw std::runtime_error("cannot stat persistent arena file");
+    }
+    FileSize    = static_cast<uint64_t>(Status.st_size);
+    m_IsCreated = FileSize == 0;
+
+    if (!m_IsCreated && pread(m_File, &Header, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header)))
+    {
+        Close();
+        throw std::runtime_error("persistent arena file is truncated");
+    }
+#endif
+
+    if (m_IsCreated)
+    {
+        if (_Capacity < sizeof(CPersistentHeap))
+        {
+            Close();
+            throw std::runtime_error("persistent arena capacity too small");
+        }
+
+        m_Size  = _Capacity;
+        m_pHeap = static_cast<CPersistentHeap*>(Map(m_Size, _pPreferredBase, false));
+        m_pHeap->Format(m_Size);
+        return;
+    }
+
+    if (Header.m_Magic != CPersistentHeap::s_Magic || Header.m_Version != CPersistentHeap::s_Version || Header.m_HeaderSize != sizeof(CPersistentHeap))
+    {
+        Close();
+        throw std::runtime_error("not a persistent arena file");
+    }
+
+    if (FileSize < Header.m_Capacity)
+    { // mapping past the end of the file would fault on first access
+        Close();
+        throw std::runtime_error("persistent arena file is truncated");
+    }
+
+    m_Size  = static_cast<size_t>(Header.m_Capacity);
+    m_pHeap = static_cast<CPersistentHeap*>(Map(m_Size, reinterpret_cast<void*>(Header.m_Base), true));
+}
+
+inline
+CPersistentArena::~CPersistentArena()
+{
+    Close();
+}
+
+inline void
+CPersistentArena::Sync()
+{
+#ifdef _WIN32
+    FlushViewOfFile(m_pHeap, 0);
+    FlushFileBuffers(m_File);
+#else
+    msync(m_pHeap, m_Size, MS_SYNC);
+#endif
+}
+
+inline CPersistentHeap&
+CPersistentArena::GetHeap() const
+{
+    return *m_pHeap;
+}
+
+inline bool
+CPersistentArena::IsCreated() const
+{
+    return m_IsCreated;
+}
+
+inline void*
+CPersistentArena::GetDefaultBase()
+{
+#if defined(_WIN64) || defined(__LP64__)
+    return reinterpret_cast<void*>(0x600000000000ULL);
+#else
+    return 0;
+#endif
+}
+
+inline void*
+CPersistentArena::Map(size_t _Size, void* _pBase, bool _IsFixed)
+{
+#ifdef _WIN32
+    LARGE_INTEGER Size;
+    Size.QuadPart = static_cast<LONGLONG>(_Size);
+
+    m_Mapping = CreateFileMappingA(m_File, 0, PAGE_READWRITE, Size.HighPart, Size.LowPart, 0);
+    void* pMem = (m_Mapping != 0) ? MapViewOfFileEx(m_Mapping, FILE_MAP_ALL_ACCESS, 0, 0, _Size, _pBase) : 0;
+
+    if (pMem == 0 && !_IsFixed && m_Mapping != 0)
+    { // preferred range is taken, a new file may live anywhere
+        pMem = MapViewOfFileEx(m_Mapping, FILE_MAP_ALL_ACCESS, 0, 0, _Size, 0);
+    }
+#else
+    if (m_IsCreated && ftruncate(m_File, static_cast<off_t>(_Size)) != 0)
+    {
+        Close();
+        throw std::runtime_error("cannot size persistent arena file");
+    }
+
+    int Flags = MAP_SHARED;
+#   ifdef MAP_FIXED_NOREPLACE
+    Flags |= (_pBase != 0) ? MAP_FIXED_NOREPLACE : 0;
+#   endif
+
+    void* pMem = mmap(_pBase, _Size, PROT_READ | PROT_WRITE, Flags, m_File, 0);
+
+    if (pMem != MAP_FAILED && _pBase != 0 && pMem != _pBase)
+    { // only taken as a hint by older kernels
+        munmap(pMem, _Size);
+        pMem = MAP_FAILED;
+    }
+    if (pMem == MAP_FAILED && !_IsFixed)
+    { // preferred range is taken, a new file may live anywhere
+        pMem = mmap(0, _Size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+    }
+    if (pMem == MAP_FAILED)
+    {
+        pMem = 0;
+    }
+#endif
+
+    if (pMem == 0)
+    {
+        Close();
+        throw std::runtime_error("cannot map persistent arena at its base address");
+    }
+
+    return pMem;
+}
+
+inline void
+CPersistentArena::Close()
+{
+#ifdef _WIN32
+    if (m_pHeap != 0)
+    {
+        UnmapViewOfFile(m_pHeap);
+    }
+    if (m_Mapping != 0)
+    {
+        CloseHandle(m_Mapping);
+    }
+    CloseHandle(m_File);
+#else
+    if (m_pHeap != 0)
+    {
+        munmap(m_pHeap, m_Size);
+    }
+    close(m_File);
+#endif
+
+    m_pHeap = 0;
+}
+
+/*************************************************************************
+ * PERSISTENT ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CPersistentAllocator<T>::CPersistentAllocator(CPersistentHeap& _rHeap)
+    : m_pHeap(&_rHeap)
+{
+}
+
+template <typename T>
+CPersistentAllocator<T>::CPersistentAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pHeap(&_rAllocator.GetHeap())
+{
+}
+
+template <typename T>
+template <typename U>
+CPersistentAllocator<T>::CPersistentAllocator(const CPersistentAllocator<U>& _rAllocator)
+    : m_pHeap(&_rAllocator.GetHeap())
+{
+}
+
+template <typename T>
+typename CPersistentAllocator<T>::self&
+CPersistentAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_pHeap = &_rAllocator.GetHeap();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CPersistentAllocator<T>::self&
+CPersistentAllocator<T>::operator=(const CPersistentAllocator<U>& _rAllocator)
+{
+    m_pHeap = &_rAllocator.GetHeap();
+    return (*this);
+}
+
+template <typename T>
+typename CPersistentAllocator<T>::pointer
+CPersistentAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    return static_cast<T*>(m_pHeap->Allocate(_Count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void
+CPersistentAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem != 0)
+    {
+        m_pHeap->Deallocate(_pMem, _Count * sizeof(T));
+    }
+}
+
+template <typename T>
+bool
+CPersistentAllocator<T>::TryExpand(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_NewCount > this->GetMaxSize())
+    {
+        return false;
+    }
+
+    return m_pHeap->TryExpand(_pMem, _Count * sizeof(T), _NewCount * sizeof(T));
+}
+
+template <typename T>
+CPersistentHeap&
+CPersistentAllocator<T>::GetHeap() const
+{
+    return *m_pHeap;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CPersistentAllocator<T1>& _rLhs, const CPersistentAllocator<T2>& _rRhs)
+{
+    return &_rLhs.GetHeap() == &_rRhs.GetHeap();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CPersistentAllocator<T1>& _rLhs, const CPersistentAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_PERSISTENT_ALLOCATOR_H_
@@ -0,0 +1,372 @@
+#ifndef __INCLUDE_POOL_ALLOCATOR_H_
+#define __INCLUDE_POOL_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <mutex>
+#include <new>
+#include "allocator.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Pool of fixed size slots for node based containers.
+ * Slots are carved from big slabs and recycled through one intrusive
+ * free list per size class, so allocating and freeing a node is O(1)
+ * and never reaches the global heap once the pool is warm. Slabs are
+ * only given back when the pool is destroyed. A pool is not thread-safe
+ * unless it is constructed with _ThreadSafe, then every operation takes
+ * a mutex. The default pool is such a pool, as every default constructed
+ * CPoolAllocator in the process shares it.
+ **/
+class CNodePool
+{
+public: // static constants
+
+    static const size_t s_Granularity = 16;                             // slot sizes are multiples of this
+    static const size_t s_MaxSlotSize = 512;                            // bigger requests bypass the pool
+    static const size_t s_SlabSize    = 64 * 1024;                      // bytes requested from the heap at once
+    static const size_t s_ClassCount  = s_MaxSlotSize / s_Granularity;
+
+public: // ctor, dtor
+
+    explicit CNodePool(bool _ThreadSafe = false);
+    ~CNodePool();
+
+public: // operations
+
+    void* Allocate(size_t _Size);                                       // returns slot of at least _Size bytes
+    void  Deallocate(void* _pMem, size_t _Size);                        // _Size has to match Allocate
+
+    static bool       IsPooled(size_t _Size, size_t _Alignment);        // whether a request is served by a pool
+    static CNodePool& GetDefault();                                     // process wide, thread-safe pool, never destroyed
+
+private: // non-copyable
+
+    CNodePool(const CNodePool&);
+    CNodePool& operator=(const CNodePool&);
+
+private: // slot and slab declaration
+
+    struct SFreeSlot
+    {
+        SFreeSlot* m_pNext;
+    };
+
+    struct SSlab
+    {
+        SSlab* m_pNext;
+    };
+
+    static const size_t s_SlabHeaderSize = (sizeof(SSlab) + s_Granularity - 1) / s_Granularity * s_Granularity;
+
+private: // internal methods
+
+    void* AllocateSlot(size_t _Size);
+    void  DeallocateSlot(void* _pMem, size_t _Size);
+    void* Carve(size_t _SlotSize);
+
+private: // member
+
+    SFreeSlot* m_pFreeLists[s_ClassCount];
+    SSlab*     m_pSlabs;
+    char*      m_pCursor;                                               // untouched rest of the newest slab
+    char*      m_pSlabEnd;
+    bool       m_ThreadSafe;
+    std::mutex m_Mutex;                                                 // only taken if m_ThreadSafe
+};
+
+/**
+ * Allocator handing out memory from a CNodePool.
+ * Can be used as TAllocator argument of every container. Rebinding keeps
+ * the pool, so a list and its nodes share the same slots. Requests bigger
+ * than CNodePool::s_MaxSlotSize go to the global heap. Default constructed
+ * allocators use the locked CNodePool::GetDefault(), a private unlocked
+ * pool passed to the constructor avoids the mutex for single thread use.
+ **/
+template <typename T>
+class CPoolAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CPoolAllocator<T> self;
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CPoolAllocator<U> other;
+    };
+
+public:
+
+    CPoolAllocator();
+    explicit CPoolAllocator(CNodePool& _rPool);
+    CPoolAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CPoolAllocator(const CPoolAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CPoolAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+
+    CNodePool& GetPool() const;
+
+private:
+
+    CNodePool* m_pPool;
+};
+
+/*************************************************************************
+ * NODE POOL SUBSECTION
+ *************************************************************************/
+
+inline
+CNodePool::CNodePool(bool _ThreadSafe)
+    : m_pSlabs(0)
+    , m_pCursor(0)
+    , m_pSlabEnd(0)
+    , m_ThreadSafe(_ThreadSafe)
+{
+    for (size_t Class = 0; Class < s_ClassCount; ++Class)
+    {
+        m_pFreeLists[Class] = 0;
+    }
+}
+
+inline
+CNodePool::~CNodePool()
+{
+    while (m_pSlabs != 0)
+    {
+        SSlab* pTemp = m_pSlabs;
+        m_pSlabs = m_pSlabs->m_pNext;
+        ::operator delete(pTemp);
+    }
+}
+
+inline void*
+CNodePool::Allocate(size_t _Size)
+{
+    if (m_ThreadSafe)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        return AllocateSlot(_Size);
+    }
+
+    return AllocateSlot(_Size);
+}
+
+inline void
+CNodePool::Deallocate(void* _pMem, size_t _Size)
+{
+    if (m_ThreadSafe)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        DeallocateSlot(_pMem, _Size);
+        return;
+    }
+
+    DeallocateSlot(_pMem, _Size);
+}
+
+inline bool
+CNodePool::IsPooled(size_t _Size, size_t _Alignment)
+{
+    return _Size > 0 && _Size <= s_MaxSlotSize && _Alignment <= s_Granularity;
+}
+
+inline CNodePool&
+CNodePool::GetDefault()
+{
+    // intentionally leaked, so containers with static storage duration
+    // can still return their nodes during program termination
+    static CNodePool* s_pPool = new CNodePool(true);
+    return *s_pPool;
+}
+
+inline void*
+CNodePool::AllocateSlot(size_t _Size)
+{
+    assert(_Size > 0 && _Size <= s_MaxSlotSize && "size not served by node pool");
+
+    size_t Class = (_Size - 1) / s_Granularity;
+    SFreeSlot* pSlot = m_pFreeLists[Class];
+
+    if (pSlot == 0)
+    {
+        return Carve((Class + 1) * s_Granularity);
+    }
+
+    m_pFreeLists[Class] = pSlot->m_pNext;
+    return pSlot;
+}
+
+inline void
+CNodePool::DeallocateSlot(void* _pMem, size_t _Size)
+{
+    assert(_Size > 0 && _Size <= s_MaxSlotSize && "size not served by node pool");
+
+    size_t Class = (_Size - 1) / s_Granularity;
+    SFreeSlot* pSlot = static_cast<SFreeSlot*>(_pMem);
+
+    pSlot->m_pNext = m_pFreeLists[Class];
+    m_pFreeLists[Class] = pSlot;
+}
+
+inline void*
+CNodePool::Carve(size_t _SlotSize)
+{
+    if (static_cast<size_t>(m_pSlabEnd - m_pCursor) < _SlotSize)
+    { // rest of the slab is too small, it stays unused
+        SSlab* pSlab = static_cast<SSlab*>(::operator new(s_SlabSize));
+        pSlab->m_pNext = m_pSlabs;
+        m_pSlabs = pSlab;
+
+        m_pCursor  = reinterpret_cast<char*>(pSlab) + s_SlabHeaderSize;
+        m_pSlabEnd = reinterpret_cast<char*>(pSlab) + s_SlabSize;
+    }
+
+    void* pSlot = m_pCursor;
+    m_pCursor += _SlotSize;
+    return pSlot;
+}
+
+/*************************************************************************
+ * POOL ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CPoolAllocator<T>::CPoolAllocator()
+    : m_pPool(&CNodePool::GetDefault())
+{
+}
+
+template <typename T>
+CPoolAllocator<T>::CPoolAllocator(CNodePool& _rPool)
+    : m_pPool(&_rPool)
+{
+}
+
+template <typename T>
+CPoolAllocator<T>::CPoolAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pPool(&_rAllocator.GetPool())
+{
+}
+
+template <typename T>
+template <typename U>
+CPoolAllocator<T>::CPoolAllocator(const CPoolAllocator<U>& _rAllocator)
+    : m_pPool(&_rAllocator.GetPool())
+{
+}
+
+template <typename T>
+typename CPoolAllocator<T>::self&
+CPoolAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_pPool = &_rAllocator.GetPool();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CPoolAllocator<T>::self&
+CPoolAllocator<T>::operator=(const CPoolAllocator<U>& _rAllocator)
+{
+    m_pPool = &_rAllocator.GetPool();
+    return (*this);
+}
+
+template <typename T>
+typename CPoolAllocator<T>::pointer
+CPoolAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    size_t Size = _Count * sizeof(T);
+    void*  pMem = CNodePool::IsPooled(Size, alignof(T)) ? m_pPool->Allocate(Size) : ::operator new(Size);
+
+    return static_cast<T*>(pMem);
+}
+
+template <typename T>
+void
+CPoolAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem == 0)
+    {
+        return;
+    }
+
+    size_t Size = _Count * sizeof(T);
+
+    if (CNodePool::IsPooled(Size, alignof(T)))
+    {
+        m_pPool->Deallocate(_pMem, Size);
+    }
+    else
+    {
+        ::operator delete(_pMem);
+    }
+}
+
+template <typename T>
+CNodePool&
+CPoolAllocator<T>::GetPool() const
+{
+    return *m_pPool;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CPoolAllocator<T1>& _rLhs, const CPoolAllocator<T2>& _rRhs)
+{
+    return &_rLhs.GetPool() == &_rRhs.GetPool();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CPoolAllocator<T1>& _rLhs, const CPoolAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_POOL_ALLOCATOR_H_
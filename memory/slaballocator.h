@@ -0,0 +1,827 @@
+#ifndef __INCLUDE_SLAB_ALLOCATOR_H_
+#define __INCLUDE_SLAB_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include <new>
+#include <mutex>
+#include "allocator.h"
+#include "pagememory.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * General purpose heap with segregated size classes.
+ * Small requests are served from 64 KiB slabs, each holding blocks of one
+ * size class only; the owning slab is found by masking the block address.
+ * Slabs that run empty go to a cache shared by all classes and are reused
+ * for whatever class needs a slab next. Requests above s_MaxSmallSize are
+ * mapped directly, rounded up to one of four sizes per power of two. Freed
+ * large blocks up to s_MaxCachedSize are kept per size and handed out again
+ * without a system call, so growing buffers do not pay mmap, munmap and
+ * fresh page faults on every step. Both caches are bounded, and Decay() or
+ * Purge() hand cached memory back to the operating system. TryExpand and
+ * Reallocate resize a block in place where its size class or mapping has
+ * room and remap large blocks instead of copying them. Thread-safe.
+ **/
+class CSlabHeap
+{
+public: // static constants
+
+    static const size_t s_SlabSize          = 64 * 1024;
+    static const size_t s_MaxSmallSize      = 16 * 1024;                // bigger requests are mapped directly
+    static const size_t s_MaxSmallAlignment = 64;
+    static const size_t s_DefaultCacheLimit = 64;                       // empty slabs kept, 4 MiB
+    static const size_t s_MaxCachedSize     = 32 * 1024 * 1024;         // bigger blocks are unmapped on release
+    static const size_t s_DefaultLargeLimit = 32 * 1024 * 1024;         // bytes of large blocks kept
+
+public: // ctor, dtor
+
+    CSlabHeap();
+    ~CSlabHeap();
+
+public: // operations
+
+    void* Allocate(size_t _Size, size_t _Alignment);
+    void  Deallocate(void* _pMem, size_t _Size, size_t _Alignment);     // size and alignment have to match Allocate
+
+    bool  TryExpand(void* _pMem, size_t _Size, size_t _NewSize, size_t _Alignment);    // resizes without moving
+    void* Reallocate(void* _pMem, size_t _Size, size_t _NewSize, size_t _Alignment);   // may move the bytes
+
+    void   SetCacheLimit(size_t _SlabCount);                            // empty slabs kept beyond that go back to the OS
+    void   SetLargeCacheLimit(size_t _Bytes);                           // large blocks kept beyond that go back to the OS
+    size_t Decay();                                                     // releases half of the cached memory, call periodically
+    size_t Purge();                                                     // releases all cached memory
+
+public: // properties
+
+    size_t GetSlabCount() const;                                        // slabs in use or cached
+    size_t GetCachedSlabCount() const;
+    size_t GetCachedLargeSize() const;                                  // bytes of cached large blocks
+
+    static CSlabHeap& GetDefault();                                     // process wide heap, never destroyed
+
+private: // non-copyable
+
+    CSlabHeap(const CSlabHeap&);
+    CSlabHeap& operator=(const CSlabHeap&);
+
+private: // slab declaration
+
+    static const size_t s_Granularity     = 16;
+    static const size_t s_MaxClassCount   = 40;
+    static const size_t s_SlabHeaderSize  = 64;
+    static const size_t s_NoClass         = static_cast<size_t>(-1);
+    static const size_t s_LargeClassCount = 44;                         // four per power of two, 16 KiB to 32 MiB
+
+    struct SFreeBlock                                                   // released small and cached large blocks
+    {
+        SFreeBlock* m_pNext;
+    };
+
+    struct SSlab                                                        // lives in the first bytes of every slab
+    {
+        SSlab*      m_pPrev;                                            // partial list of the size class
+        SSlab*      m_pNext;
+        SSlab*      m_pAllPrev;                                         // list of all slabs of the heap
+        SSlab*      m_pAllNext;
+        SFreeBlock* m_pFree;                                            // released blocks
+        char*       m_pUnused;                                          // never handed out blocks start here
+        size_t      m_Class;
+        size_t      m_UsedCount;
+    };
+
+    struct SSizeClass
+    {
+        std::mutex m_Mutex;
+        SSlab*     m_pPartial;                                          // slabs with at least one free block
+        size_t     m_BlockSize;
+        size_t     m_BlockCount;                                        // blocks per slab
+    };
+
+private: // internal methods
+
+    size_t GetClass(size_t _Size, size_t _Alignment) const;
+    SSlab* GetSlab(void* _pMem) const;
+
+    SSlab* AcquireSlab(size_t _Class);
+    void   ReleaseSlab(SSlab* _pSlab);
+    size_t TrimCache(size_t _Keep);
+
+    static size_t GetLargeClass(size_t _Size, size_t _Alignment);      // s_NoClass for blocks that are not cached
+    static size_t GetLargeClassSize(size_t _Class);
+    static size_t GetMappedSize(size_t _Size, size_t _Alignment);
+
+    void*  AcquireLarge(size_t _Size, size_t _Alignment);
+    void   ReleaseLarge(void* _pMem, size_t _Size, size_t _Alignment);
+    size_t TrimLargeCache(size_t _Keep);                               // _Keep in bytes
+
+    static void LinkPartial(SSizeClass& _rClass, SSlab* _pSlab);
+    static void UnlinkPartial(SSizeClass& _rClass, SSlab* _pSlab);
+
+private: // member
+
+    SSizeClass         m_Classes[s_MaxClassCount];
+    size_t             m_ClassCount;
+    unsigned char      m_ClassLookup[s_MaxSmallSize / s_Granularity + 1];
+    mutable std::mutex m_SlabMutex;                                     // guards everything below
+    SSlab*             m_pAllSlabs;
+    SSlab*             m_pCachedSlabs;
+    size_t             m_SlabCount;
+    size_t             m_CachedCount;
+    size_t             m_CacheLimit;
+    SFreeBlock*        m_pLargeBlocks[s_LargeClassCount];
+    size_t             m_LargeCachedSize;
+    size_t             m_LargeLimit;
+};
+
+/**
+ * Allocator handing out memory from a CSlabHeap.
+ * Can be used as TAllocator argument of every container. Rebinding keeps
+ * the heap, default constructed instances share CSlabHeap::GetDefault().
+ * Provides TryExpand and Reallocate, see SAllocatorTraits.
+ **/
+template <typename T>
+class CSlabAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CSlabAllocator<T> self;
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CSlabAllocator<U> other;
+    };
+
+public:
+
+    CSlabAllocator();
+    explicit CSlabAllocator(CSlabHeap& _rHeap);
+    CSlabAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CSlabAllocator(const CSlabAllocator<U>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CSlabAllocator<U>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+    bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+    pointer Reallocate(pointer _pMem, size_type _Count, size_type _NewCount);
+
+    CSlabHeap& GetHeap() const;
+
+private:
+
+    CSlabHeap* m_pHeap;
+};
+
+/*************************************************************************
+ * SLAB HEAP SUBSECTION
+ *************************************************************************/
+
+inline
+CSlabHeap::CSlabHeap()
+    : m_ClassCount(0)
+    , m_pAllSlabs(0)
+    , m_pCachedSlabs(0)
+    , m_SlabCount(0)
+    , m_CachedCount(0)
+    , m_CacheLimit(s_DefaultCacheLimit)
+    , m_LargeCachedSize(0)
+    , m_LargeLimit(s_DefaultLargeLimit)
+{
+    for (size_t Class = 0; Class < s_LargeClassCount; ++Class)
+    {
+        m_pLargeBlocks[Class] = 0;
+    }
+
+    // 16 byte steps up to 128, then four classes per power of two
+    size_t Size = s_Granularity;
+    while (Size <= s_MaxSmallSize)
+    {
+        assert(m_ClassCount < s_MaxClassCount && "too many size classes");
+
+        SSizeClass& rClass = m_Classes[m_ClassCount++];
+        rClass.m_pPartial   = 0;
+        rClass.m_BlockSize  = Size;
+        rClass.m_BlockCount = (s_SlabSize - s_SlabHeaderSize) / Size;
+
+        if (Size < 128)
+        {
+            Size += s_Granularity;
+        }
+        else
+        {
+            size_t Power = 128;
+            while (Power * 2 <= Size)
+            {
+                Power *= 2;
+            }
+            Size += Power / 4;
+        }
+    }
+
+    size_t Class = 0;
+    for (size_t Index = 0; Index <= s_MaxSmallSize / s_Granularity; ++Index)
+    {
+        while (m_Classes[Class].m_BlockSize < Index * s_Granularity)
+        {
+            ++Class;
+        }
+        m_ClassLookup[Index] = static_cast<unsigned char>(Class);
+    }
+}
+
+inline
+CSlabHeap::~CSlabHeap()
+{
+    while (m_pAllSlabs != 0)
+    {
+        SSlab* pSlab = m_pAllSlabs;
+        m_pAllSlabs = pSlab->m_pAllNext;
+        FreePages(pSlab, s_SlabSize);
+    }
+
+    TrimLargeCache(0);
+}
+
+inline void*
+CSlabHeap::Allocate(size_t _Size, size_t _Alignment)
+{
+    size_t Class = GetClass(_Size, _Alignment);
+
+    if (Class == s_NoClass)
+    {
+        return AcquireLarge(_Size, _Alignment);
+    }
+
+    SSizeClass& rClass = m_Classes[Class];
+    std::lock_guard<std::mutex> Lock(rClass.m_Mutex);
+
+    SSlab* pSlab = rClass.m_pPartial;
+    if (pSlab == 0)
+    {
+        pSlab = AcquireSlab(Class);
+        LinkPartial(rClass, pSlab);
+    }
+
+    void* pBlock = pSlab->m_pFree;
+    if (pBlock != 0)
+    {
+        pSlab->m_pFree = pSlab->m_pFree->m_pNext;
+    }
+    else
+    {
+        pBlock = pSlab->m_pUnused;
+        pSlab->m_pUnused += rClass.m_BlockSize;
+    }
+
+    if (++pSlab->m_UsedCount == rClass.m_BlockCount)
+    {
+        UnlinkPartial(rClass, pSlab);
+    }
+
+    return pBlock;
+}
+
+inline void
+CSlabHeap::Deallocate(void* _pMem, size_t _Size, size_t _Alignment)
+{
+    if (GetClass(_Size, _Alignment) == s_NoClass)
+    {
+        ReleaseLarge(_pMem, _Size, _Alignment);
+        return;
+    }
+
+    SSlab*      pSlab  = GetSlab(_pMem);
+    SSizeClass& rClass = m_Classes[pSlab->m_Class];
+    std::lock_guard<std::mutex> Lock(rClass.m_Mutex);
+
+    SFreeBlock* pBlock = static_cast<SFreeBlock*>(_pMem);
+    pBlock->m_pNext = pSlab->m_pFree;
+    pSlab->m_pFree = pBlock;
+
+    if (pSlab->m_UsedCount-- == rClass.m_BlockCount)
+    { // slab was full and is available again
+        LinkPartial(rClass, pSlab);
+    }
+
+    if (pSlab->m_UsedCount == 0 && (pSlab->m_pPrev != 0 || pSlab->m_pNext != 0))
+    { // empty and not the last slab of its class, which is kept against thrashing
+        UnlinkPartial(rClass, pSlab);
+        ReleaseSlab(pSlab);
+    }
+}
+
+inline bool
+CSlabHeap::TryExpand(void* _pMem, size_t _Size, size_t _NewSize, size_t _Alignment)
+{
+    size_t Class    = GetClass(_Size, _Alignment);
+    size_t NewClass = GetClass(_NewSize, _Alignment);
+
+    if (Class != s_NoClass || NewClass != s_NoClass)
+    { // a small block only fits sizes of its own class
+        return Class == NewClass;
+    }
+
+    size_t MappedSize    = GetMappedSize(_Size, _Alignment);
+    size_t NewMappedSize = GetMappedSize(_NewSize, _Alignment);
+
+    if (MappedSize == NewMappedSize)
+    {
+        return true;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    return NewMappedSize > MappedSize && mremap(_pMem, MappedSize, NewMappedSize, 0) != MAP_FAILED;
+#else
+    return false;
+#endif
+}
+
+inline void*
+CSlabHeap::Reallocate(void* _pMem, size_t _Size, size_t _NewSize, size_t _Alignment)
+{
+    if (TryExpand(_pMem, _Size, _NewSize, _Alignment))
+    {
+        return _pMem;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    if (GetClass(_Size, _Alignment) == s_NoClass && GetClass(_NewSize, _Alignment) == s_NoClass && _Alignment <= GetPageSize())
+    { // the kernel moves the page table entries, no byte is copied
+        void* pMap = mremap(_pMem, GetMappedSize(_Size, _Alignment), GetMappedSize(_NewSize, _Alignment), MREMAP_MAYMOVE);
+        if (pMap != MAP_FAILED)
+        {
+            return pMap;
+        }
+    }
+#endif
+
+    void* pNewMem = Allocate(_NewSize, _Alignment);
+    memcpy(pNewMem, _pMem, _Size < _NewSize ? _Size : _NewSize);
+    Deallocate(_pMem, _Size, _Alignment);
+
+    return pNewMem;
+}
+
+inline void
+CSlabHeap::SetCacheLimit(size_t _SlabCount)
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    m_CacheLimit = _SlabCount;
+    TrimCache(m_CacheLimit);
+}
+
+inline void
+CSlabHeap::SetLargeCacheLimit(size_t _Bytes)
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    m_LargeLimit = _Bytes;
+    TrimLargeCache(m_LargeLimit);
+}
+
+inline size_t
+CSlabHeap::Decay()
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    return TrimCache(m_CachedCount / 2) + TrimLargeCache(m_LargeCachedSize / 2);
+}
+
+inline size_t
+CSlabHeap::Purge()
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    return TrimCache(0) + TrimLargeCache(0);
+}
+
+inline size_t
+CSlabHeap::GetSlabCount() const
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    return m_SlabCount;
+}
+
+inline size_t
+CSlabHeap::GetCachedSlabCount() const
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    return m_CachedCount;
+}
+
+inline size_t
+CSlabHeap::GetCachedLargeSize() const
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+    return m_LargeCachedSize;
+}
+
+inline CSlabHeap&
+CSlabHeap::GetDefault()
+{
+    // intentionally leaked, so containers with static storage duration
+    // can still release their memory during program termination
+    static CSlabHeap* s_pHeap = new CSlabHeap();
+    return *s_pHeap;
+}
+
+inline size_t
+CSlabHeap::GetClass(size_t _Size, size_t _Alignment) const
+{
+    if (_Size == 0 || _Size > s_MaxSmallSize || _Alignment > s_MaxSmallAlignment)
+    {
+        return s_NoClass;
+    }
+
+    // blocks are aligned to their size, as far as it is a power of two
+    size_t Class = m_ClassLookup[(_Size + s_Granularity - 1) / s_Granularity];
+    while (Class < m_ClassCount && m_Classes[Class].m_BlockSize % _Alignment != 0)
+    {
+        ++Class;
+    }
+
+    return Class < m_ClassCount ? Class : s_NoClass;
+}
+
+inline CSlabHeap::SSlab*
+CSlabHeap::GetSlab(void* _pMem) const
+{
+    return reinterpret_cast<SSlab*>(reinterpret_cast<size_t>(_pMem) & ~(s_SlabSize - 1));
+}
+
+inline CSlabHeap::SSlab*
+CSlabHeap::AcquireSlab(size_t _Class)
+{
+    SSlab* pSlab = 0;
+
+    {
+        std::lock_guard<std::mutex> Lock(m_SlabMutex);
+
+        if (m_pCachedSlabs != 0)
+        {
+            pSlab = m_pCachedSlabs;
+            m_pCachedSlabs = pSlab->m_pNext;
+            --m_CachedCount;
+        }
+    }
+
+    if (pSlab == 0)
+    {
+        pSlab = static_cast<SSlab*>(AllocatePages(s_SlabSize, s_SlabSize));
+
+        std::lock_guard<std::mutex> Lock(m_SlabMutex);
+        pSlab->m_pAllPrev = 0;
+        pSlab->m_pAllNext = m_pAllSlabs;
+        if (m_pAllSlabs != 0)
+        {
+            m_pAllSlabs->m_pAllPrev = pSlab;
+        }
+        m_pAllSlabs = pSlab;
+        ++m_SlabCount;
+    }
+
+    pSlab->m_pPrev     = 0;
+    pSlab->m_pNext     = 0;
+    pSlab->m_pFree     = 0;
+    pSlab->m_pUnused   = reinterpret_cast<char*>(pSlab) + s_SlabHeaderSize;
+    pSlab->m_Class     = _Class;
+    pSlab->m_UsedCount = 0;
+
+    return pSlab;
+}
+
+inline void
+CSlabHeap::ReleaseSlab(SSlab* _pSlab)
+{
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+
+    _pSlab->m_pNext = m_pCachedSlabs;
+    m_pCachedSlabs = _pSlab;
+    ++m_CachedCount;
+
+    TrimCache(m_CacheLimit);
+}
+
+inline size_t
+CSlabHeap::TrimCache(size_t _Keep)
+{
+    // m_SlabMutex has to be held by the caller
+    size_t Released = 0;
+
+    while (m_CachedCount > _Keep)
+    {
+        SSlab* pSlab = m_pCachedSlabs;
+        m_pCachedSlabs = pSlab->m_pNext;
+        --m_CachedCount;
+
+        if (pSlab->m_pAllPrev != 0)
+        {
+            pSlab->m_pAllPrev->m_pAllNext = pSlab->m_pAllNext;
+        }
+        else
+        {
+            m_pAllSlabs = pSlab->m_pAllNext;
+        }
+        if (pSlab->m_pAllNext != 0)
+        {
+            pSlab->m_pAllNext->m_pAllPrev = pSlab->m_pAllPrev;
+        }
+
+        FreePages(pSlab, s_SlabSize);
+        --m_SlabCount;
+        ++Released;
+    }
+
+    return Released;
+}
+
+inline size_t
+CSlabHeap::GetLargeClass(size_t _Size, size_t _Alignment)
+{
+    if (_Size <= s_MaxSmallSize || _Size > s_MaxCachedSize || _Alignment > GetPageSize())
+    {
+        return s_NoClass;
+    }
+
+    // _Size lies in (Power, 2 * Power], which is split into four steps
+    size_t Level = 0;
+    while ((s_MaxSmallSize << Level) * 2 < _Size)
+    {
+        ++Level;
+    }
+
+    size_t Step = (s_MaxSmallSize << Level) / 4;
+    return Level * 4 + (_Size + Step - 1) / Step - 5;
+}
+
+inline size_t
+CSlabHeap::GetLargeClassSize(size_t _Class)
+{
+    size_t Step = (s_MaxSmallSize << (_Class / 4)) / 4;
+    return RoundToPageSize(Step * (_Class % 4 + 5));
+}
+
+inline size_t
+CSlabHeap::GetMappedSize(size_t _Size, size_t _Alignment)
+{
+    size_t Class = GetLargeClass(_Size, _Alignment);
+    return Class != s_NoClass ? GetLargeClassSize(Class) : RoundToPageSize(_Size);
+}
+
+inline void*
+CSlabHeap::AcquireLarge(size_t _Size, size_t _Alignment)
+{
+    size_t Class = GetLargeClass(_Size, _Alignment);
+
+    if (Class != s_NoClass)
+    {
+        std::lock_guard<std::mutex> Lock(m_SlabMutex);
+
+        SFreeBlock* pBlock = m_pLargeBlocks[Class];
+        if (pBlock != 0)
+        {
+            m_pLargeBlocks[Class] = pBlock->m_pNext;
+            m_LargeCachedSize -= GetMappedSize(_Size, _Alignment);
+            return pBlock;
+        }
+    }
+
+    return AllocatePages(GetMappedSize(_Size, _Alignment), _Alignment);
+}
+
+inline void
+CSlabHeap::ReleaseLarge(void* _pMem, size_t _Size, size_t _Alignment)
+{
+    size_t Class = GetLargeClass(_Size, _Alignment);
+
+    if (Class == s_NoClass)
+    {
+        FreePages(_pMem, GetMappedSize(_Size, _Alignment));
+        return;
+    }
+
+    std::lock_guard<std::mutex> Lock(m_SlabMutex);
+
+    SFreeBlock* pBlock = static_cast<SFreeBlock*>(_pMem);
+    pBlock->m_pNext = m_pLargeBlocks[Class];
+    m_pLargeBlocks[Class] = pBlock;
+    m_LargeCachedSize += GetMappedSize(_Size, _Alignment);
+
+    TrimLargeCache(m_LargeLimit);
+}
+
+inline size_t
+CSlabHeap::TrimLargeCache(size_t _Keep)
+{
+    // m_SlabMutex has to be held by the caller, the biggest blocks go first
+    size_t Released = 0;
+
+    for (size_t Class = s_LargeClassCount; Class-- > 0 && m_LargeCachedSize > _Keep; )
+    {
+        size_t MappedSize = GetLargeClassSize(Class);
+
+        while (m_pLargeBlocks[Class] != 0 && m_LargeCachedSize > _Keep)
+        {
+            SFreeBlock* pBlock = m_pLargeBlocks[Class];
+            m_pLargeBlocks[Class] = pBlock->m_pNext;
+            m_LargeCachedSize -= MappedSize;
+
+            FreePages(pBlock, MappedSize);
+            ++Released;
+        }
+    }
+
+    return Released;
+}
+
+inline void
+CSlabHeap::LinkPartial(SSizeClass& _rClass, SSlab* _pSlab)
+{
+    _pSlab->m_pPrev = 0;
+    _pSlab->m_pNext = _rClass.m_pPartial;
+    if (_rClass.m_pPartial != 0)
+    {
+        _rClass.m_pPartial->m_pPrev = _pSlab;
+    }
+    _rClass.m_pPartial = _pSlab;
+}
+
+inline void
+CSlabHeap::UnlinkPartial(SSizeClass& _rClass, SSlab* _pSlab)
+{
+    if (_pSlab->m_pPrev != 0)
+    {
+        _pSlab->m_pPrev->m_pNext = _pSlab->m_pNext;
+    }
+    else
+    {
+        _rClass.m_pPartial = _pSlab->m_pNext;
+    }
+    if (_pSlab->m_pNext != 0)
+    {
+        _pSlab->m_pNext->m_pPrev = _pSlab->m_pPrev;
+    }
+
+    _pSlab->m_pPrev = 0;
+    _pSlab->m_pNext = 0;
+}
+
+/*************************************************************************
+ * SLAB ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CSlabAllocator<T>::CSlabAllocator()
+    : m_pHeap(&CSlabHeap::GetDefault())
+{
+}
+
+template <typename T>
+CSlabAllocator<T>::CSlabAllocator(CSlabHeap& _rHeap)
+    : m_pHeap(&_rHeap)
+{
+}
+
+template <typename T>
+CSlabAllocator<T>::CSlabAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pHeap(&_rAllocator.GetHeap())
+{
+}
+
+template <typename T>
+template <typename U>
+CSlabAllocator<T>::CSlabAllocator(const CSlabAllocator<U>& _rAllocator)
+    : m_pHeap(&_rAllocator.GetHeap())
+{
+}
+
+template <typename T>
+typename CSlabAllocator<T>::self&
+CSlabAllocator<T>::operator=(const self& _rAllocator)
+{
+    m_pHeap = &_rAllocator.GetHeap();
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CSlabAllocator<T>::self&
+CSlabAllocator<T>::operator=(const CSlabAllocator<U>& _rAllocator)
+{
+    m_pHeap = &_rAllocator.GetHeap();
+    return (*this);
+}
+
+template <typename T>
+typename CSlabAllocator<T>::pointer
+CSlabAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    return static_cast<T*>(m_pHeap->Allocate(_Count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void
+CSlabAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem != 0)
+    {
+        m_pHeap->Deallocate(_pMem, _Count * sizeof(T), alignof(T));
+    }
+}
+
+template <typename T>
+bool
+CSlabAllocator<T>::TryExpand(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_NewCount == 0 || _NewCount > this->GetMaxSize())
+    {
+        return false;
+    }
+
+    return m_pHeap->TryExpand(_pMem, _Count * sizeof(T), _NewCount * sizeof(T), alignof(T));
+}
+
+template <typename T>
+typename CSlabAllocator<T>::pointer
+CSlabAllocator<T>::Reallocate(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (_NewCount == 0)
+    {
+        Deallocate(_pMem, _Count);
+        return 0;
+    }
+    if (_NewCount > this->GetMaxSize())
+    {
+        throw std::bad_alloc();
+    }
+    if (_pMem == 0)
+    {
+        return Allocate(_NewCount);
+    }
+
+    return static_cast<T*>(m_pHeap->Reallocate(_pMem, _Count * sizeof(T), _NewCount * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+CSlabHeap&
+CSlabAllocator<T>::GetHeap() const
+{
+    return *m_pHeap;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CSlabAllocator<T1>& _rLhs, const CSlabAllocator<T2>& _rRhs)
+{
+    return &_rLhs.GetHeap() == &_rRhs.GetHeap();
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CSlabAllocator<T1>& _rLhs, const CSlabAllocator<T2>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_SLAB_ALLOCATOR_H_
@@ -0,0 +1,421 @@
+#ifndef __INCLUDE_STATS_ALLOCATOR_H_
+#define __INCLUDE_STATS_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <atomic>
+#include "allocator.h"
+#include "allocatortraits.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Counters shared by all allocators reporting to the same tag.
+ * Tracks calls, live and peak bytes and a histogram of request sizes with
+ * one bucket per power of two. Updates are relaxed atomics, so one object
+ * can be shared between threads; a snapshot is a consistent copy of each
+ * counter, not of all counters at the same instant.
+ **/
+class CAllocationStats
+{
+public: // static constants
+
+    static const size_t s_BucketCount = 32;                             // bucket i counts sizes in [2^i, 2^(i+1)), the last one all above
+
+public: // snapshot declaration
+
+    struct SSnapshot
+    {
+        const char* m_pName;
+        size_t      m_AllocationCount;
+        size_t      m_DeallocationCount;
+        size_t      m_AllocatedBytes;                                   // total over lifetime
+        size_t      m_LiveBytes;
+        size_t      m_PeakBytes;
+        size_t      m_Histogram[s_BucketCount];
+
+        void Print(FILE* _pFile) const;
+    };
+
+public: // ctor, dtor
+
+    explicit CAllocationStats(const char* _pName);
+
+public: // operations
+
+    void OnAllocate(size_t _Size);
+    void OnDeallocate(size_t _Size);
+
+    SSnapshot   GetSnapshot() const;
+    void        Reset();                                                // live bytes are kept, peak restarts from them
+    const char* GetName() const;
+
+    static size_t            GetBucket(size_t _Size);
+    static CAllocationStats& GetDefault();                              // process wide tag "default", never destroyed
+
+private: // non-copyable
+
+    CAllocationStats(const CAllocationStats&);
+    CAllocationStats& operator=(const CAllocationStats&);
+
+private: // member
+
+    const char*         m_pName;
+    std::atomic<size_t> m_AllocationCount;
+    std::atomic<size_t> m_DeallocationCount;
+    std::atomic<size_t> m_AllocatedBytes;
+    std::atomic<size_t> m_LiveBytes;
+    std::atomic<size_t> m_PeakBytes;
+    std::atomic<size_t> m_Histogram[s_BucketCount];
+};
+
+/**
+ * Decorator recording every request of an inner allocator in a CAllocationStats.
+ * Pass one stats object per container for per instance numbers or share
+ * a named one between containers for per tag numbers. As containers take a
+ * template with a single parameter, bind the inner allocator with an alias
+ * template, e.g. CHeapStatsAllocator below. Growing a block in place or by
+ * Reallocate counts as a deallocation of the old and an allocation of the
+ * new size.
+ **/
+template <typename T, template <typename> class TInner = CAllocator>
+class CStatsAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+    typedef TInner<T>     inner_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CStatsAllocator<T, TInner> self;
+
+    static const size_type s_Alignment = SAllocatorTraits<inner_type>::s_Alignment;
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CStatsAllocator<U, TInner> other;
+    };
+
+public:
+
+    CStatsAllocator();
+    explicit CStatsAllocator(CAllocationStats& _rStats, const inner_type& _rInner = inner_type());
+    CStatsAllocator(const self& _rAllocator);
+    self& operator=(const self& _rAllocator);
+
+    template <typename U>
+    CStatsAllocator(const CStatsAllocator<U, TInner>& _rAllocator);
+
+    template <typename U>
+    self& operator=(const CStatsAllocator<U, TInner>& _rAllocator);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+    bool    TryExpand(pointer _pMem, size_type _Count, size_type _NewCount);
+    pointer Reallocate(pointer _pMem, size_type _Count, size_type _NewCount);
+
+    CAllocationStats& GetStats() const;
+    const inner_type& GetInner() const;
+
+private:
+
+    CAllocationStats* m_pStats;
+    inner_type        m_Inner;
+};
+
+template <typename T>
+using CHeapStatsAllocator = CStatsAllocator<T, CAllocator>;
+
+/*************************************************************************
+ * ALLOCATION STATS SUBSECTION
+ *************************************************************************/
+
+inline
+CAllocationStats::CAllocationStats(const char* _pName)
+    : m_pName(_pName)
+    , m_AllocationCount(0)
+    , m_DeallocationCount(0)
+    , m_AllocatedBytes(0)
+    , m_LiveBytes(0)
+    , m_PeakBytes(0)
+{
+    for (size_t Bucket = 0; Bucket < s_BucketCount; ++Bucket)
+    {
+        m_Histogram[Bucket].store(0, std::memory_order_relaxed);
+    }
+}
+
+inline void
+CAllocationStats::OnAllocate(size_t _Size)
+{
+    m_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    m_AllocatedBytes.fetch_add(_Size, std::memory_order_relaxed);
+    m_Histogram[GetBucket(_Size)].fetch_add(1, std::memory_order_relaxed);
+
+    size_t LiveBytes = m_LiveBytes.fetch_add(_Size, std::memory_order_relaxed) + _Size;
+    size_t PeakBytes = m_PeakBytes.load(std::memory_order_relaxed);
+
+    while (PeakBytes < LiveBytes && !m_PeakBytes.compare_exchange_weak(PeakBytes, LiveBytes, std::memory_order_relaxed))
+    { // PeakBytes is reloaded by the failed exchange
+    }
+}
+
+inline void
+CAllocationStats::OnDeallocate(size_t _Size)
+{
+    m_DeallocationCount.fetch_add(1, std::memory_order_relaxed);
+    m_LiveBytes.fetch_sub(_Size, std::memory_order_relaxed);
+}
+
+inline CAllocationStats::SSnapshot
+CAllocationStats::GetSnapshot() const
+{
+    SSnapshot Snapshot;
+
+    Snapshot.m_pName             = m_pName;
+    Snapshot.m_AllocationCount   = m_AllocationCount.load(std::memory_order_relaxed);
+    Snapshot.m_DeallocationCount = m_DeallocationCount.load(std::memory_order_relaxed);
+    Snapshot.m_AllocatedBytes    = m_AllocatedBytes.load(std::memory_order_relaxed);
+    Snapshot.m_LiveBytes         = m_LiveBytes.load(std::memory_order_relaxed);
+    Snapshot.m_PeakBytes         = m_PeakBytes.load(std::memory_order_relaxed);
+
+    for (size_t Bucket = 0; Bucket < s_BucketCount; ++Bucket)
+    {
+        Snapshot.m_Histogram[Bucket] = m_Histogram[Bucket].load(std::memory_order_relaxed);
+    }
+
+    return Snapshot;
+}
+
+inline void
+CAllocationStats::Reset()
+{
+    m_AllocationCount.store(0, std::memory_order_relaxed);
+    m_DeallocationCount.store(0, std::memory_order_relaxed);
+    m_AllocatedBytes.store(0, std::memory_order_relaxed);
+    m_PeakBytes.store(m_LiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    for (size_t Bucket = 0; Bucket < s_BucketCount; ++Bucket)
+    {
+        m_Histogram[Bucket].store(0, std::memory_order_relaxed);
+    }
+}
+
+inline const char*
+CAllocationStats::GetName() const
+{
+    return m_pName;
+}
+
+inline size_t
+CAllocationStats::GetBucket(size_t _Size)
+{
+    size_t Bucket = 0;
+
+    while (_Size > 1 && Bucket < s_BucketCount - 1)
+    {
+        _Size >>= 1;
+        ++Bucket;
+    }
+
+    return Bucket;
+}
+
+inline CAllocationStats&
+CAllocationStats::GetDefault()
+{
+    // intentionally leaked, so containers with static storage duration
+    // can still report their deallocations during program termination
+    static CAllocationStats* s_pStats = new CAllocationStats("default");
+    return *s_pStats;
+}
+
+inline void
+CAllocationStats::SSnapshot::Print(FILE* _pFile) const
+{
+    fprintf(_pFile, "%s: allocations %lu, deallocations %lu, allocated %lu, live %lu, peak %lu\n",
+            m_pName,
+            static_cast<unsigned long>(m_AllocationCount),
+            static_cast<unsigned long>(m_DeallocationCount),
+            static_cast<unsigned long>(m_AllocatedBytes),
+            static_cast<unsigned long>(m_LiveBytes),
+            static_cast<unsigned long>(m_PeakBytes));
+
+    for (size_t Bucket = 0; Bucket < s_BucketCount; ++Bucket)
+    {
+        if (m_Histogram[Bucket] != 0)
+        {
+            fprintf(_pFile, "    >= %lu bytes: %lu\n",
+                    static_cast<unsigned long>(static_cast<size_t>(1) << Bucket),
+                    static_cast<unsigned long>(m_Histogram[Bucket]));
+        }
+    }
+}
+
+/*************************************************************************
+ * STATS ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T, template <typename> class TInner>
+CStatsAllocator<T, TInner>::CStatsAllocator()
+    : m_pStats(&CAllocationStats::GetDefault())
+{
+}
+
+template <typename T, template <typename> class TInner>
+CStatsAllocator<T, TInner>::CStatsAllocator(CAllocationStats& _rStats, const inner_type& _rInner)
+    : m_pStats(&_rStats)
+    , m_Inner(_rInner)
+{
+}
+
+template <typename T, template <typename> class TInner>
+CStatsAllocator<T, TInner>::CStatsAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+    , m_pStats(&_rAllocator.GetStats())
+    , m_Inner(_rAllocator.GetInner())
+{
+}
+
+template <typename T, template <typename> class TInner>
+template <typename U>
+CStatsAllocator<T, TInner>::CStatsAllocator(const CStatsAllocator<U, TInner>& _rAllocator)
+    : m_pStats(&_rAllocator.GetStats())
+    , m_Inner(_rAllocator.GetInner())
+{
+}
+
+template <typename T, template <typename> class TInner>
+typename CStatsAllocator<T, TInner>::self&
+CStatsAllocator<T, TInner>::operator=(const self& _rAllocator)
+{
+    m_pStats = &_rAllocator.GetStats();
+    m_Inner  = _rAllocator.GetInner();
+    return (*this);
+}
+
+template <typename T, template <typename> class TInner>
+template <typename U>
+typename CStatsAllocator<T, TInner>::self&
+CStatsAllocator<T, TInner>::operator=(const CStatsAllocator<U, TInner>& _rAllocator)
+{
+    m_pStats = &_rAllocator.GetStats();
+    m_Inner  = _rAllocator.GetInner();
+    return (*this);
+}
+
+template <typename T, template <typename> class TInner>
+typename CStatsAllocator<T, TInner>::pointer
+CStatsAllocator<T, TInner>::Allocate(size_type _Count)
+{
+    pointer pMem = m_Inner.Allocate(_Count);
+
+    if (pMem != 0)
+    {
+        m_pStats->OnAllocate(_Count * sizeof(T));
+    }
+
+    return pMem;
+}
+
+template <typename T, template <typename> class TInner>
+void
+CStatsAllocator<T, TInner>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem != 0)
+    {
+        m_pStats->OnDeallocate(_Count * sizeof(T));
+    }
+
+    m_Inner.Deallocate(_pMem, _Count);
+}
+
+template <typename T, template <typename> class TInner>
+bool
+CStatsAllocator<T, TInner>::TryExpand(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    if (!SAllocatorTraits<inner_type>::TryExpand(m_Inner, _pMem, _Count, _NewCount))
+    {
+        return false;
+    }
+
+    m_pStats->OnDeallocate(_Count * sizeof(T));
+    m_pStats->OnAllocate(_NewCount * sizeof(T));
+    return true;
+}
+
+template <typename T, template <typename> class TInner>
+typename CStatsAllocator<T, TInner>::pointer
+CStatsAllocator<T, TInner>::Reallocate(pointer _pMem, size_type _Count, size_type _NewCount)
+{
+    pointer pNewMem = SAllocatorTraits<inner_type>::Reallocate(m_Inner, _pMem, _Count, _NewCount);
+
+    if (_pMem != 0)
+    {
+        m_pStats->OnDeallocate(_Count * sizeof(T));
+    }
+    if (pNewMem != 0)
+    {
+        m_pStats->OnAllocate(_NewCount * sizeof(T));
+    }
+
+    return pNewMem;
+}
+
+template <typename T, template <typename> class TInner>
+CAllocationStats&
+CStatsAllocator<T, TInner>::GetStats() const
+{
+    return *m_pStats;
+}
+
+template <typename T, template <typename> class TInner>
+const typename CStatsAllocator<T, TInner>::inner_type&
+CStatsAllocator<T, TInner>::GetInner() const
+{
+    return m_Inner;
+}
+
+template <typename T1, typename T2, template <typename> class TInner>
+bool
+operator==(const CStatsAllocator<T1, TInner>& _rLhs, const CStatsAllocator<T2, TInner>& _rRhs)
+{
+    return &_rLhs.GetStats() == &_rRhs.GetStats() && _rLhs.GetInner() == _rRhs.GetInner();
+}
+
+template <typename T1, typename T2, template <typename> class TInner>
+bool
+operator!=(const CStatsAllocator<T1, TInner>& _rLhs, const CStatsAllocator<T2, TInner>& _rRhs)
+{
+    return !(_rLhs == _rRhs);
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_STATS_ALLOCATOR_H_
@@ -0,0 +1,582 @@
+#ifndef __INCLUDE_THREAD_CACHE_ALLOCATOR_H_
+#define __INCLUDE_THREAD_CACHE_ALLOCATOR_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <new>
+#include <mutex>
+#include "allocator.h"
+
+namespace BASE {
+    namespace MEM {
+
+
+/**
+ * Process wide store of free blocks, sorted by size class.
+ * Blocks travel between the depot and the thread caches in batches, so the
+ * depot locks are taken once per batch instead of once per block. Memory
+ * is carved from big chunks, which are kept until the process ends.
+ **/
+class CThreadCacheDepot
+{
+public: // static constants
+
+    static const size_t s_Granularity = 16;                             // size classes are multiples of this
+    static const size_t s_MaxSize     = 1024;                           // bigger requests bypass the caches
+    static const size_t s_ClassCount  = s_MaxSize / s_Granularity;
+    static const size_t s_BatchBytes  = 8 * 1024;                       // bytes moved per batch
+    static const size_t s_ChunkSize   = 256 * 1024;                     // bytes carved from the heap at once
+
+public: // block declaration
+
+    struct SBlock
+    {
+        SBlock* m_pNext;
+    };
+
+public: // operations
+
+    SBlock* Fetch(size_t _Class, size_t& _rCount);                      // hands out a chain of _rCount blocks
+    void    Release(size_t _Class, SBlock* _pFirst, size_t _Count);     // takes back a chain of blocks
+
+    static size_t GetClass(size_t _Size);
+    static size_t GetClassSize(size_t _Class);
+    static size_t GetBatchCount(size_t _Class);                         // blocks per batch of a size class
+
+    static CThreadCacheDepot& GetInstance();                            // never destroyed
+
+private: // ctor, non-copyable
+
+    CThreadCacheDepot();
+    CThreadCacheDepot(const CThreadCacheDepot&);
+    CThreadCacheDepot& operator=(const CThreadCacheDepot&);
+
+private: // batch declaration
+
+    struct SBatch                                                       // overlays the first block of a full batch
+    {
+        SBlock* m_pNext;
+        SBatch* m_pNextBatch;
+    };
+
+    struct SSizeClass
+    {
+        std::mutex m_Mutex;
+        SBatch*    m_pFullBatches;                                      // chains of exactly GetBatchCount() blocks
+        SBlock*    m_pLoose;                                            // single blocks from partial releases
+        size_t     m_LooseCount;
+    };
+
+private: // internal methods
+
+    SBlock* Carve(size_t _Class, size_t _Count);
+
+private: // member
+
+    SSizeClass m_Classes[s_ClassCount];
+    std::mutex m_ChunkMutex;
+    char*      m_pCursor;
+    char*      m_pChunkEnd;
+};
+
+/**
+ * Per thread front end of the CThreadCacheDepot.
+ * Every size class keeps a free list, which is filled and drained batch
+ * wise. A block may be freed by any thread: it simply enters the cache of
+ * the freeing thread. The cache is given back to the depot on thread exit;
+ * destructors of other thread locals running later go straight to the depot.
+ * Whether the cache is still alive is kept in trivially destructible thread
+ * local state, the cache object itself is never touched after its lifetime.
+ **/
+class CThreadCache
+{
+public: // dtor
+
+    ~CThreadCache();
+
+public: // operations, on the cache of the calling thread
+
+    static void* Allocate(size_t _Size);
+    static void  Deallocate(void* _pMem, size_t _Size);
+
+private: // ctor, non-copyable
+
+    CThreadCache();
+    CThreadCache(const CThreadCache&);
+    CThreadCache& operator=(const CThreadCache&);
+
+private: // free list declaration
+
+    typedef CThreadCacheDepot::SBlock block_type;
+
+    struct SFreeList
+    {
+        block_type* m_pFirst;
+        size_t      m_Count;
+    };
+
+    struct SState                                                       // trivially destructible, valid until the thread is gone
+    {
+        CThreadCache* m_pCache;                                         // 0 before first use and after thread exit
+        bool          m_Exited;
+    };
+
+private: // internal methods
+
+    void* AllocateCached(size_t _Class);
+    void  DeallocateCached(block_type* _pBlock, size_t _Class);
+
+    static CThreadCache* GetInstance();                                 // 0 once the thread exits
+    static SState&       GetState();
+
+private: // member
+
+    SFreeList m_Lists[CThreadCacheDepot::s_ClassCount];
+};
+
+/**
+ * Allocator backed by the calling thread's CThreadCache.
+ * Stateless, every instance is equal, so memory can be freed by any
+ * instance on any thread. Requests bigger than CThreadCacheDepot::s_MaxSize
+ * go to the global heap.
+ **/
+template <typename T>
+class CThreadCacheAllocator : public CAllocator<T>
+{
+public:
+
+    typedef CAllocator<T> base_type;
+
+    typedef typename base_type::value_type      value_type;
+    typedef typename base_type::pointer         pointer;
+    typedef typename base_type::const_pointer   const_pointer;
+    typedef typename base_type::reference       reference;
+    typedef typename base_type::const_reference const_reference;
+    typedef typename base_type::size_type       size_type;
+
+    typedef CThreadCacheAllocator<T> self;
+
+public:
+
+    template <typename U>
+    struct SRebind
+    {
+        typedef CThreadCacheAllocator<U> other;
+    };
+
+public:
+
+    CThreadCacheAllocator();
+    CThreadCacheAllocator(const self&);
+    self& operator=(const self&);
+
+    template <typename U>
+    CThreadCacheAllocator(const CThreadCacheAllocator<U>&);
+
+    template <typename U>
+    self& operator=(const CThreadCacheAllocator<U>&);
+
+public:
+
+    pointer Allocate(size_type _Count);
+    void    Deallocate(pointer _pMem, size_type _Count);
+
+private:
+
+    static bool IsCached(size_t _Size);
+};
+
+/*************************************************************************
+ * DEPOT SUBSECTION
+ *************************************************************************/
+
+inline
+CThreadCacheDepot::CThreadCacheDepot()
+    : m_pCursor(0)
+    , m_pChunkEnd(0)
+{
+    for (size_t Class = 0; Class < s_ClassCount; ++Class)
+    {
+        m_Classes[Class].m_pFullBatches = 0;
+        m_Classes[Class].m_pLoose       = 0;
+        m_Classes[Class].m_LooseCount   = 0;
+    }
+}
+
+inline CThreadCacheDepot::SBlock*
+CThreadCacheDepot::Fetch(size_t _Class, size_t& _rCount)
+{
+    SSizeClass& rClass = m_Classes[_Class];
+    size_t BatchCount = GetBatchCount(_Class);
+
+    {
+        std::lock_guard<std::mutex> Lock(rClass.m_Mutex);
+
+        if (rClass.m_pFullBatches != 0)
+        {
+            SBatch* pBatch = rClass.m_pFullBatches;
+            rClass.m_pFullBatches = pBatch->m_pNextBatch;
+
+            _rCount = BatchCount;
+            return reinterpret_cast<SBlock*>(pBatch);
+        }
+
+        if (rClass.m_pLoose != 0)
+        {
+            SBlock* pFirst = rClass.m_pLoose;
+            SBlock* pLast  = pFirst;
+            size_t  Count  = 1;
+
+            for (; Count < BatchCount && pLast->m_pNext != 0; ++Count)
+            {
+                pLast = pLast->m_pNext;
+            }
+
+            rClass.m_pLoose = pLast->m_pNext;
+            rClass.m_LooseCount -= Count;
+            pLast->m_pNext = 0;
+
+            _rCount = Count;
+            return pFirst;
+        }
+    }
+
+    _rCount = BatchCount;
+    return Carve(_Class, BatchCount);
+}
+
+inline void
+CThreadCacheDepot::Release(size_t _Class, SBlock* _pFirst, size_t _Count)
+{
+    SSizeClass& rClass = m_Classes[_Class];
+    std::lock_guard<std::mutex> Lock(rClass.m_Mutex);
+
+    if (_Count == GetBatchCount(_Class))
+    {
+        SBatch* pBatch = reinterpret_cast<SBatch*>(_pFirst);
+        pBatch->m_pNextBatch = rClass.m_pFullBatches;
+        rClass.m_pFullBatches = pBatch;
+        return;
+    }
+
+    SBlock* pLast = _pFirst;
+    while (pLast->m_pNext != 0)
+    {
+        pLast = pLast->m_pNext;
+    }
+
+    pLast->m_pNext = rClass.m_pLoose;
+    rClass.m_pLoose = _pFirst;
+    rClass.m_LooseCount += _Count;
+}
+
+inline size_t
+CThreadCacheDepot::GetClass(size_t _Size)
+{
+    assert(_Size > 0 && _Size <= s_MaxSize && "size not served by thread caches");
+    return (_Size - 1) / s_Granularity;
+}
+
+inline size_t
+CThreadCacheDepot::GetClassSize(size_t _Class)
+{
+    return (_Class + 1) * s_Granularity;
+}
+
+inline size_t
+CThreadCacheDepot::GetBatchCount(size_t _Class)
+{
+    size_t Count = s_BatchBytes / GetClassSize(_Class);
+    return Count < 8 ? 8 : (Count > 128 ? 128 : Count);
+}
+
+inline CThreadCacheDepot&
+CThreadCacheDepot::GetInstance()
+{
+    // intentionally leaked, thread caches flush into it during termination
+    static CThreadCacheDepot* s_pDepot = new CThreadCacheDepot();
+    return *s_pDepot;
+}
+
+inline CThreadCacheDepot::SBlock*
+CThreadCacheDepot::Carve(size_t _Class, size_t _Count)
+{
+    size_t BlockSize = GetClassSize(_Class);
+    size_t Bytes     = BlockSize * _Count;
+    char*  pMem      = 0;
+
+    {
+        std::lock_guard<std::mutex> Lock(m_ChunkMutex);
+
+        if (static_cast<size_t>(m_pChunkEnd - m_pCursor) < Bytes)
+        { // rest of the chunk is too small, it stays unused
+            m_pCursor   = static_cast<char*>(::operator new(s_ChunkSize));
+            m_pChunkEnd = m_pCursor + s_ChunkSize;
+        }
+
+        pMem = m_pCursor;
+        m_pCursor += Bytes;
+    }
+
+    // link the blocks outside of the lock
+    for (size_t Block = 0; Block + 1 < _Count; ++Block)
+    {
+        reinterpret_cast<SBlock*>(pMem + Block * BlockSize)->m_pNext = reinterpret_cast<SBlock*>(pMem + (Block + 1) * BlockSize);
+    }
+    reinterpret_cast<SBlock*>(pMem + (_Count - 1) * BlockSize)->m_pNext = 0;
+
+    return reinterpret_cast<SBlock*>(pMem);
+}
+
+/*************************************************************************
+ * THREAD CACHE SUBSECTION
+ *************************************************************************/
+
+inline
+CThreadCache::CThreadCache()
+{
+    for (size_t Class = 0; Class < CThreadCacheDepot::s_ClassCount; ++Class)
+    {
+        m_Lists[Class].m_pFirst = 0;
+        m_Lists[Class].m_Count  = 0;
+    }
+
+    GetState().m_pCache = this;
+}
+
+inline
+CThreadCache::~CThreadCache()
+{
+    CThreadCacheDepot& rDepot = CThreadCacheDepot::GetInstance();
+
+    for (size_t Class = 0; Class < CThreadCacheDepot::s_ClassCount; ++Class)
+    {
+        if (m_Lists[Class].m_pFirst != 0)
+        {
+            rDepot.Release(Class, m_Lists[Class].m_pFirst, m_Lists[Class].m_Count);
+        }
+
+        m_Lists[Class].m_pFirst = 0;
+        m_Lists[Class].m_Count  = 0;
+    }
+
+    GetState().m_pCache = 0;
+    GetState().m_Exited = true;
+}
+
+inline void*
+CThreadCache::Allocate(size_t _Size)
+{
+    size_t Class = CThreadCacheDepot::GetClass(_Size);
+    CThreadCache* pCache = GetInstance();
+
+    if (pCache != 0)
+    {
+        return pCache->AllocateCached(Class);
+    }
+
+    // nothing is cached anymore, keep one block of a fresh batch
+    size_t Count = 0;
+    block_type* pBlock = CThreadCacheDepot::GetInstance().Fetch(Class, Count);
+
+    if (Count > 1)
+    {
+        CThreadCacheDepot::GetInstance().Release(Class, pBlock->m_pNext, Count - 1);
+    }
+
+    return pBlock;
+}
+
+inline void*
+CThreadCache::AllocateCached(size_t _Class)
+{
+    SFreeList& rList = m_Lists[_Class];
+
+    if (rList.m_pFirst == 0)
+    {
+        rList.m_pFirst = CThreadCacheDepot::GetInstance().Fetch(_Class, rList.m_Count);
+    }
+
+    block_type* pBlock = rList.m_pFirst;
+    rList.m_pFirst = pBlock->m_pNext;
+    --rList.m_Count;
+
+    return pBlock;
+}
+
+inline void
+CThreadCache::Deallocate(void* _pMem, size_t _Size)
+{
+    size_t Class = CThreadCacheDepot::GetClass(_Size);
+    CThreadCache* pCache = GetInstance();
+
+    block_type* pBlock = static_cast<block_type*>(_pMem);
+
+    if (pCache != 0)
+    {
+        pCache->DeallocateCached(pBlock, Class);
+        return;
+    }
+
+    pBlock->m_pNext = 0;
+    CThreadCacheDepot::GetInstance().Release(Class, pBlock, 1);
+}
+
+inline void
+CThreadCache::DeallocateCached(block_type* _pBlock, size_t _Class)
+{
+    SFreeList& rList = m_Lists[_Class];
+    size_t BatchCount = CThreadCacheDepot::GetBatchCount(_Class);
+
+    block_type* pBlock = _pBlock;
+
+    pBlock->m_pNext = rList.m_pFirst;
+    rList.m_pFirst = pBlock;
+    ++rList.m_Count;
+
+    if (rList.m_Count >= 2 * BatchCount)
+    { // keep one batch for upcoming allocations, hand the other one back
+        block_type* pFirst = rList.m_pFirst;
+        block_type* pLast  = pFirst;
+        for (size_t Block = 1; Block < BatchCount; ++Block)
+        {
+            pLast = pLast->m_pNext;
+        }
+
+        rList.m_pFirst = pLast->m_pNext;
+        rList.m_Count -= BatchCount;
+        pLast->m_pNext = 0;
+
+        CThreadCacheDepot::GetInstance().Release(_Class, pFirst, BatchCount);
+    }
+}
+
+inline CThreadCache*
+CThreadCache::GetInstance()
+{
+    SState& rState = GetState();
+
+    if (rState.m_pCache == 0 && !rState.m_Exited)
+    { // first use, the constructor registers the cache in the state
+        static thread_local CThreadCache s_Cache;
+        (void)s_Cache;
+    }
+    return rState.m_pCache;
+}
+
+inline CThreadCache::SState&
+CThreadCache::GetState()
+{
+    static thread_local SState s_State = { 0, false };
+    return s_State;
+}
+
+/*************************************************************************
+ * THREAD CACHE ALLOCATOR SUBSECTION
+ *************************************************************************/
+
+template <typename T>
+CThreadCacheAllocator<T>::CThreadCacheAllocator()
+{
+}
+
+template <typename T>
+CThreadCacheAllocator<T>::CThreadCacheAllocator(const self& _rAllocator)
+    : base_type(_rAllocator)
+{
+}
+
+template <typename T>
+template <typename U>
+CThreadCacheAllocator<T>::CThreadCacheAllocator(const CThreadCacheAllocator<U>&)
+{
+}
+
+template <typename T>
+typename CThreadCacheAllocator<T>::self&
+CThreadCacheAllocator<T>::operator=(const self&)
+{
+    return (*this);
+}
+
+template <typename T>
+template <typename U>
+typename CThreadCacheAllocator<T>::self&
+CThreadCacheAllocator<T>::operator=(const CThreadCacheAllocator<U>&)
+{
+    return (*this);
+}
+
+template <typename T>
+typename CThreadCacheAllocator<T>::pointer
+CThreadCacheAllocator<T>::Allocate(size_type _Count)
+{
+    if (_Count == 0 || _Count > this->GetMaxSize())
+    {
+        return 0;
+    }
+
+    size_t Size = _Count * sizeof(T);
+    void*  pMem = IsCached(Size) ? CThreadCache::Allocate(Size) : ::operator new(Size);
+
+    return static_cast<T*>(pMem);
+}
+
+template <typename T>
+void
+CThreadCacheAllocator<T>::Deallocate(pointer _pMem, size_type _Count)
+{
+    if (_pMem == 0)
+    {
+        return;
+    }
+
+    size_t Size = _Count * sizeof(T);
+
+    if (IsCached(Size))
+    {
+        CThreadCache::Deallocate(_pMem, Size);
+    }
+    else
+    {
+        ::operator delete(_pMem);
+    }
+}
+
+template <typename T>
+bool
+CThreadCacheAllocator<T>::IsCached(size_t _Size)
+{
+    return _Size <= CThreadCacheDepot::s_MaxSize && alignof(T) <= CThreadCacheDepot::s_Granularity;
+}
+
+template <typename T1, typename T2>
+bool
+operator==(const CThreadCacheAllocator<T1>&, const CThreadCacheAllocator<T2>&)
+{
+    return true;
+}
+
+template <typename T1, typename T2>
+bool
+operator!=(const CThreadCacheAllocator<T1>&, const CThreadCacheAllocator<T2>&)
+{
+    return false;
+}
+
+
+    } // namespace MEM
+} // namespace BASE
+
+
+#endif // __INCLUDE_THREAD_CACHE_ALLOCATOR_H_
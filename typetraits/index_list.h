@@ -0,0 +1,50 @@
+#ifndef __INCLUDE_INDEX_LIST_H_
+#define __INCLUDE_INDEX_LIST_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+
+namespace BASE {
+    namespace TYPET {
+
+
+/**
+ * Compile time list of indices, used to expand a parameter pack together
+ * with the position of each element:
+ *     template <size_t... Indices>
+ *     void Print(const std::tuple<T...>& _rTuple, SIndexList<Indices...>);
+ *     Print(Tuple, typename SMakeIndexList<sizeof...(T)>::type());
+ **/
+template <size_t... Indices>
+struct SIndexList
+{
+};
+
+template <size_t Count, size_t... Indices>
+struct SMakeIndexList : public SMakeIndexList<Count - 1, Count - 1, Indices...>
+{
+};
+
+template <size_t... Indices>
+struct SMakeIndexList<0, Indices...>
+{
+    typedef SIndexList<Indices...> type;
+};
+
+
+    }
+}
+
+
+
+
+#endif // __INCLUDE_INDEX_LIST_H_
@@ -0,0 +1,44 @@
+#ifndef __INCLUDE_IS_TRIVIALLY_COPYABLE_H_
+#define __INCLUDE_IS_TRIVIALLY_COPYABLE_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <type_traits>
+
+namespace BASE {
+    namespace TYPET {
+
+
+/**
+ * True if copying a T is the same as copying its bytes, so containers may
+ * use memcpy and memmove instead of the copy constructor and assignment.
+ * Defaults to what the compiler knows. Specialize it for types the compiler
+ * cannot prove trivial, e.g. a struct with a user provided but bitwise
+ * copy constructor:
+ *     template <> struct SIsTriviallyCopyable<SPoint> { enum { Result = true }; };
+ **/
+template <class T>
+struct SIsTriviallyCopyable
+{
+    enum
+    {
+        Result = std::is_trivially_copyable<T>::value
+    };
+};
+
+
+    }
+}
+
+
+
+
+#endif // __INCLUDE_IS_TRIVIALLY_COPYABLE_H_
@@ -0,0 +1,46 @@
+#ifndef __INCLUDE_IS_TRIVIALLY_RELOCATABLE_H_
+#define __INCLUDE_IS_TRIVIALLY_RELOCATABLE_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include "is_trivially_copyable.h"
+
+namespace BASE {
+    namespace TYPET {
+
+
+/**
+ * True if moving a T to a new address and destroying the original is the
+ * same as copying its bytes and forgetting the original. Containers then
+ * move such elements with memcpy and memmove and skip the destructor of the
+ * old location. Every trivially copyable type qualifies, many others do as
+ * well (owning pointers, most strings and containers) as long as they hold
+ * no pointer into themselves. Those have to opt in:
+ *     template <> struct SIsTriviallyRelocatable<CHandle> { enum { Result = true }; };
+ * The move constructor of an opted in type should not throw.
+ **/
+template <class T>
+struct SIsTriviallyRelocatable
+{
+    enum
+    {
+        Result = SIsTriviallyCopyable<T>::Result
+    };
+};
+
+
+    }
+}
+
+
+
+
+#endif // __INCLUDE_IS_TRIVIALLY_RELOCATABLE_H_
@@ -0,0 +1,128 @@
+#ifndef __INCLUDE_BITS_H_
+#define __INCLUDE_BITS_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+namespace BASE {
+    namespace UTIL {
+
+
+/**
+ * Position of the highest set bit at compile time, SLog2<16>::Result == 4.
+ **/
+template <size_t Value>
+struct SLog2
+{
+    enum
+    {
+        Result = 1 + SLog2<Value / 2>::Result
+    };
+};
+
+template <>
+struct SLog2<1>
+{
+    enum
+    {
+        Result = 0
+    };
+};
+
+/**
+ * Position of the highest set bit, _Value must not be 0.
+ * A single instruction (bsr, lzcnt, clz) where the compiler offers it.
+ **/
+inline size_t
+GetHighestBit(size_t _Value)
+{
+    assert(_Value != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(_Value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long Bit;
+    _BitScanReverse64(&Bit, _Value);
+    return Bit;
+#elif defined(_MSC_VER)
+    unsigned long Bit;
+    _BitScanReverse(&Bit, _Value);
+    return Bit;
+#else
+    size_t Bit = 0;
+    while (_Value >>= 1)
+    {
+        ++Bit;
+    }
+    return Bit;
+#endif
+}
+
+
+/**
+ * Position of the lowest set bit, _Value must not be 0.
+ **/
+inline size_t
+GetLowestBit(size_t _Value)
+{
+    assert(_Value != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(_Value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long Bit;
+    _BitScanForward64(&Bit, _Value);
+    return Bit;
+#elif defined(_MSC_VER)
+    unsigned long Bit;
+    _BitScanForward(&Bit, _Value);
+    return Bit;
+#else
+    size_t Bit = 0;
+    while ((_Value & 1) == 0)
+    {
+        _Value >>= 1;
+        ++Bit;
+    }
+    return Bit;
+#endif
+}
+
+
+/**
+ * Number of set bits. The compiler builtin becomes popcnt where the target
+ * has it, otherwise (and with MSVC, whose intrinsic needs the instruction)
+ * the bits are summed up in parallel inside the word.
+ **/
+inline size_t
+GetPopCount(uint64_t _Value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(_Value);
+#else
+    _Value = _Value - ((_Value >> 1) & 0x5555555555555555ULL);
+    _Value = (_Value & 0x3333333333333333ULL) + ((_Value >> 2) & 0x3333333333333333ULL);
+    _Value = (_Value + (_Value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((_Value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+
+    } // namespace UTIL
+} // namespace BASE
+
+#endif // __INCLUDE_BITS_H_
@@ -0,0 +1,247 @@
+#ifndef __INCLUDE_THREAD_POOL_H_
+#define __INCLUDE_THREAD_POOL_H_
+
+/************************************************************************************
+ * This work is licensed under the                                                  *
+ *      Creative Commons Attribution-NonCommercial-ShareAlike 3.0 Unported License. *
+ * To view a copy of this license, visit                                            *
+ *      http://creativecommons.org/licenses/by-nc-sa/3.0/                           *
+ *                                                                                  *
+ * @author  David Wieland                                                           *
+ * @email   david.dw.wieland@googlemail.com                                         *
+ ************************************************************************************/
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "../../container/sequential/dlist.h"
+#include "../../container/sequential/vector.h"
+
+namespace BASE {
+    namespace UTIL {
+
+
+/**
+ * Fixed set of worker threads serving a FIFO of tasks.
+ * Run hands out the indices of a batch of tasks to the workers and to the
+ * calling thread, and returns when all of them finished. As the caller
+ * keeps working on the batch itself, Run may be used from inside a task
+ * and a pool without workers simply runs everything on the caller.
+ * Tasks must not throw.
+ **/
+class CThreadPool
+{
+public: // ctor, dtor
+
+    explicit CThreadPool(size_t _ThreadCount = GetDefaultThreadCount());
+    ~CThreadPool();                                                     // finishes queued tasks, joins the workers
+
+public: // operations
+
+    void Submit(std::function<void()> _Task);                           // runs _Task on a worker, no completion signal
+    void Run(size_t _TaskCount, const std::function<void(size_t)>& _rTask); // runs _rTask(0) .. _rTask(_TaskCount - 1), blocks
+
+public: // properties
+
+    size_t GetThreadCount() const;                                      // workers, the caller of Run not counted
+
+    static size_t       GetDefaultThreadCount();                        // one less than the hardware threads
+    static CThreadPool& GetDefault();                                   // shared pool, never destroyed
+
+private: // non-copyable
+
+    CThreadPool(const CThreadPool&);
+    CThreadPool& operator=(const CThreadPool&);
+
+private: // batch state, shared with the workers helping on it
+
+    struct SBatch
+    {
+        const std::function<void(size_t)>* m_pTask;
+        size_t                             m_TaskCount;
+        std::atomic<size_t>                m_NextTask;
+        std::atomic<size_t>                m_FinishedCount;
+        std::mutex                         m_Mutex;
+        std::condition_variable            m_Finished;
+
+        void Work();                                                    // runs tasks until none are left
+    };
+
+private: // internal operations
+
+    void WorkerLoop();
+
+private: // member
+
+    BASE::CNT::CVector<std::thread>                      m_Threads;
+    BASE::CNT::CDoubleLinkedList<std::function<void()> > m_Queue;
+    std::mutex                                           m_Mutex;
+    std::condition_variable                              m_QueueChanged;
+    bool                                                 m_IsStopping;
+};
+
+/*************************************************************************
+ * BATCH SUBSECTION
+ *************************************************************************/
+
+inline void
+CThreadPool::SBatch::Work()
+{
+    size_t Finished = 0;
+
+    for (size_t Task = m_NextTask.fetch_add(1); Task < m_TaskCount; Task = m_NextTask.fetch_add(1))
+    {
+        (*m_pTask)(Task);
+        ++Finished;
+    }
+
+    if (Finished > 0 && m_FinishedCount.fetch_add(Finished) + Finished == m_TaskCount)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_Finished.notify_all();
+    }
+}
+
+/*************************************************************************
+ * THREAD POOL SUBSECTION
+ *************************************************************************/
+
+inline
+CThreadPool::CThreadPool(size_t _ThreadCount)
+    : m_Threads(_ThreadCount)
+    , m_IsStopping(false)
+{
+    for (size_t Thread = 0; Thread < _ThreadCount; ++Thread)
+    {
+        m_Threads.EmplaceBack(&CThreadPool::WorkerLoop, this);
+    }
+}
+
+inline
+CThreadPool::~CThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_IsStopping = true;
+    }
+    m_QueueChanged.notify_all();
+
+    for (size_t Thread = 0; Thread < m_Threads.GetCount(); ++Thread)
+    {
+        m_Threads[Thread].join();
+    }
+}
+
+inline void
+CThreadPool::Submit(std::function<void()> _Task)
+{
+    if (m_Threads.GetCount() == 0)
+    {
+        _Task();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_Queue.PushBack(_Task);
+    }
+    m_QueueChanged.notify_one();
+}
+
+inline void
+CThreadPool::Run(size_t _TaskCount, const std::function<void(size_t)>& _rTask)
+{
+    if (_TaskCount == 0)
+    {
+        return;
+    }
+
+    // workers may pick up their share after Run returned, so they keep the batch alive
+    std::shared_ptr<SBatch> pBatch = std::make_shared<SBatch>();
+    pBatch->m_pTask     = &_rTask;
+    pBatch->m_TaskCount = _TaskCount;
+    pBatch->m_NextTask.store(0);
+    pBatch->m_FinishedCount.store(0);
+
+    size_t HelperCount = (_TaskCount - 1 < m_Threads.GetCount()) ? _TaskCount - 1 : m_Threads.GetCount();
+
+    if (HelperCount > 0)
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            for (size_t Helper = 0; Helper < HelperCount; ++Helper)
+            {
+                m_Queue.PushBack([pBatch]() { pBatch->Work(); });
+            }
+        }
+        m_QueueChanged.notify_all();
+    }
+
+    pBatch->Work();
+
+    std::unique_lock<std::mutex> Lock(pBatch->m_Mutex);
+    while (pBatch->m_FinishedCount.load() != _TaskCount)
+    {
+        pBatch->m_Finished.wait(Lock);
+    }
+}
+
+inline size_t
+CThreadPool::GetThreadCount() const
+{
+    return m_Threads.GetCount();
+}
+
+inline size_t
+CThreadPool::GetDefaultThreadCount()
+{
+    size_t HardwareThreads = std::thread::hardware_concurrency();
+
+    return (HardwareThreads > 1) ? HardwareThreads - 1 : 0;
+}
+
+inline CThreadPool&
+CThreadPool::GetDefault()
+{
+    // leaked on purpose, workers must not be joined during static destruction
+    static CThreadPool* s_pPool = new CThreadPool();
+    return *s_pPool;
+}
+
+inline void
+CThreadPool::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> Task;
+
+        {
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+            while (m_Queue.Begin() == m_Queue.End() && !m_IsStopping)
+            {
+                m_QueueChanged.wait(Lock);
+            }
+
+            if (m_Queue.Begin() == m_Queue.End())
+            {
+                return;
+            }
+
+            Task = *m_Queue.Begin();
+            m_Queue.PopFront();
+        }
+
+        Task();
+    }
+}
+
+
+    } // namespace UTIL
+} // namespace BASE
+
+#endif // __INCLUDE_THREAD_POOL_H_